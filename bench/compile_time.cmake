@@ -0,0 +1,67 @@
+# Generate a translation unit of mocks and report its compile time and object size
+# Variables:
+#   CXX: compiler
+#   CXX_STANDARD: c++ standard
+#   INCLUDE_DIRS: include directories (list)
+#   OUTPUT_DIR: directory of generated files
+#   HEADER: header of backend (blet/mockf.h or blet/mockf/stub.h)
+#   COUNT: number of mocks (default 200)
+
+if(NOT COUNT)
+    set(COUNT 200)
+endif()
+
+# libc-like argument and return types
+set(argument_types "int" "const char*" "void*" "size_t" "long" "const void*" "unsigned int" "char*" "off_t" "int*")
+set(return_types "int" "ssize_t" "void*" "long" "char*")
+
+string(MAKE_C_IDENTIFIER "${HEADER}" header_name)
+set(source_file "${OUTPUT_DIR}/compile_time_${header_name}.cpp")
+set(object_file "${OUTPUT_DIR}/compile_time_${header_name}.o")
+
+set(declarations "")
+set(mocks "")
+math(EXPR last "${COUNT} - 1")
+foreach(i RANGE ${last})
+    math(EXPR nb_argument "${i} % 11")
+    math(EXPR return_index "${i} % 5")
+    list(GET return_types ${return_index} return_type)
+    set(arguments "")
+    if(nb_argument GREATER 0)
+        math(EXPR last_argument "${nb_argument} - 1")
+        foreach(j RANGE ${last_argument})
+            math(EXPR type_index "(${i} + ${j}) % 10")
+            list(GET argument_types ${type_index} argument_type)
+            list(APPEND arguments "${argument_type}")
+        endforeach()
+    endif()
+    string(REPLACE ";" ", " arguments "${arguments}")
+    string(APPEND declarations "${return_type} mockf_compile_${i}(${arguments});\n")
+    string(APPEND mocks "MOCKF_FUNCTION${nb_argument}(${return_type}, mockf_compile_${i}, (${arguments}));\n")
+endforeach()
+
+file(WRITE "${source_file}"
+    "#include <sys/types.h>\n\n"
+    "#include \"${HEADER}\"\n\n"
+    "extern \"C\" {\n${declarations}}\n\n"
+    "${mocks}"
+)
+
+set(include_flags "")
+foreach(dir ${INCLUDE_DIRS})
+    list(APPEND include_flags "-I${dir}")
+endforeach()
+
+string(TIMESTAMP start "%s%f")
+execute_process(
+    COMMAND "${CXX}" "-std=c++${CXX_STANDARD}" -O2 ${include_flags} -c "${source_file}" -o "${object_file}"
+    RESULT_VARIABLE result
+)
+string(TIMESTAMP end "%s%f")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "compile of ${source_file} failed")
+endif()
+
+math(EXPR elapsed_ms "(${end} - ${start}) / 1000")
+file(SIZE "${object_file}" object_size)
+message(STATUS "${HEADER}: ${COUNT} mocks compiled in ${elapsed_ms} ms, object of ${object_size} bytes")
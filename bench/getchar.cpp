@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <stdio.h> // getchar
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION0(int, getchar, ());
+
+static MOCKF_CLASS(getchar)* mockf_getchar = NULL;
+
+// read stdin from '/dev/zero' for never block the real getchar
+static void redirectStdin() {
+    static FILE* file = freopen("/dev/zero", "r", stdin);
+    (void)file;
+}
+
+// create the mock with 'nbExpectation' expectations where only the first one match
+// getchar has no argument: the others expectations are retired but always scanned
+static void setUp(const benchmark::State& state, bool isEnable, int nbExpectation) {
+    redirectStdin();
+    if (state.thread_index() == 0) {
+        ::testing::GMOCK_FLAG(verbose) = "error";
+        mockf_getchar = new MOCKF_CLASS(getchar)();
+        if (nbExpectation == 0) {
+            ON_CALL(*mockf_getchar, getchar()).WillByDefault(Return(0));
+        }
+        else {
+            EXPECT_CALL(*mockf_getchar, getchar()).WillRepeatedly(Return(0));
+        }
+        for (int i = 1; i < nbExpectation; ++i) {
+            EXPECT_CALL(*mockf_getchar, getchar()).WillOnce(Return(0)).RetiresOnSaturation();
+            mockf_getchar->getchar();
+        }
+        mockf_getchar->isEnable = isEnable;
+    }
+}
+
+static void tearDown(const benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        delete mockf_getchar;
+        mockf_getchar = NULL;
+    }
+}
+
+static void getchar_real(benchmark::State& state) {
+    redirectStdin();
+    MOCKF_CLASS(getchar)::function_t real = MOCKF_CLASS(getchar)::real();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(real());
+    }
+}
+BENCHMARK(getchar_real)->ThreadRange(1, 16)->UseRealTime();
+
+static void getchar_disabled(benchmark::State& state) {
+    setUp(state, false, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getchar());
+    }
+    tearDown(state);
+}
+BENCHMARK(getchar_disabled)->ThreadRange(1, 16)->UseRealTime();
+
+static void getchar_enabled(benchmark::State& state) {
+    setUp(state, true, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getchar());
+    }
+    tearDown(state);
+}
+BENCHMARK(getchar_enabled)->ArgName("expectations")->Arg(0)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(getchar_enabled)->ArgName("expectations")->Arg(1)->ThreadRange(2, 16)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>  // open
+#include <unistd.h> // read
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+
+static char buffer[64] = {0};
+static MOCKF_CLASS(read)* mockf_read = NULL;
+
+static int devZero() {
+    static int fd = open("/dev/zero", O_RDONLY);
+    return fd;
+}
+
+// create the mock with 'nbExpectation' expectations where only the first one match
+static void setUp(const benchmark::State& state, bool isEnable, int nbExpectation) {
+    if (state.thread_index() == 0) {
+        ::testing::GMOCK_FLAG(verbose) = "error";
+        mockf_read = new MOCKF_CLASS(read)();
+        if (nbExpectation == 0) {
+            ON_CALL(*mockf_read, read(_, _, _)).WillByDefault(Return(sizeof(buffer)));
+        }
+        else {
+            EXPECT_CALL(*mockf_read, read(devZero(), _, _)).WillRepeatedly(Return(sizeof(buffer)));
+        }
+        for (int i = 1; i < nbExpectation; ++i) {
+            EXPECT_CALL(*mockf_read, read(-1 - i, _, _)).Times(AnyNumber());
+        }
+        mockf_read->isEnable = isEnable;
+    }
+}
+
+static void tearDown(const benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        delete mockf_read;
+        mockf_read = NULL;
+    }
+}
+
+static void read_real(benchmark::State& state) {
+    MOCKF_CLASS(read)::function_t real = MOCKF_CLASS(read)::real();
+    int fd = devZero();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(real(fd, buffer, sizeof(buffer)));
+    }
+}
+BENCHMARK(read_real)->ThreadRange(1, 16)->UseRealTime();
+
+static void read_disabled(benchmark::State& state) {
+    setUp(state, false, 0);
+    int fd = devZero();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(fd, buffer, sizeof(buffer)));
+    }
+    tearDown(state);
+}
+BENCHMARK(read_disabled)->ThreadRange(1, 16)->UseRealTime();
+
+static void read_enabled(benchmark::State& state) {
+    setUp(state, true, static_cast<int>(state.range(0)));
+    int fd = devZero();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(fd, buffer, sizeof(buffer)));
+    }
+    tearDown(state);
+}
+BENCHMARK(read_enabled)->ArgName("expectations")->Arg(0)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(read_enabled)->ArgName("expectations")->Arg(1)->ThreadRange(2, 16)->UseRealTime();
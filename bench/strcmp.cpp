@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <string.h> // strcmp
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+
+MOCKF_ATTRIBUTE_FUNCTION2(int, strcmp, (const char* /* s1 */, const char* /* s2 */), throw());
+
+static const char str1[] = "benchmark of strcmp mock";
+static const char str2[] = "benchmark of strcmp mock";
+static MOCKF_CLASS(strcmp)* mockf_strcmp = NULL;
+
+// create the mock with 'nbExpectation' expectations where only the first one match
+static void setUp(const benchmark::State& state, bool isEnable, int nbExpectation) {
+    if (state.thread_index() == 0) {
+        ::testing::GMOCK_FLAG(verbose) = "error";
+        mockf_strcmp = new MOCKF_CLASS(strcmp)();
+        if (nbExpectation == 0) {
+            ON_CALL(*mockf_strcmp, strcmp(_, _)).WillByDefault(Return(0));
+        }
+        else {
+            EXPECT_CALL(*mockf_strcmp, strcmp(str1, _)).WillRepeatedly(Return(0));
+        }
+        for (int i = 1; i < nbExpectation; ++i) {
+            EXPECT_CALL(*mockf_strcmp, strcmp(str1 + i % sizeof(str1) + 1, _)).Times(AnyNumber());
+        }
+        mockf_strcmp->isEnable = isEnable;
+    }
+}
+
+static void tearDown(const benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        delete mockf_strcmp;
+        mockf_strcmp = NULL;
+    }
+}
+
+static void strcmp_real(benchmark::State& state) {
+    MOCKF_CLASS(strcmp)::function_t real = MOCKF_CLASS(strcmp)::real();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(real(str1, str2));
+    }
+}
+BENCHMARK(strcmp_real)->ThreadRange(1, 16)->UseRealTime();
+
+static void strcmp_disabled(benchmark::State& state) {
+    setUp(state, false, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(strcmp(str1, str2));
+    }
+    tearDown(state);
+}
+BENCHMARK(strcmp_disabled)->ThreadRange(1, 16)->UseRealTime();
+
+static void strcmp_enabled(benchmark::State& state) {
+    setUp(state, true, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(strcmp(str1, str2));
+    }
+    tearDown(state);
+}
+BENCHMARK(strcmp_enabled)->ArgName("expectations")->Arg(0)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(strcmp_enabled)->ArgName("expectations")->Arg(1)->ThreadRange(2, 16)->UseRealTime();
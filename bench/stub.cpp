@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <unistd.h> // write
+
+#include "blet/mockf/stub.h"
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+static const char buffer[64] = {0};
+static MOCKF_CLASS(write)* mockf_write = NULL;
+
+static ssize_t writeStub(int /* fd */, const void* /* buf */, size_t nbytes) {
+    return static_cast<ssize_t>(nbytes);
+}
+
+static void setUp(const benchmark::State& state, bool isEnable) {
+    if (state.thread_index() == 0) {
+        mockf_write = new MOCKF_CLASS(write)();
+        mockf_write->stub.set(&writeStub);
+        mockf_write->isEnable = isEnable;
+    }
+}
+
+static void tearDown(const benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        delete mockf_write;
+        mockf_write = NULL;
+    }
+}
+
+static void stub_write_handler(benchmark::State& state) {
+    MOCKF_SET_HANDLER(write, &writeStub);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(-1, buffer, sizeof(buffer)));
+    }
+    MOCKF_RESET_HANDLER(write);
+}
+BENCHMARK(stub_write_handler)->ThreadRange(1, 16)->UseRealTime();
+
+static void stub_write_enabled(benchmark::State& state) {
+    setUp(state, true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(-1, buffer, sizeof(buffer)));
+    }
+    tearDown(state);
+}
+BENCHMARK(stub_write_enabled)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>  // open
+#include <unistd.h> // write
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+static const char buffer[64] = {0};
+static MOCKF_CLASS(write)* mockf_write = NULL;
+
+static int devNull() {
+    static int fd = open("/dev/null", O_WRONLY);
+    return fd;
+}
+
+// create the mock with 'nbExpectation' expectations where only the first one match
+static void setUp(const benchmark::State& state, bool isEnable, int nbExpectation) {
+    if (state.thread_index() == 0) {
+        ::testing::GMOCK_FLAG(verbose) = "error";
+        mockf_write = new MOCKF_CLASS(write)();
+        if (nbExpectation == 0) {
+            ON_CALL(*mockf_write, write(_, _, _)).WillByDefault(Return(sizeof(buffer)));
+        }
+        else {
+            EXPECT_CALL(*mockf_write, write(devNull(), _, _)).WillRepeatedly(Return(sizeof(buffer)));
+        }
+        for (int i = 1; i < nbExpectation; ++i) {
+            EXPECT_CALL(*mockf_write, write(-1 - i, _, _)).Times(AnyNumber());
+        }
+        mockf_write->isEnable = isEnable;
+    }
+}
+
+static void tearDown(const benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        delete mockf_write;
+        mockf_write = NULL;
+    }
+}
+
+static void write_real(benchmark::State& state) {
+    MOCKF_CLASS(write)::function_t real = MOCKF_CLASS(write)::real();
+    int fd = devNull();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(real(fd, buffer, sizeof(buffer)));
+    }
+}
+BENCHMARK(write_real)->ThreadRange(1, 16)->UseRealTime();
+
+static void write_disabled(benchmark::State& state) {
+    setUp(state, false, 0);
+    int fd = devNull();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(fd, buffer, sizeof(buffer)));
+    }
+    tearDown(state);
+}
+BENCHMARK(write_disabled)->ThreadRange(1, 16)->UseRealTime();
+
+static void write_enabled(benchmark::State& state) {
+    setUp(state, true, static_cast<int>(state.range(0)));
+    int fd = devNull();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(fd, buffer, sizeof(buffer)));
+    }
+    tearDown(state);
+}
+BENCHMARK(write_enabled)->ArgName("expectations")->Arg(0)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(write_enabled)->ArgName("expectations")->Arg(1)->ThreadRange(2, 16)->UseRealTime();
@@ -0,0 +1,33 @@
+# Functions of blet_mockf for the targets that use mocks
+
+# functions with a fortified builtin (__<name>_chk) in gcc
+set(MOCKF_FORTIFIED_BUILTINS
+    memcpy memmove mempcpy memset stpcpy stpncpy strcpy strncpy strcat strncat
+    printf fprintf vprintf vfprintf sprintf vsprintf snprintf vsnprintf
+)
+
+# mockf_no_builtin(<target> <function>...)
+# Keep the call of the mocked functions in the optimized builds of target:
+# add -fno-builtin-<function> and -fno-builtin-__<function>_chk for the fortified builtins.
+function(mockf_no_builtin target)
+    set(options "")
+    foreach(function ${ARGN})
+        list(APPEND options "-fno-builtin-${function}")
+        list(FIND MOCKF_FORTIFIED_BUILTINS "${function}" index)
+        if(NOT index EQUAL -1)
+            list(APPEND options "-fno-builtin-__${function}_chk")
+        endif()
+    endforeach()
+    target_compile_options("${target}" PRIVATE ${options})
+endfunction()
+
+# mockf_wrap(<target> <function>...)
+# Intercept the mocked functions at link time (-Wl,--wrap=<function>) without dlsym (e.g. static binary):
+# define MOCKF_ENABLE_WRAP in the sources of target, the fakes are __wrap_<function> and call __real_<function>.
+# All mocked functions of target must be wrapped.
+function(mockf_wrap target)
+    target_compile_definitions("${target}" PRIVATE MOCKF_ENABLE_WRAP)
+    foreach(function ${ARGN})
+        set_property(TARGET "${target}" APPEND_STRING PROPERTY LINK_FLAGS " -Wl,--wrap=${function}")
+    endforeach()
+endfunction()
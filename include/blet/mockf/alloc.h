@@ -0,0 +1,362 @@
+/**
+ * mockf/alloc.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_ALLOC_H_
+#define BLET_MOCKF_ALLOC_H_
+
+#include <dlfcn.h>  // dlsym
+#include <malloc.h> // malloc_usable_size
+#include <stdint.h> // uint64_t, int64_t, uintptr_t
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // memcpy
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Define the allocation functions counted by thread (malloc, calloc, realloc, free, posix_memalign,
+ * aligned_alloc, memalign), operator new and delete of libstdc++ use them
+ * Must be used in only one source file of a binary, at global scope
+ */
+#define MOCKF_ALLOC_FUNCTIONS()                                                           \
+    extern "C" void* malloc(size_t size) throw() {                                        \
+        return ::blet::mockf::Alloc::malloc(size);                                        \
+    }                                                                                     \
+    extern "C" void* calloc(size_t nmemb, size_t size) throw() {                          \
+        return ::blet::mockf::Alloc::calloc(nmemb, size);                                 \
+    }                                                                                     \
+    extern "C" void* realloc(void* ptr, size_t size) throw() {                            \
+        return ::blet::mockf::Alloc::realloc(ptr, size);                                  \
+    }                                                                                     \
+    extern "C" void free(void* ptr) throw() {                                             \
+        ::blet::mockf::Alloc::free(ptr);                                                  \
+    }                                                                                     \
+    extern "C" int posix_memalign(void** memptr, size_t alignment, size_t size) throw() { \
+        return ::blet::mockf::Alloc::posixMemalign(memptr, alignment, size);              \
+    }                                                                                     \
+    extern "C" void* aligned_alloc(size_t alignment, size_t size) throw() {               \
+        return ::blet::mockf::Alloc::memalign(alignment, size);                           \
+    }                                                                                     \
+    extern "C" void* memalign(size_t alignment, size_t size) throw() {                    \
+        return ::blet::mockf::Alloc::memalign(alignment, size);                           \
+    }                                                                                     \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Fail the test if the current thread allocates in the following block
+ * The allocation functions must be defined by MOCKF_ALLOC_FUNCTIONS.
+ */
+#define MOCKF_ASSERT_NO_ALLOC \
+    for (::blet::mockf::AllocCheck mockf_alloc_check(__FILE__, __LINE__); mockf_alloc_check.next();)
+
+/**
+ * @brief Size of the static arena of the allocations during the resolution of real functions
+ */
+#ifndef MOCKF_ALLOC_BOOTSTRAP_SIZE
+#define MOCKF_ALLOC_BOOTSTRAP_SIZE 65536
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Allocations of a thread (sizes are the usable sizes of blocks)
+ */
+struct AllocStats {
+    uint64_t allocations;   // number of allocations
+    uint64_t deallocations; // number of deallocations
+    uint64_t bytes;         // sum of allocated bytes
+    int64_t liveBytes;      // allocated bytes not freed (negative if the thread frees blocks of other threads)
+    int64_t peakBytes;      // maximum of liveBytes
+};
+
+/**
+ * @brief Allocation functions counted by thread
+ * The real functions are resolved at the first allocation, the allocations during the resolution (dlsym) are
+ * served by a static arena never freed.
+ */
+class Alloc {
+  public:
+    static void* malloc(size_t size) {
+        const Real* real = resolve();
+        if (real == NULL || real->malloc == NULL) {
+            return bootstrap(size, sizeof(Header));
+        }
+        void* ptr = real->malloc(size);
+        allocated(ptr);
+        return ptr;
+    }
+
+    static void* calloc(size_t nmemb, size_t size) {
+        const Real* real = resolve();
+        if (real == NULL || real->calloc == NULL) {
+            if (size != 0 && nmemb > static_cast<size_t>(-1) / size) {
+                return NULL;
+            }
+            // the arena is never reused: already filled by 0
+            return bootstrap(nmemb * size, sizeof(Header));
+        }
+        void* ptr = real->calloc(nmemb, size);
+        allocated(ptr);
+        return ptr;
+    }
+
+    static void* realloc(void* ptr, size_t size) {
+        const Real* real = resolve();
+        if (ptr == NULL) {
+            return malloc(size);
+        }
+        if (isBootstrap(ptr)) {
+            // move out of the arena
+            void* ret = malloc(size);
+            if (ret != NULL) {
+                size_t oldSize = reinterpret_cast<Header*>(ptr)[-1].size;
+                memcpy(ret, ptr, oldSize < size ? oldSize : size);
+            }
+            return ret;
+        }
+        if (real == NULL || real->realloc == NULL) {
+            return NULL;
+        }
+        size_t oldSize = malloc_usable_size(ptr);
+        void* ret = real->realloc(ptr, size);
+        if (ret != NULL || size == 0) {
+            deallocated(oldSize);
+            allocated(ret);
+        }
+        return ret;
+    }
+
+    static void free(void* ptr) {
+        if (ptr == NULL || isBootstrap(ptr)) {
+            return;
+        }
+        const Real* real = resolve();
+        if (real != NULL && real->free != NULL) {
+            deallocated(malloc_usable_size(ptr));
+            real->free(ptr);
+        }
+    }
+
+    static int posixMemalign(void** memptr, size_t alignment, size_t size) {
+        const Real* real = resolve();
+        if (real == NULL || real->posixMemalign == NULL) {
+            *memptr = bootstrap(size, alignment);
+            return *memptr == NULL ? ENOMEM : 0;
+        }
+        int ret = real->posixMemalign(memptr, alignment, size);
+        if (ret == 0) {
+            allocated(*memptr);
+        }
+        return ret;
+    }
+
+    static void* memalign(size_t alignment, size_t size) {
+        void* ptr = NULL;
+        int error = posixMemalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size);
+        if (error != 0) {
+            errno = error;
+            return NULL;
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief Allocations of the current thread
+     */
+    static AllocStats& thread() {
+        // initial-exec: no allocation at the first access
+        static __thread AllocStats stats __attribute__((tls_model("initial-exec"))) = {0, 0, 0, 0, 0};
+        return stats;
+    }
+
+    /**
+     * @brief Reset the counters of the current thread
+     */
+    static void resetThread() {
+        AllocStats& stats = thread();
+        stats.allocations = 0;
+        stats.deallocations = 0;
+        stats.bytes = 0;
+        stats.liveBytes = 0;
+        stats.peakBytes = 0;
+    }
+
+    /**
+     * @brief Bytes used in the bootstrap arena
+     */
+    static size_t bootstrapSize() {
+        return __atomic_load_n(&arenaSize(), __ATOMIC_RELAXED);
+    }
+
+  private:
+    typedef void* (*malloc_t)(size_t);
+    typedef void* (*calloc_t)(size_t, size_t);
+    typedef void* (*realloc_t)(void*, size_t);
+    typedef void (*free_t)(void*);
+    typedef int (*posix_memalign_t)(void**, size_t, size_t);
+
+    struct Real {
+        malloc_t malloc;
+        calloc_t calloc;
+        realloc_t realloc;
+        free_t free;
+        posix_memalign_t posixMemalign;
+    };
+
+    // size of block in the arena, before the block
+    struct Header {
+        size_t size;
+        size_t padding;
+    };
+
+    enum State {
+        UNRESOLVED = 0,
+        RESOLVING,
+        RESOLVED
+    };
+
+    /**
+     * @brief Real functions published once resolved (NULL during the resolution: use the arena)
+     * Only the first thread resolves, the allocations of dlsym and of the other threads use the arena.
+     */
+    static const Real* resolve() {
+        static Real resolved; // written before the publication only
+        static const Real* published = NULL;
+        static int state = UNRESOLVED;
+        const Real* real = __atomic_load_n(&published, __ATOMIC_ACQUIRE);
+        if (real != NULL) {
+            return real;
+        }
+        int expected = UNRESOLVED;
+        if (!__atomic_compare_exchange_n(&state, &expected, RESOLVING, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return NULL;
+        }
+        Real local;
+        local.malloc = reinterpret_cast<malloc_t>(dlsym(RTLD_NEXT, "malloc"));
+        local.calloc = reinterpret_cast<calloc_t>(dlsym(RTLD_NEXT, "calloc"));
+        local.realloc = reinterpret_cast<realloc_t>(dlsym(RTLD_NEXT, "realloc"));
+        local.free = reinterpret_cast<free_t>(dlsym(RTLD_NEXT, "free"));
+        local.posixMemalign = reinterpret_cast<posix_memalign_t>(dlsym(RTLD_NEXT, "posix_memalign"));
+        resolved = local;
+        __atomic_store_n(&published, static_cast<const Real*>(&resolved), __ATOMIC_RELEASE);
+        __atomic_store_n(&state, static_cast<int>(RESOLVED), __ATOMIC_RELEASE);
+        return &resolved;
+    }
+
+    static char* arena() {
+        static char buffer[MOCKF_ALLOC_BOOTSTRAP_SIZE] __attribute__((aligned(64)));
+        return buffer;
+    }
+
+    static size_t& arenaSize() {
+        static size_t size = 0;
+        return size;
+    }
+
+    static bool isBootstrap(const void* ptr) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        uintptr_t begin = reinterpret_cast<uintptr_t>(arena());
+        return address >= begin && address < begin + MOCKF_ALLOC_BOOTSTRAP_SIZE;
+    }
+
+    static void* bootstrap(size_t size, size_t alignment) {
+        if (alignment < sizeof(Header)) {
+            alignment = sizeof(Header);
+        }
+        size_t offset = __atomic_load_n(&arenaSize(), __ATOMIC_RELAXED);
+        size_t begin = 0;
+        do {
+            begin = (offset + sizeof(Header) + alignment - 1) / alignment * alignment;
+            if (begin + size > MOCKF_ALLOC_BOOTSTRAP_SIZE || begin + size < begin) {
+                return NULL;
+            }
+        } while (!__atomic_compare_exchange_n(&arenaSize(), &offset, begin + size, true, __ATOMIC_RELAXED,
+                                              __ATOMIC_RELAXED));
+        reinterpret_cast<Header*>(arena() + begin)[-1].size = size;
+        return arena() + begin;
+    }
+
+    static void allocated(void* ptr) {
+        if (ptr != NULL) {
+            AllocStats& stats = thread();
+            size_t size = malloc_usable_size(ptr);
+            ++stats.allocations;
+            stats.bytes += size;
+            stats.liveBytes += static_cast<int64_t>(size);
+            if (stats.liveBytes > stats.peakBytes) {
+                stats.peakBytes = stats.liveBytes;
+            }
+        }
+    }
+
+    static void deallocated(size_t size) {
+        AllocStats& stats = thread();
+        ++stats.deallocations;
+        stats.liveBytes -= static_cast<int64_t>(size);
+    }
+};
+
+/**
+ * @brief Check of MOCKF_ASSERT_NO_ALLOC: add a failure at the end of the block if the thread allocates
+ */
+class AllocCheck {
+  public:
+    AllocCheck(const char* file, int line) :
+        file_(file),
+        line_(line),
+        isFirst_(true),
+        start_(Alloc::thread()) {}
+
+    ~AllocCheck() {
+        AllocStats stats = Alloc::thread();
+        uint64_t allocations = stats.allocations - start_.allocations;
+        if (allocations != 0) {
+            ADD_FAILURE_AT(file_, line_) << "MockF MOCKF_ASSERT_NO_ALLOC: " << allocations << " allocation(s) of "
+                                         << stats.bytes - start_.bytes << " byte(s) in the block";
+        }
+    }
+
+    bool next() {
+        bool isFirst = isFirst_;
+        isFirst_ = false;
+        return isFirst;
+    }
+
+  private:
+    AllocCheck(const AllocCheck&);            // disable copy
+    AllocCheck& operator=(const AllocCheck&); // disable copy
+
+    const char* file_;
+    int line_;
+    bool isFirst_;
+    AllocStats start_;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_ALLOC_H_
@@ -0,0 +1,343 @@
+/**
+ * mockf/budget.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_BUDGET_H_
+#define BLET_MOCKF_BUDGET_H_
+
+#include <pthread.h> // pthread_mutex_t
+#include <stdint.h>  // int64_t, uint64_t
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "blet/mockf.h"
+
+#ifndef MOCKF_DISABLE_VARIADIC_MACROS
+
+/**
+ * @brief Check the calls of a function (enabled or not) in the scope, the test fails at the end of scope if a
+ * limit is not respected
+ * The limits compare a field (calls, mocked, passthrough, bytes, maxSize, minSize) to a value.
+ * e.g. MOCKF_BUDGET(write, calls <= 4, bytes >= 1 << 20);
+ * @param name Name of function
+ */
+#define MOCKF_BUDGET(name, ...) \
+    MOCKF_INTERNAL_BUDGET_BEGIN_(name), __VA_ARGS__ MOCKF_INTERNAL_BUDGET_END_(name, #__VA_ARGS__)
+
+#endif
+
+#define MOCKF_BUDGET1(name, l1) MOCKF_INTERNAL_BUDGET_BEGIN_(name), l1 MOCKF_INTERNAL_BUDGET_END_(name, #l1)
+#define MOCKF_BUDGET2(name, l1, l2) \
+    MOCKF_INTERNAL_BUDGET_BEGIN_(name), l1, l2 MOCKF_INTERNAL_BUDGET_END_(name, #l1 ", " #l2)
+#define MOCKF_BUDGET3(name, l1, l2, l3) \
+    MOCKF_INTERNAL_BUDGET_BEGIN_(name), l1, l2, l3 MOCKF_INTERNAL_BUDGET_END_(name, #l1 ", " #l2 ", " #l3)
+#define MOCKF_BUDGET4(name, l1, l2, l3, l4)            \
+    MOCKF_INTERNAL_BUDGET_BEGIN_(name), l1, l2, l3, l4 \
+    MOCKF_INTERNAL_BUDGET_END_(name, #l1 ", " #l2 ", " #l3 ", " #l4)
+
+/**
+ * @brief Maximum number of calls in the report of a budget
+ */
+#ifndef MOCKF_BUDGET_REPORT_MAX
+#define MOCKF_BUDGET_REPORT_MAX 64
+#endif
+
+// the names of fields are the members of BudgetFields in the local class
+#define MOCKF_INTERNAL_BUDGET_BEGIN_(name)                                    \
+    struct MockFBudget_##name : public ::blet::mockf::BudgetFields {          \
+        void limits(::blet::mockf::BudgetLimits& mockf_budget_limits) const { \
+            mockf_budget_limits
+
+#define MOCKF_INTERNAL_BUDGET_END_(name, text)                                             \
+    ;                                                                                      \
+    }                                                                                      \
+    }                                                                                      \
+    mockf_budget_fields_##name;                                                            \
+    ::blet::mockf::Budget<MOCKF_CLASS(name)> mockf_budget_##name(__FILE__, __LINE__, text, \
+                                                                 mockf_budget_fields_##name)
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Limit of a field of budget (e.g. calls <= 4)
+ */
+struct BudgetLimit {
+    enum Field {
+        CALLS,
+        MOCKED,
+        PASSTHROUGH,
+        BYTES,
+        MAX_SIZE,
+        MIN_SIZE
+    };
+    enum Operator {
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        EQUAL,
+        NOT_EQUAL
+    };
+    Field field;
+    Operator op;
+    uint64_t value;
+
+    bool check(uint64_t measure) const {
+        switch (op) {
+            case LESS:
+                return measure < value;
+            case LESS_EQUAL:
+                return measure <= value;
+            case GREATER:
+                return measure > value;
+            case GREATER_EQUAL:
+                return measure >= value;
+            case EQUAL:
+                return measure == value;
+            case NOT_EQUAL:
+                return measure != value;
+        }
+        return false;
+    }
+
+    static const char* name(Field field) {
+        static const char* names[] = {"calls", "mocked", "passthrough", "bytes", "maxSize", "minSize"};
+        return names[field];
+    }
+
+    static const char* name(Operator op) {
+        static const char* names[] = {"<", "<=", ">", ">=", "==", "!="};
+        return names[op];
+    }
+};
+
+/**
+ * @brief Field of budget usable in a limit
+ */
+struct BudgetField {
+    explicit BudgetField(BudgetLimit::Field field) :
+        field(field) {}
+
+    template<typename V>
+    BudgetLimit operator<(V value) const {
+        return make(BudgetLimit::LESS, value);
+    }
+    template<typename V>
+    BudgetLimit operator<=(V value) const {
+        return make(BudgetLimit::LESS_EQUAL, value);
+    }
+    template<typename V>
+    BudgetLimit operator>(V value) const {
+        return make(BudgetLimit::GREATER, value);
+    }
+    template<typename V>
+    BudgetLimit operator>=(V value) const {
+        return make(BudgetLimit::GREATER_EQUAL, value);
+    }
+    template<typename V>
+    BudgetLimit operator==(V value) const {
+        return make(BudgetLimit::EQUAL, value);
+    }
+    template<typename V>
+    BudgetLimit operator!=(V value) const {
+        return make(BudgetLimit::NOT_EQUAL, value);
+    }
+
+    BudgetLimit::Field field;
+
+  private:
+    template<typename V>
+    BudgetLimit make(BudgetLimit::Operator op, V value) const {
+        BudgetLimit limit = {field, op, static_cast<uint64_t>(value)};
+        return limit;
+    }
+};
+
+/**
+ * @brief Limits of a budget, filled by the comma operator
+ */
+struct BudgetLimits {
+    std::vector<BudgetLimit> limits;
+};
+
+inline BudgetLimits& operator,(BudgetLimits& limits, const BudgetLimit& limit) {
+    limits.limits.push_back(limit);
+    return limits;
+}
+
+/**
+ * @brief Names of fields in the limits of MOCKF_BUDGET
+ */
+class BudgetFields {
+  public:
+    BudgetFields() :
+        calls(BudgetLimit::CALLS),
+        mocked(BudgetLimit::MOCKED),
+        passthrough(BudgetLimit::PASSTHROUGH),
+        bytes(BudgetLimit::BYTES),
+        maxSize(BudgetLimit::MAX_SIZE),
+        minSize(BudgetLimit::MIN_SIZE) {}
+    virtual ~BudgetFields() {}
+    virtual void limits(BudgetLimits& limits) const = 0;
+
+  protected:
+    BudgetField calls;       // number of calls
+    BudgetField mocked;      // number of calls of mock
+    BudgetField passthrough; // number of calls of real function (or handler)
+    BudgetField bytes;       // sum of the first size_t argument
+    BudgetField maxSize;     // maximum of the first size_t argument
+    BudgetField minSize;     // minimum of the first size_t argument
+};
+
+/**
+ * @brief Counter of the calls of a mock in a scope, checked at its destruction
+ * @tparam T Mock class
+ */
+template<typename T>
+class Budget : public BudgetCounter {
+  public:
+    struct Call {
+        int64_t size;
+        bool isMocked;
+    };
+
+    Budget(const char* file, int line, const char* text, const BudgetFields& fields) :
+        file_(file),
+        line_(line),
+        text_(text),
+        previous_(T::budget()),
+        calls_(0),
+        mocked_(0),
+        bytes_(0),
+        maxSize_(0),
+        minSize_(0) {
+        pthread_mutex_init(&mutex_, NULL);
+        fields.limits(limits_);
+        T::setBudget(this);
+    }
+
+    virtual ~Budget() {
+        T::setBudget(previous_);
+        check();
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    virtual void add(int64_t size, bool isMocked) {
+        pthread_mutex_lock(&mutex_);
+        ++calls_;
+        if (isMocked) {
+            ++mocked_;
+        }
+        if (size >= 0) {
+            uint64_t value = static_cast<uint64_t>(size);
+            bytes_ += value;
+            maxSize_ = (value > maxSize_) ? value : maxSize_;
+            minSize_ = (calls_ == 1 || value < minSize_) ? value : minSize_;
+        }
+        if (report_.size() < MOCKF_BUDGET_REPORT_MAX) {
+            Call call = {size, isMocked};
+            report_.push_back(call);
+        }
+        pthread_mutex_unlock(&mutex_);
+        if (previous_ != NULL) {
+            previous_->add(size, isMocked);
+        }
+    }
+
+    uint64_t measure(BudgetLimit::Field field) const {
+        switch (field) {
+            case BudgetLimit::CALLS:
+                return calls_;
+            case BudgetLimit::MOCKED:
+                return mocked_;
+            case BudgetLimit::PASSTHROUGH:
+                return calls_ - mocked_;
+            case BudgetLimit::BYTES:
+                return bytes_;
+            case BudgetLimit::MAX_SIZE:
+                return maxSize_;
+            case BudgetLimit::MIN_SIZE:
+                return minSize_;
+        }
+        return 0;
+    }
+
+  private:
+    Budget(const Budget&);            // disable copy
+    Budget& operator=(const Budget&); // disable copy
+
+    void check() const {
+        std::ostringstream failures;
+        for (std::size_t i = 0; i < limits_.limits.size(); ++i) {
+            const BudgetLimit& limit = limits_.limits[i];
+            uint64_t value = measure(limit.field);
+            if (!limit.check(value)) {
+                failures << "\n  " << BudgetLimit::name(limit.field) << " " << BudgetLimit::name(limit.op) << " "
+                         << limit.value << " (" << BudgetLimit::name(limit.field) << ": " << value << ")";
+            }
+        }
+        if (!failures.str().empty()) {
+            std::ostringstream oss;
+            oss << "MockF '" << T::functionName() << "' budget (" << text_ << ") exceeded:" << failures.str()
+                << "\n  calls: " << calls_ << " (mocked: " << mocked_ << "), bytes: " << bytes_;
+            for (std::size_t i = 0; i < report_.size(); ++i) {
+                oss << "\n  call " << i + 1 << ": ";
+                if (report_[i].size >= 0) {
+                    oss << report_[i].size << " bytes";
+                }
+                else {
+                    oss << "-";
+                }
+                oss << (report_[i].isMocked ? " (mock)" : " (real)");
+            }
+            if (calls_ > report_.size()) {
+                oss << "\n  ... " << calls_ - report_.size() << " more call(s)";
+            }
+            ADD_FAILURE_AT(file_, line_) << oss.str();
+        }
+    }
+
+    const char* file_;
+    int line_;
+    const char* text_;
+    BudgetCounter* previous_;
+    BudgetLimits limits_;
+    pthread_mutex_t mutex_;
+    uint64_t calls_;
+    uint64_t mocked_;
+    uint64_t bytes_;
+    uint64_t maxSize_;
+    uint64_t minSize_;
+    std::vector<Call> report_;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_BUDGET_H_
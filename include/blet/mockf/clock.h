@@ -0,0 +1,338 @@
+/**
+ * mockf/clock.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_CLOCK_H_
+#define BLET_MOCKF_CLOCK_H_
+
+#include <errno.h>    // EINVAL
+#include <stdint.h>   // uint64_t
+#include <sys/time.h> // gettimeofday
+#include <time.h>     // time, clock_gettime, nanosleep, clock_nanosleep
+#include <unistd.h>   // sleep, usleep
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Declare the mocks of the time functions with the virtual clock as handler
+ * Must be used in only one source file of a binary
+ */
+#define MOCKF_CLOCK_FUNCTIONS()                                                                                 \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, clock_gettime, (clockid_t /* clock */, struct timespec* /* tp */), throw()); \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, gettimeofday, (struct timeval* /* tv */, void* /* tz */), throw());          \
+    MOCKF_ATTRIBUTE_FUNCTION1(time_t, time, (time_t* /* timer */), throw());                                    \
+    MOCKF_FUNCTION2(int, nanosleep, (const struct timespec* /* req */, struct timespec* /* rem */));            \
+    MOCKF_FUNCTION4(int, clock_nanosleep,                                                                       \
+                    (clockid_t /* clock */, int /* flags */, const struct timespec* /* req */,                  \
+                     struct timespec* /* rem */));                                                              \
+    MOCKF_FUNCTION1(int, usleep, (useconds_t /* useconds */));                                                  \
+    MOCKF_FUNCTION1(unsigned int, sleep, (unsigned int /* seconds */));                                         \
+    namespace blet {                                                                                            \
+    namespace mockf {                                                                                           \
+    static const ClockHandlers<MockF_clock_gettime, MockF_gettimeofday, MockF_time, MockF_nanosleep,            \
+                               MockF_clock_nanosleep, MockF_usleep, MockF_sleep>                                \
+        mockf_clock_handlers;                                                                                   \
+    }                                                                                                           \
+    }                                                                                                           \
+    struct MockFForceSemiColon
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Virtual time of the time functions: the sleeps advance the clock instantly
+ * The realtime clocks are the monotonic clocks with an offset, the cpu time clocks are not virtual.
+ */
+class VirtualClock {
+  public:
+    /**
+     * @brief Start at the current real time
+     * @throw blet::mockf::VirtualClock::VirtualClockAlreadyExists if another virtual clock exists
+     */
+    VirtualClock() :
+        monotonic_(Clock::now()),
+        realtimeOffset_(Clock::now(CLOCK_REALTIME) - monotonic_),
+        step_(0),
+        nbSleep_(0),
+        sleptNs_(0) {
+        VirtualClock* expected = NULL;
+        if (!__atomic_compare_exchange_n(&instance(), &expected, this, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            throw VirtualClockAlreadyExists(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), "clock");
+        }
+    }
+
+    ~VirtualClock() {
+        __atomic_store_n(&instance(), static_cast<VirtualClock*>(NULL), __ATOMIC_RELEASE);
+    }
+
+    static VirtualClock*& instance() {
+        static VirtualClock* singleton = NULL;
+        return singleton;
+    }
+
+    struct VirtualClockAlreadyExists : public Exception {
+        VirtualClockAlreadyExists(const char* file, const char* line, const char* name) throw() :
+            Exception(file, line, name) {
+            message_ += "virtual clock already exists.";
+        }
+    };
+
+    /**
+     * @brief Advance the time
+     */
+    void advance(uint64_t ns) {
+        __atomic_add_fetch(&monotonic_, ns, __ATOMIC_ACQ_REL);
+    }
+
+    /**
+     * @brief Advance the time after each read of clock (0: disabled)
+     */
+    void autoAdvance(uint64_t ns) {
+        __atomic_store_n(&step_, ns, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Set the realtime clock (the monotonic clock does not change)
+     */
+    void setRealtime(time_t seconds, long nanoseconds = 0) {
+        struct timespec ts;
+        ts.tv_sec = seconds;
+        ts.tv_nsec = nanoseconds;
+        __atomic_store_n(&realtimeOffset_, toNs(ts) - __atomic_load_n(&monotonic_, __ATOMIC_ACQUIRE),
+                         __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Read a clock (with auto-advance)
+     */
+    uint64_t now(clockid_t clock = CLOCK_MONOTONIC) {
+        uint64_t step = __atomic_load_n(&step_, __ATOMIC_ACQUIRE);
+        uint64_t monotonic = step == 0 ? __atomic_load_n(&monotonic_, __ATOMIC_ACQUIRE)
+                                       : __atomic_fetch_add(&monotonic_, step, __ATOMIC_ACQ_REL);
+        if (isRealtime(clock)) {
+            return monotonic + __atomic_load_n(&realtimeOffset_, __ATOMIC_ACQUIRE);
+        }
+        return monotonic;
+    }
+
+    /**
+     * @brief Sleep until a time of clock (advance the time if it is in the future)
+     * A deadline in the past (e.g. a realtime deadline before the offset) does not change the time.
+     */
+    void sleepUntil(clockid_t clock, uint64_t ns) {
+        uint64_t offset = isRealtime(clock) ? __atomic_load_n(&realtimeOffset_, __ATOMIC_ACQUIRE) : 0;
+        uint64_t current = __atomic_load_n(&monotonic_, __ATOMIC_ACQUIRE);
+        // the times are compared by their difference: the realtime offset can wrap
+        int64_t remaining = static_cast<int64_t>(ns - offset - current);
+        while (remaining > 0 && !__atomic_compare_exchange_n(&monotonic_, &current, ns - offset, true,
+                                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            remaining = static_cast<int64_t>(ns - offset - current);
+        }
+        __atomic_add_fetch(&nbSleep_, 1, __ATOMIC_RELAXED);
+        if (remaining > 0) {
+            __atomic_add_fetch(&sleptNs_, static_cast<uint64_t>(remaining), __ATOMIC_RELAXED);
+        }
+    }
+
+    /**
+     * @brief Sleep a duration (advance the time)
+     */
+    void sleep(uint64_t ns) {
+        advance(ns);
+        __atomic_add_fetch(&nbSleep_, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&sleptNs_, ns, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Number of calls of sleep functions
+     */
+    uint64_t nbSleep() const {
+        return __atomic_load_n(&nbSleep_, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Sum of the durations of sleeps
+     */
+    uint64_t sleptNs() const {
+        return __atomic_load_n(&sleptNs_, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief The clock is virtual (not a cpu time clock)
+     */
+    static bool isVirtual(clockid_t clock) {
+        return clock == CLOCK_MONOTONIC || clock == CLOCK_MONOTONIC_RAW || clock == CLOCK_MONOTONIC_COARSE ||
+               clock == CLOCK_BOOTTIME || isRealtime(clock);
+    }
+
+    static bool isRealtime(clockid_t clock) {
+        return clock == CLOCK_REALTIME || clock == CLOCK_REALTIME_COARSE || clock == CLOCK_TAI;
+    }
+
+    static uint64_t toNs(const struct timespec& ts) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    static void toTimespec(uint64_t ns, struct timespec* ts) {
+        ts->tv_sec = static_cast<time_t>(ns / 1000000000u);
+        ts->tv_nsec = static_cast<long>(ns % 1000000000u);
+    }
+
+  private:
+    VirtualClock(const VirtualClock&);            // disable copy
+    VirtualClock& operator=(const VirtualClock&); // disable copy
+
+    uint64_t monotonic_;
+    uint64_t realtimeOffset_;
+    uint64_t step_;
+    uint64_t nbSleep_;
+    uint64_t sleptNs_;
+};
+
+/**
+ * @brief Handlers of mocks: use the virtual clock or the real function
+ */
+template<typename T>
+int clockGettime(clockid_t clock, struct timespec* tp) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL && VirtualClock::isVirtual(clock)) {
+        if (tp == NULL) {
+            errno = EFAULT;
+            return -1;
+        }
+        VirtualClock::toTimespec(virtualClock->now(clock), tp);
+        return 0;
+    }
+    return T::real()(clock, tp);
+}
+
+template<typename T>
+int clockGettimeofday(struct timeval* tv, void* tz) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL) {
+        if (tv != NULL) {
+            uint64_t ns = virtualClock->now(CLOCK_REALTIME);
+            tv->tv_sec = static_cast<time_t>(ns / 1000000000u);
+            tv->tv_usec = static_cast<suseconds_t>(ns % 1000000000u / 1000u);
+        }
+        return 0;
+    }
+    return T::real()(tv, tz);
+}
+
+template<typename T>
+time_t clockTime(time_t* timer) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL) {
+        time_t ret = static_cast<time_t>(virtualClock->now(CLOCK_REALTIME) / 1000000000u);
+        if (timer != NULL) {
+            *timer = ret;
+        }
+        return ret;
+    }
+    return T::real()(timer);
+}
+
+template<typename T>
+int clockNanosleep(const struct timespec* req, struct timespec* rem) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL) {
+        if (req == NULL || req->tv_nsec < 0 || req->tv_nsec >= 1000000000 || req->tv_sec < 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        virtualClock->sleep(VirtualClock::toNs(*req));
+        if (rem != NULL) {
+            VirtualClock::toTimespec(0, rem);
+        }
+        return 0;
+    }
+    return T::real()(req, rem);
+}
+
+template<typename T>
+int clockClockNanosleep(clockid_t clock, int flags, const struct timespec* req, struct timespec* rem) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL && VirtualClock::isVirtual(clock)) {
+        // return an error number (not errno)
+        if (req == NULL || req->tv_nsec < 0 || req->tv_nsec >= 1000000000 || req->tv_sec < 0) {
+            return EINVAL;
+        }
+        if ((flags & TIMER_ABSTIME) != 0) {
+            virtualClock->sleepUntil(clock, VirtualClock::toNs(*req));
+        }
+        else {
+            virtualClock->sleep(VirtualClock::toNs(*req));
+            if (rem != NULL) {
+                VirtualClock::toTimespec(0, rem);
+            }
+        }
+        return 0;
+    }
+    return T::real()(clock, flags, req, rem);
+}
+
+template<typename T>
+int clockUsleep(useconds_t useconds) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL) {
+        virtualClock->sleep(static_cast<uint64_t>(useconds) * 1000u);
+        return 0;
+    }
+    return T::real()(useconds);
+}
+
+template<typename T>
+unsigned int clockSleep(unsigned int seconds) {
+    VirtualClock* virtualClock = __atomic_load_n(&VirtualClock::instance(), __ATOMIC_ACQUIRE);
+    if (virtualClock != NULL) {
+        virtualClock->sleep(static_cast<uint64_t>(seconds) * 1000000000u);
+        return 0;
+    }
+    return T::real()(seconds);
+}
+
+/**
+ * @brief Set the handlers of the virtual clock at load time
+ */
+template<typename ClockGettime, typename Gettimeofday, typename Time, typename Nanosleep, typename ClockNanosleep,
+         typename Usleep, typename Sleep>
+struct ClockHandlers {
+    ClockHandlers() {
+        ClockGettime::setHandler(&clockGettime<ClockGettime>);
+        Gettimeofday::setHandler(&clockGettimeofday<Gettimeofday>);
+        Time::setHandler(&clockTime<Time>);
+        Nanosleep::setHandler(&clockNanosleep<Nanosleep>);
+        ClockNanosleep::setHandler(&clockClockNanosleep<ClockNanosleep>);
+        Usleep::setHandler(&clockUsleep<Usleep>);
+        Sleep::setHandler(&clockSleep<Sleep>);
+    }
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_CLOCK_H_
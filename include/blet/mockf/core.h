@@ -0,0 +1,2483 @@
+/**
+ * mockf/core.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_CORE_H_
+#define BLET_MOCKF_CORE_H_
+
+#include <dlfcn.h> // dlsym, dlvsym
+#include <errno.h> // errno
+#include <fcntl.h> // O_CREAT, O_TMPFILE
+#include <inttypes.h> // PRIu64
+#include <pthread.h> // pthread_key_create, pthread_setspecific
+#include <stdarg.h> // va_list, va_start, va_end
+#include <stdint.h> // uint64_t, int64_t
+#include <stdio.h>  // fprintf
+#include <stdlib.h> // abort, getenv, atexit
+#include <time.h>   // clock_gettime
+
+#include <exception>
+#include <string>
+
+/**
+ * @brief Mockf class type from name with mockf namepsace
+ * @param name Name of function
+ */
+#define MOCKF_CLASS(name) blet::mockf::MockF_##name
+
+/**
+ * @brief Declare a mockf class from name (name: mockf_{NAME})
+ * @param name Name of function
+ */
+#define MOCKF_INIT(name) MOCKF_CLASS(name) mockf_##name
+
+/**
+ * @brief Declare a mockf class from name used only by the current thread (name: mockf_{NAME})
+ * The instance has the priority on the instance of MOCKF_INIT for this thread, it must be destroyed by this thread.
+ * @param name Name of function
+ */
+#define MOCKF_INIT_THREAD(name) MOCKF_CLASS(name) mockf_##name(::blet::mockf::THREAD)
+
+/**
+ * @brief Get current instance of mockf from name
+ * @param name Name of function
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_INSTANCE(name)                                                                             \
+    ((MOCKF_CLASS(name)::instance())                                                                     \
+         ? *(MOCKF_CLASS(name)::instance())                                                              \
+         : (throw ::blet::mockf::InstanceNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #name), \
+            *(MOCKF_CLASS(name)::instance())))
+
+/**
+ * @brief Enable mock on scope from name
+ * @param name Name of function
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_GUARD(name) ::blet::mockf::Guard mockf_guard_##name(MOCKF_INSTANCE(name).isEnable)
+/**
+ * @brief Disable mock on scope from name
+ * @param name Name of function
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_GUARD_REVERSE(name) ::blet::mockf::GuardReverse mockf_guard_reverse_##name(MOCKF_INSTANCE(name).isEnable)
+/**
+ * @brief Enable mock from name
+ * @param name Name of function
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_ENABLE(name) MOCKF_INSTANCE(name).isEnable = true
+/**
+ * @brief Disable mock from name
+ * @param name Name of function
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_DISABLE(name) MOCKF_INSTANCE(name).isEnable = false
+
+/**
+ * @brief Get the statistics of calls from name (aggregate of all threads)
+ * Counted only if MOCKF_ENABLE_STATS is defined
+ * @param name Name of function
+ * @return blet::mockf::Stats
+ */
+#define MOCKF_STATS(name) MOCKF_CLASS(name)::stats()
+/**
+ * @brief Reset the statistics of calls from name
+ * @param name Name of function
+ */
+#define MOCKF_RESET_STATS(name) MOCKF_CLASS(name)::resetStats()
+
+/**
+ * @brief Set a policy (fault and latency injection) evaluated at each call before the mock or the real function
+ * @param name Name of function
+ * @param policy Pointer of blet::mockf::Policy (must outlive its use)
+ */
+#define MOCKF_SET_POLICY(name, policy) MOCKF_CLASS(name)::setPolicy(policy)
+/**
+ * @brief Remove the policy of function
+ * @param name Name of function
+ */
+#define MOCKF_RESET_POLICY(name) MOCKF_CLASS(name)::setPolicy(NULL)
+
+/**
+ * @brief Set a filter evaluated at each call of an enabled mock before its instance
+ * The calls not matched by the filter use the real function (or handler) without gmock.
+ * @param name Name of function
+ * @param filter Pointer of blet::mockf::Filter (must outlive its use)
+ */
+#define MOCKF_SET_FILTER(name, filter) MOCKF_CLASS(name)::setFilter(filter)
+/**
+ * @brief Remove the filter of function
+ * @param name Name of function
+ */
+#define MOCKF_RESET_FILTER(name) MOCKF_CLASS(name)::setFilter(NULL)
+
+/**
+ * @brief Replace the function called when the mock is not enabled (real function by default)
+ * @param name Name of function
+ * @param handler Function pointer with the same signature of function
+ */
+#define MOCKF_SET_HANDLER(name, handler) MOCKF_CLASS(name)::setHandler(handler)
+/**
+ * @brief Restore the real function as the function called when the mock is not enabled
+ * @param name Name of function
+ */
+#define MOCKF_RESET_HANDLER(name) MOCKF_CLASS(name)::resetHandler()
+
+#ifndef MOCKF_DISABLE_VARIADIC_MACROS
+#define MOCKF_INTERNAL_NARGS_SEQ_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a0, N, ...) N
+#define MOCKF_INTERNAL_NARGS_(...) \
+    MOCKF_INTERNAL_NARGS_SEQ_(__VA_ARGS__, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define MOCKF_INTERNAL_PRE_NARGS_(...) MOCKF_INTERNAL_NARGS_(__VA_ARGS__)
+#define MOCKF_INTERNAL_NOARGS_() 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+#define MOCKF_INTERNAL_NARG_(...) MOCKF_INTERNAL_PRE_NARGS_(MOCKF_INTERNAL_NOARGS_ __VA_ARGS__())
+
+/**
+ * @brief Mock a function
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION(return_type, name, arguments) \
+    MOCKF_INTERNAL_(MOCKF_INTERNAL_NARG_ arguments, return_type, name, arguments)
+/**
+ * @brief Mock a function with a attribute
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(MOCKF_INTERNAL_NARG_ arguments, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(MOCKF_INTERNAL_NARG_ arguments, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with a attribute
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(MOCKF_INTERNAL_NARG_ arguments, return_type, name, arguments, attribute)
+#endif
+
+/**
+ * @brief Mock a function with 0 argument
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION0(return_type, name, arguments) MOCKF_INTERNAL_(0, return_type, name, arguments)
+/**
+ * @brief Mock a function with 1 argument
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION1(return_type, name, arguments) MOCKF_INTERNAL_(1, return_type, name, arguments)
+/**
+ * @brief Mock a function with 2 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION2(return_type, name, arguments) MOCKF_INTERNAL_(2, return_type, name, arguments)
+/**
+ * @brief Mock a function with 3 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION3(return_type, name, arguments) MOCKF_INTERNAL_(3, return_type, name, arguments)
+/**
+ * @brief Mock a function with 4 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION4(return_type, name, arguments) MOCKF_INTERNAL_(4, return_type, name, arguments)
+/**
+ * @brief Mock a function with 5 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION5(return_type, name, arguments) MOCKF_INTERNAL_(5, return_type, name, arguments)
+/**
+ * @brief Mock a function with 6 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION6(return_type, name, arguments) MOCKF_INTERNAL_(6, return_type, name, arguments)
+/**
+ * @brief Mock a function with 7 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION7(return_type, name, arguments) MOCKF_INTERNAL_(7, return_type, name, arguments)
+/**
+ * @brief Mock a function with 8 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION8(return_type, name, arguments) MOCKF_INTERNAL_(8, return_type, name, arguments)
+/**
+ * @brief Mock a function with 9 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION9(return_type, name, arguments) MOCKF_INTERNAL_(9, return_type, name, arguments)
+/**
+ * @brief Mock a function with 10 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION10(return_type, name, arguments) MOCKF_INTERNAL_(10, return_type, name, arguments)
+/**
+ * @brief Mock a function with 11 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION11(return_type, name, arguments) MOCKF_INTERNAL_(11, return_type, name, arguments)
+/**
+ * @brief Mock a function with 12 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION12(return_type, name, arguments) MOCKF_INTERNAL_(12, return_type, name, arguments)
+/**
+ * @brief Mock a function with 13 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION13(return_type, name, arguments) MOCKF_INTERNAL_(13, return_type, name, arguments)
+/**
+ * @brief Mock a function with 14 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION14(return_type, name, arguments) MOCKF_INTERNAL_(14, return_type, name, arguments)
+/**
+ * @brief Mock a function with 15 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_FUNCTION15(return_type, name, arguments) MOCKF_INTERNAL_(15, return_type, name, arguments)
+
+/**
+ * @brief Mock a function with a attribute with 0 argument
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION0(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(0, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 1 argument
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION1(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(1, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 2 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION2(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(2, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 3 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION3(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(3, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 4 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION4(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(4, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 5 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION5(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(5, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 6 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION6(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(6, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 7 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION7(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(7, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 8 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION8(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(8, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 9 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION9(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(9, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 10 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION10(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(10, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 11 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION11(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(11, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 12 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION12(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(12, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 13 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION13(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(13, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 14 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION14(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(14, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a function with a attribute with 15 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_ATTRIBUTE_FUNCTION15(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_(15, return_type, name, arguments, attribute)
+
+/**
+ * @brief Mock a variadic function with 2 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION2(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(2, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 3 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION3(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(3, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 4 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION4(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(4, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 5 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION5(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(5, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 6 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION6(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(6, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 7 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION7(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(7, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 8 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION8(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(8, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 9 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION9(return_type, name, arguments) MOCKF_INTERNAL_VARIADIC_(9, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 10 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION10(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(10, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 11 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION11(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(11, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 12 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION12(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(12, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 13 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION13(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(13, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 14 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION14(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(14, return_type, name, arguments)
+/**
+ * @brief Mock a variadic function with 15 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ */
+#define MOCKF_VARIADIC_FUNCTION15(return_type, name, arguments) \
+    MOCKF_INTERNAL_VARIADIC_(15, return_type, name, arguments)
+
+/**
+ * @brief Mock a variadic function with a attribute with 2 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION2(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(2, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 3 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION3(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(3, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 4 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION4(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(4, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 5 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION5(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(5, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 6 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION6(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(6, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 7 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION7(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(7, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 8 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION8(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(8, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 9 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION9(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(9, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 10 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION10(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(10, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 11 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION11(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(11, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 12 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION12(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(12, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 13 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION13(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(13, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 14 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION14(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(14, return_type, name, arguments, attribute)
+/**
+ * @brief Mock a variadic function with a attribute with 15 arguments
+ * @param return_type Return type of function
+ * @param name Name of function
+ * @param arguments List of arguments enclose by parenthesis
+ * @param attribute Attribute of function
+ */
+#define MOCKF_VARIADIC_ATTRIBUTE_FUNCTION15(return_type, name, arguments, attribute) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(15, return_type, name, arguments, attribute)
+
+struct MockFForceSemiColon {};
+
+/**
+ * @brief Maximum number of real functions in the symbol table
+ */
+#ifndef MOCKF_SYMBOLS_MAX
+#define MOCKF_SYMBOLS_MAX 1024
+#endif
+
+/**
+ * @brief Maximum number of arguments of a call given to a filter
+ */
+#ifndef MOCKF_FILTER_ARGS
+#define MOCKF_FILTER_ARGS 6
+#endif
+
+/**
+ * @brief Maximum number of buckets in the histogram of delays of a policy
+ */
+#ifndef MOCKF_POLICY_MAX_DELAYS
+#define MOCKF_POLICY_MAX_DELAYS 16
+#endif
+
+#if __cplusplus >= 201103L
+#define MOCKF_INTERNAL_THREAD_LOCAL_ thread_local
+#else
+#define MOCKF_INTERNAL_THREAD_LOCAL_ __thread
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+class Exception : public std::exception {
+  public:
+    Exception(const char* file, const char* line, const char* name) throw() :
+        std::exception() {
+        message_ = file;
+        message_ += ":";
+        message_ += line;
+        message_ += ":MockF '";
+        message_ += name;
+        message_ += "' ";
+    }
+    virtual ~Exception() throw() {}
+    const char* what() const throw() {
+        return message_.c_str();
+    }
+
+  protected:
+    std::string message_;
+};
+
+struct InstanceNotFound : public Exception {
+    InstanceNotFound(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "instance not found.";
+    }
+};
+
+struct RealFunctionNotFound : public Exception {
+    RealFunctionNotFound(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "real function not found.";
+    }
+};
+
+struct RealVariadicFunctionUsed : public Exception {
+    RealVariadicFunctionUsed(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "real variadic function cannot use directly.";
+    }
+};
+
+/**
+ * @brief Atomic value based on the gcc builtins (usable in c++98)
+ * @tparam T Integral or pointer type
+ */
+template<typename T>
+struct Atomic {
+    Atomic(T value) :
+        value_(value) {}
+    T load(int order = __ATOMIC_SEQ_CST) const {
+        return __atomic_load_n(&value_, order);
+    }
+    void store(T value, int order = __ATOMIC_SEQ_CST) {
+        __atomic_store_n(&value_, value, order);
+    }
+    Atomic& operator=(T value) {
+        store(value);
+        return *this;
+    }
+    operator T() const {
+        return load();
+    }
+
+  private:
+    Atomic(const Atomic&);            // disable copy
+    Atomic& operator=(const Atomic&); // disable copy
+    T value_;
+};
+
+template<bool AtConstructor, bool AtDestructor>
+struct GuardT {
+    GuardT(Atomic<bool>& boolean) :
+        boolean_(boolean) {
+        boolean_.store(AtConstructor, __ATOMIC_RELEASE);
+    }
+    ~GuardT() {
+        boolean_.store(AtDestructor, __ATOMIC_RELEASE);
+    }
+    Atomic<bool>& boolean_;
+};
+typedef GuardT<true, false> Guard;
+typedef GuardT<false, true> GuardReverse;
+
+/**
+ * @brief Increment a thread depth counter on scope
+ */
+struct DepthGuard {
+    DepthGuard(int& depth) :
+        depth_(depth) {
+        ++depth_;
+    }
+    ~DepthGuard() {
+        --depth_;
+    }
+    int& depth_;
+};
+
+/**
+ * @brief Clocks (monotonic by default) and sleep with the real functions (even if they are mocked)
+ */
+struct Clock {
+    static uint64_t now(clockid_t clock = CLOCK_MONOTONIC) {
+        typedef int (*clock_gettime_t)(clockid_t, struct timespec*);
+        static clock_gettime_t realClockGettime = reinterpret_cast<clock_gettime_t>(dlsym(RTLD_NEXT, "clock_gettime"));
+        struct timespec ts = {0, 0};
+        if (realClockGettime != NULL) {
+            realClockGettime(clock, &ts);
+        }
+        else {
+            // static binary: no next symbol
+            ::clock_gettime(clock, &ts);
+        }
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+    }
+    static void sleep(uint64_t ns) {
+        typedef int (*nanosleep_t)(const struct timespec*, struct timespec*);
+        static nanosleep_t realNanosleep = reinterpret_cast<nanosleep_t>(dlsym(RTLD_NEXT, "nanosleep"));
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000u);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000u);
+        if (realNanosleep != NULL) {
+            while (realNanosleep(&ts, &ts) != 0 && errno == EINTR) {
+            }
+        }
+        else {
+            // static binary: no next symbol
+            while (::nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+            }
+        }
+    }
+};
+
+/**
+ * @brief Value of an argument or of the result of a call: integer, address of pointer or none for the other types
+ */
+struct CallValue {
+    enum Kind {
+        NONE,
+        INTEGER,
+        POINTER
+    };
+    CallValue() :
+        kind(NONE),
+        value(0) {}
+    CallValue(Kind kind_, int64_t value_) :
+        kind(kind_),
+        value(value_) {}
+    Kind kind;
+    int64_t value;
+};
+
+template<bool IsEnum>
+struct CallValueEnum {
+    template<typename A>
+    static CallValue get(const A& /* a */) {
+        return CallValue();
+    }
+};
+
+template<>
+struct CallValueEnum<true> {
+    template<typename A>
+    static CallValue get(const A& a) {
+        return CallValue(CallValue::INTEGER, static_cast<int64_t>(a));
+    }
+};
+
+template<typename A>
+inline CallValue callValue(const A& a) {
+    return CallValueEnum<__is_enum(A)>::get(a);
+}
+
+template<typename A>
+inline CallValue callValue(A* a) {
+    return CallValue(CallValue::POINTER, static_cast<int64_t>(reinterpret_cast<intptr_t>(a)));
+}
+
+// exact overloads: the template of reference is better than a promotion
+#define MOCKF_INTERNAL_CALL_VALUE_(type)                               \
+    inline CallValue callValue(type a) {                               \
+        return CallValue(CallValue::INTEGER, static_cast<int64_t>(a)); \
+    }
+
+MOCKF_INTERNAL_CALL_VALUE_(bool)
+MOCKF_INTERNAL_CALL_VALUE_(char)
+MOCKF_INTERNAL_CALL_VALUE_(signed char)
+MOCKF_INTERNAL_CALL_VALUE_(unsigned char)
+MOCKF_INTERNAL_CALL_VALUE_(short)
+MOCKF_INTERNAL_CALL_VALUE_(unsigned short)
+MOCKF_INTERNAL_CALL_VALUE_(int)
+MOCKF_INTERNAL_CALL_VALUE_(unsigned int)
+MOCKF_INTERNAL_CALL_VALUE_(long)
+MOCKF_INTERNAL_CALL_VALUE_(unsigned long)
+#if __cplusplus >= 201103L // long long (not recorded in C++98)
+MOCKF_INTERNAL_CALL_VALUE_(long long)
+MOCKF_INTERNAL_CALL_VALUE_(unsigned long long)
+#endif
+
+#undef MOCKF_INTERNAL_CALL_VALUE_
+
+/**
+ * @brief Base of the recorders of the calls of fake functions (D: derived class with R result(R))
+ * The fake functions return (result, call): the result is given to the recorder, (void, call) is the built-in comma.
+ */
+template<typename D>
+struct CallRecorder {};
+
+template<typename R, typename D>
+inline R operator,(R value, CallRecorder<D>& call) {
+    return static_cast<D&>(call).result(value);
+}
+
+/**
+ * @brief Fault and latency injection of a mock, evaluated by the fake function before the mock or the real function
+ * The decisions are deterministic for a seed and an index of call.
+ * The configuration is atomic: a policy can be changed while it is used (e.g. in shared memory).
+ */
+class Policy {
+  public:
+    /**
+     * @brief Decision of a call
+     */
+    struct Decision {
+        bool isFailure;
+        int error;
+        bool isShort;
+        size_t size;
+    };
+
+    explicit Policy(uint64_t seed = 0, bool isEnable = true) :
+        seed_(seed),
+        index_(0),
+        isEnable_(isEnable),
+        failureThreshold_(0),
+        error_(0),
+        shortThreshold_(0),
+        shortSize_(0),
+        nbDelay_(0),
+        totalWeight_(0) {}
+
+    /**
+     * @brief Enable or disable the injection (the calls are counted in both cases)
+     */
+    Policy& enable(bool isEnable) {
+        __atomic_store_n(&isEnable_, isEnable, __ATOMIC_RELEASE);
+        return *this;
+    }
+
+    bool isEnable() const {
+        return __atomic_load_n(&isEnable_, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * @brief Fail the call with a probability (return -1 and set errno)
+     */
+    Policy& failure(double probability, int error) {
+        __atomic_store_n(&error_, error, __ATOMIC_RELAXED);
+        __atomic_store_n(&failureThreshold_, threshold(probability), __ATOMIC_RELEASE);
+        return *this;
+    }
+
+    /**
+     * @brief Limit the first size_t argument (short read/write) with a probability
+     */
+    Policy& shortIo(size_t size, double probability = 1.0) {
+        __atomic_store_n(&shortSize_, size, __ATOMIC_RELAXED);
+        __atomic_store_n(&shortThreshold_, threshold(probability), __ATOMIC_RELEASE);
+        return *this;
+    }
+
+    /**
+     * @brief Add a bucket in the histogram of delays (drawn with the weight of bucket)
+     */
+    Policy& delay(uint64_t ns, unsigned int weight = 1) {
+        unsigned int nbDelay = __atomic_load_n(&nbDelay_, __ATOMIC_RELAXED);
+        if (nbDelay < MOCKF_POLICY_MAX_DELAYS) {
+            __atomic_store_n(&delays_[nbDelay], ns, __ATOMIC_RELAXED);
+            __atomic_store_n(&weights_[nbDelay], weight, __ATOMIC_RELAXED);
+            __atomic_store_n(&nbDelay_, nbDelay + 1, __ATOMIC_RELEASE);
+            __atomic_add_fetch(&totalWeight_, weight, __ATOMIC_RELEASE);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Remove the failure, the short read/write and the delays
+     */
+    Policy& clear() {
+        __atomic_store_n(&failureThreshold_, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&shortThreshold_, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&totalWeight_, 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&nbDelay_, 0, __ATOMIC_RELEASE);
+        return *this;
+    }
+
+    /**
+     * @brief Number of evaluated calls
+     */
+    uint64_t count() const {
+        return __atomic_load_n(&index_, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Take the decision of the next call and wait its delay
+     */
+    Decision evaluate() {
+        uint64_t index = __atomic_fetch_add(&index_, 1, __ATOMIC_RELAXED);
+        Decision decision = {false, 0, false, 0};
+        if (!__atomic_load_n(&isEnable_, __ATOMIC_RELAXED)) {
+            return decision;
+        }
+        uint64_t failureThreshold = __atomic_load_n(&failureThreshold_, __ATOMIC_ACQUIRE);
+        if (failureThreshold != 0 && random(index, 0) <= failureThreshold - 1) {
+            decision.isFailure = true;
+            decision.error = __atomic_load_n(&error_, __ATOMIC_RELAXED);
+        }
+        uint64_t shortThreshold = __atomic_load_n(&shortThreshold_, __ATOMIC_ACQUIRE);
+        if (shortThreshold != 0 && random(index, 1) <= shortThreshold - 1) {
+            decision.isShort = true;
+            decision.size = __atomic_load_n(&shortSize_, __ATOMIC_RELAXED);
+        }
+        uint64_t totalWeight = __atomic_load_n(&totalWeight_, __ATOMIC_ACQUIRE);
+        if (totalWeight != 0) {
+            uint64_t draw = random(index, 2) % totalWeight;
+            unsigned int nbDelay = __atomic_load_n(&nbDelay_, __ATOMIC_ACQUIRE);
+            for (unsigned int i = 0; i < nbDelay; ++i) {
+                uint64_t weight = __atomic_load_n(&weights_[i], __ATOMIC_RELAXED);
+                if (draw < weight) {
+                    uint64_t ns = __atomic_load_n(&delays_[i], __ATOMIC_RELAXED);
+                    if (ns > 0) {
+                        Clock::sleep(ns);
+                    }
+                    break;
+                }
+                draw -= weight;
+            }
+        }
+        return decision;
+    }
+
+  private:
+    // 0: never, UINT64_MAX + 1 (0 - 1): always
+    static uint64_t threshold(double probability) {
+        if (probability <= 0.0) {
+            return 0;
+        }
+        if (probability >= 1.0) {
+            return ~static_cast<uint64_t>(0);
+        }
+        return static_cast<uint64_t>(probability * 18446744073709551616.0);
+    }
+
+    // splitmix64 of seed, index and stream
+    uint64_t random(uint64_t index, uint64_t stream) const {
+        uint64_t z = seed_ + (index * 3 + stream + 1) * UINT64_C(0x9E3779B97F4A7C15);
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        return z ^ (z >> 31);
+    }
+
+    uint64_t seed_;
+    uint64_t index_;
+    bool isEnable_;
+    uint64_t failureThreshold_;
+    int error_;
+    uint64_t shortThreshold_;
+    size_t shortSize_;
+    unsigned int nbDelay_;
+    uint64_t totalWeight_;
+    uint64_t delays_[MOCKF_POLICY_MAX_DELAYS];
+    uint64_t weights_[MOCKF_POLICY_MAX_DELAYS];
+};
+
+/**
+ * @brief Result of a failed call by a policy (-1 for signed integers, value initialized otherwise)
+ */
+template<typename R>
+struct PolicyValue {
+    static R failure() {
+        return R();
+    }
+};
+
+template<>
+struct PolicyValue<void> {
+    static void failure() {}
+};
+
+#define MOCKF_INTERNAL_POLICY_VALUE_(type) \
+    template<>                             \
+    struct PolicyValue<type> {             \
+        static type failure() {            \
+            return static_cast<type>(-1);  \
+        }                                  \
+    }
+
+MOCKF_INTERNAL_POLICY_VALUE_(short);
+MOCKF_INTERNAL_POLICY_VALUE_(int);
+MOCKF_INTERNAL_POLICY_VALUE_(long);
+#if __cplusplus >= 201103L // long long (value initialized in C++98)
+MOCKF_INTERNAL_POLICY_VALUE_(long long);
+#endif
+
+/**
+ * @brief Limit the first size_t argument of a short decision
+ */
+struct PolicyLimit {
+    PolicyLimit(const Policy::Decision& decision) :
+        isShort(decision.isShort),
+        size(decision.size) {}
+    template<typename A>
+    void apply(A& /* a */) {}
+    void apply(size_t& a) {
+        if (isShort) {
+            if (a > size) {
+                a = size;
+            }
+            isShort = false;
+        }
+    }
+    bool isShort;
+    size_t size;
+};
+
+/**
+ * @brief Arguments of a call given to a filter (integer value or address of pointer by index)
+ */
+class FilterCall {
+  public:
+    FilterCall() :
+        size_(0) {}
+    /**
+     * @brief Add the next argument of call (see blet::mockf::callValue)
+     */
+    template<typename A>
+    FilterCall& add(const A& a) {
+        if (size_ < MOCKF_FILTER_ARGS) {
+            values_[size_] = callValue(a);
+        }
+        ++size_;
+        return *this;
+    }
+    /**
+     * @brief Number of arguments of call
+     */
+    unsigned int size() const {
+        return size_;
+    }
+    /**
+     * @brief Integer argument or address of pointer argument at index (0 for the other types)
+     */
+    int64_t integer(unsigned int index) const {
+        return index < size_ && index < MOCKF_FILTER_ARGS ? values_[index].value : 0;
+    }
+    /**
+     * @brief Pointer argument at index (NULL for the other types)
+     */
+    const void* pointer(unsigned int index) const {
+        if (index >= size_ || index >= MOCKF_FILTER_ARGS || values_[index].kind != CallValue::POINTER) {
+            return NULL;
+        }
+        return reinterpret_cast<const void*>(static_cast<intptr_t>(values_[index].value));
+    }
+    /**
+     * @brief String argument at index (NULL for the other types)
+     */
+    const char* string(unsigned int index) const {
+        return static_cast<const char*>(pointer(index));
+    }
+
+  private:
+    unsigned int size_;
+    CallValue values_[MOCKF_FILTER_ARGS];
+};
+
+/**
+ * @brief Filter of the calls of an enabled mock (see MOCKF_SET_FILTER)
+ * Evaluated by the fake function without lock, the calls not matched use the real function (or handler).
+ */
+class Filter {
+  public:
+    virtual ~Filter() {}
+    virtual bool match(const FilterCall& call) const = 0;
+};
+
+/**
+ * @brief Match the calls where the integer argument at index is value (e.g. a file descriptor)
+ */
+class FilterEq : public Filter {
+  public:
+    FilterEq(unsigned int index, int64_t value) :
+        index_(index),
+        value_(value) {}
+    bool match(const FilterCall& call) const {
+        return call.integer(index_) == value_;
+    }
+
+  private:
+    unsigned int index_;
+    int64_t value_;
+};
+
+/**
+ * @brief Match the calls where the string argument at index starts with prefix (e.g. the paths under a directory)
+ */
+class FilterPrefix : public Filter {
+  public:
+    FilterPrefix(unsigned int index, const char* prefix) :
+        index_(index),
+        prefix_(prefix) {}
+    bool match(const FilterCall& call) const {
+        const char* str = call.string(index_);
+        if (str == NULL) {
+            return false;
+        }
+        // without strncmp (can be mocked)
+        for (std::size_t i = 0; i < prefix_.size(); ++i) {
+            if (str[i] != prefix_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    unsigned int index_;
+    std::string prefix_;
+};
+
+/**
+ * @brief Match the calls with a predicate: function, functor or lambda of bool(const FilterCall&)
+ */
+template<typename F>
+class FilterPredicate : public Filter {
+  public:
+    explicit FilterPredicate(F predicate) :
+        predicate_(predicate) {}
+    bool match(const FilterCall& call) const {
+        return predicate_(call);
+    }
+
+  private:
+    F predicate_;
+};
+
+template<typename F>
+inline FilterPredicate<F> makeFilter(F predicate) {
+    return FilterPredicate<F>(predicate);
+}
+
+/**
+ * @brief Statistics of calls of a mock
+ */
+struct Stats {
+    enum {
+        NB_SIZE = 65
+    };
+    uint64_t mocked;      // number of calls of mock
+    uint64_t passthrough; // number of calls of real function (or handler)
+    uint64_t injected;    // number of calls failed by a policy (without size)
+    uint64_t realNs;      // time in real function (or handler) in nanoseconds (without delay of policy)
+    uint64_t sizes[NB_SIZE]; // log2 histogram of the first size_t argument (sizes[k]: [2^(k-1), 2^k[)
+    uint64_t calls() const {
+        return mocked + passthrough + injected;
+    }
+    /**
+     * @brief Index of histogram from size
+     */
+    static unsigned int sizeIndex(uint64_t size) {
+        return size == 0 ? 0 : 64 - __builtin_clzll(size);
+    }
+};
+
+/**
+ * @brief Statistics of calls of a thread
+ */
+struct StatsCounters : Stats {
+    StatsCounters* next;       // counters of all threads of mock
+    StatsCounters* threadNext; // counters of mocks of thread
+    StatsCounters** owner;     // slot of thread (NULL: free)
+    static void increment(uint64_t& counter, uint64_t value = 1) {
+        // only the thread writes its counters
+        __atomic_store_n(&counter, __atomic_load_n(&counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+    }
+    /**
+     * @brief Take the counters of an exited thread in the list of mock or push new counters
+     * The counters stay in the list (their calls are kept) and are released at the exit of thread,
+     * the number of counters of a mock is the maximum of threads alive at the same time.
+     */
+    static StatsCounters* acquire(StatsCounters*& head, StatsCounters** owner) {
+        StatsCounters* counters = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+        for (; counters != NULL; counters = counters->next) {
+            StatsCounters** expected = NULL;
+            if (__atomic_load_n(&counters->owner, __ATOMIC_RELAXED) == NULL &&
+                __atomic_compare_exchange_n(&counters->owner, &expected, owner, false, __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        }
+        if (counters == NULL) {
+            counters = new StatsCounters();
+            counters->owner = owner;
+            counters->next = __atomic_load_n(&head, __ATOMIC_RELAXED);
+            while (!__atomic_compare_exchange_n(&head, &counters->next, counters, true, __ATOMIC_RELEASE,
+                                                __ATOMIC_RELAXED)) {
+            }
+        }
+        counters->threadNext = thread();
+        thread() = counters;
+        pthread_setspecific(threadKey(), counters);
+        return counters;
+    }
+    /**
+     * @brief Release the counters of thread at its exit (destructor of threadKey)
+     */
+    static void release(void* /* counters */) {
+        StatsCounters* counters = thread();
+        thread() = NULL;
+        while (counters != NULL) {
+            StatsCounters* threadNext = counters->threadNext;
+            *counters->owner = NULL;
+            __atomic_store_n(&counters->owner, static_cast<StatsCounters**>(NULL), __ATOMIC_RELEASE);
+            counters = threadNext;
+        }
+    }
+    static StatsCounters*& thread() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ StatsCounters* counters = NULL;
+        return counters;
+    }
+    static pthread_key_t threadKey() {
+        static pthread_key_t key;
+        static int error = pthread_key_create(&key, &release);
+        (void)error;
+        return key;
+    }
+    static uint64_t now() {
+        return Clock::now();
+    }
+};
+
+/**
+ * @brief Take the first size_t argument
+ */
+struct StatsSize {
+    StatsSize() :
+        value(-1) {}
+    template<typename A>
+    void add(const A& /* a */) {}
+    void add(size_t a) {
+        if (value < 0) {
+            value = static_cast<int64_t>(a);
+        }
+    }
+    int64_t value;
+};
+
+/**
+ * @brief Count a call of a mock on scope
+ */
+template<typename T>
+struct StatsCall {
+    StatsCall(bool isMocked, int64_t size) :
+        isMocked_(isMocked),
+        isInjected_(false),
+        size_(size),
+        start_(isMocked ? 0 : StatsCounters::now()) {}
+    ~StatsCall() {
+        StatsCounters& counters = T::threadStats();
+        if (isInjected_) {
+            StatsCounters::increment(counters.injected);
+            return;
+        }
+        if (isMocked_) {
+            StatsCounters::increment(counters.mocked);
+        }
+        else {
+            StatsCounters::increment(counters.realNs, StatsCounters::now() - start_);
+            StatsCounters::increment(counters.passthrough);
+        }
+        if (size_ >= 0) {
+            StatsCounters::increment(counters.sizes[Stats::sizeIndex(static_cast<uint64_t>(size_))]);
+        }
+    }
+    /**
+     * @brief Count the call as failed by the policy
+     */
+    void inject() {
+        isInjected_ = true;
+    }
+    /**
+     * @brief Start the time of real function after the delay of policy
+     */
+    void restart() {
+        if (!isMocked_) {
+            start_ = StatsCounters::now();
+        }
+    }
+    bool isMocked_;
+    bool isInjected_;
+    int64_t size_;
+    uint64_t start_;
+};
+
+/**
+ * @brief Counter of the calls of a mock notified by the fake function (see blet/mockf/budget.h)
+ */
+class BudgetCounter {
+  public:
+    virtual ~BudgetCounter() {}
+    /**
+     * @param size First size_t argument (-1 without)
+     * @param isMocked Call of the mock or of the real function (or handler)
+     */
+    virtual void add(int64_t size, bool isMocked) = 0;
+};
+
+/**
+ * @brief Scope of a mock instance
+ * GLOBAL: used by all threads, THREAD: used only by the thread of its construction (priority on GLOBAL)
+ */
+enum Scope {
+    GLOBAL,
+    THREAD
+};
+
+template<typename T>
+struct MockF {
+    explicit MockF(Scope scope = GLOBAL) :
+        isEnable(false),
+        isMaster(false),
+        scope_(scope) {
+        T* expected = NULL;
+        if (scope_ == THREAD) {
+            if (threadInstance() == NULL) {
+                threadInstance() = reinterpret_cast<T*>(this);
+                __atomic_add_fetch(&nbThreadInstance(), 1, __ATOMIC_RELEASE);
+                isMaster = true;
+            }
+        }
+        else if (__atomic_compare_exchange_n(&globalInstance(), &expected, reinterpret_cast<T*>(this), false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            isMaster = true;
+        }
+    }
+    virtual ~MockF() {
+        if (isMaster) {
+            if (scope_ == THREAD) {
+                // must be destroyed by the thread of its construction
+                threadInstance() = NULL;
+                __atomic_sub_fetch(&nbThreadInstance(), 1, __ATOMIC_RELEASE);
+            }
+            else {
+                __atomic_store_n(&globalInstance(), static_cast<T*>(NULL), __ATOMIC_RELEASE);
+            }
+        }
+    }
+    /**
+     * @brief Get the instance of the current thread, or the global instance
+     * @return T* Instance or NULL
+     */
+    static T* instance() {
+        if (__atomic_load_n(&nbThreadInstance(), __ATOMIC_ACQUIRE) != 0) {
+            T* mock = threadInstance();
+            if (mock != NULL) {
+                return mock;
+            }
+        }
+        return __atomic_load_n(&globalInstance(), __ATOMIC_ACQUIRE);
+    }
+    static T*& globalInstance() {
+        static T* singleton = NULL;
+        return singleton;
+    }
+    static T*& threadInstance() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ T* threadSingleton = NULL;
+        return threadSingleton;
+    }
+    // number of instances of THREAD scope (no thread local access without them)
+    static unsigned int& nbThreadInstance() {
+        static unsigned int count = 0;
+        return count;
+    }
+    /**
+     * @brief Get the instance if it is enabled and not already used by the current thread
+     * @return T* Instance or NULL
+     */
+    static T* active() {
+        T* mock = instance();
+        if (mock != NULL && mock->isEnable.load(__ATOMIC_RELAXED) && depth() == 0) {
+            return mock;
+        }
+        return NULL;
+    }
+    /**
+     * @brief Reentrancy depth of the current thread in this mock
+     */
+    static int& depth() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ int threadDepth = 0;
+        return threadDepth;
+    }
+    /**
+     * @brief Statistics of the current thread
+     */
+    static StatsCounters& threadStats() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ StatsCounters* counters = NULL;
+        if (counters == NULL) {
+            counters = StatsCounters::acquire(statsHead(), &counters);
+        }
+        return *counters;
+    }
+    /**
+     * @brief Statistics of all threads
+     */
+    static Stats stats() {
+        Stats total = Stats();
+        for (StatsCounters* counters = __atomic_load_n(&statsHead(), __ATOMIC_ACQUIRE); counters != NULL;
+             counters = counters->next) {
+            total.mocked += __atomic_load_n(&counters->mocked, __ATOMIC_RELAXED);
+            total.passthrough += __atomic_load_n(&counters->passthrough, __ATOMIC_RELAXED);
+            total.injected += __atomic_load_n(&counters->injected, __ATOMIC_RELAXED);
+            total.realNs += __atomic_load_n(&counters->realNs, __ATOMIC_RELAXED);
+            for (unsigned int i = 0; i < Stats::NB_SIZE; ++i) {
+                total.sizes[i] += __atomic_load_n(&counters->sizes[i], __ATOMIC_RELAXED);
+            }
+        }
+        return total;
+    }
+    /**
+     * @brief Reset the statistics of all threads (the calls in progress can be lost)
+     */
+    static void resetStats() {
+        for (StatsCounters* counters = __atomic_load_n(&statsHead(), __ATOMIC_ACQUIRE); counters != NULL;
+             counters = counters->next) {
+            __atomic_store_n(&counters->mocked, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&counters->passthrough, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&counters->injected, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&counters->realNs, 0, __ATOMIC_RELAXED);
+            for (unsigned int i = 0; i < Stats::NB_SIZE; ++i) {
+                __atomic_store_n(&counters->sizes[i], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    static StatsCounters*& statsHead() {
+        static StatsCounters* head = NULL;
+        return head;
+    }
+    /**
+     * @brief Policy evaluated at each call (NULL: no policy)
+     */
+    static Policy* policy() {
+        return __atomic_load_n(&policySlot(), __ATOMIC_ACQUIRE);
+    }
+    static void setPolicy(Policy* policy) {
+        __atomic_store_n(&policySlot(), policy, __ATOMIC_RELEASE);
+    }
+    static Policy*& policySlot() {
+        static Policy* slot = NULL;
+        return slot;
+    }
+    /**
+     * @brief Filter of the calls of an enabled mock (NULL: all calls)
+     */
+    static const Filter* filter() {
+        return __atomic_load_n(&filterSlot(), __ATOMIC_ACQUIRE);
+    }
+    static void setFilter(const Filter* filter) {
+        __atomic_store_n(&filterSlot(), filter, __ATOMIC_RELEASE);
+    }
+    static const Filter*& filterSlot() {
+        static const Filter* slot = NULL;
+        return slot;
+    }
+    /**
+     * @brief Counter of calls notified at each call (NULL: no counter)
+     */
+    static BudgetCounter* budget() {
+        return __atomic_load_n(&budgetSlot(), __ATOMIC_ACQUIRE);
+    }
+    static void setBudget(BudgetCounter* budget) {
+        __atomic_store_n(&budgetSlot(), budget, __ATOMIC_RELEASE);
+    }
+    static BudgetCounter*& budgetSlot() {
+        static BudgetCounter* slot = NULL;
+        return slot;
+    }
+    /**
+     * @brief Version of the real symbol (NULL: default version)
+     */
+    static const char*& version() {
+        static const char* symbolVersion = NULL;
+        return symbolVersion;
+    }
+    Atomic<bool> isEnable;
+    bool isMaster;
+
+  private:
+    Scope scope_;
+};
+
+/**
+ * @brief Find the next symbol of name after the current object
+ * @param version Version of symbol (e.g. "GLIBC_2.2.5") or NULL for the default version
+ */
+inline void* loadSymbol(const char* name, const char* version) {
+#ifdef __GLIBC__
+    if (version != NULL) {
+        return dlvsym(RTLD_NEXT, name, version);
+    }
+#else
+    (void)version;
+#endif
+    return dlsym(RTLD_NEXT, name);
+}
+
+/**
+ * @brief Table of the real functions of mocks
+ * Each mock registers its loader at load time, the real function is resolved at the registration.
+ * Define MOCKF_STRICT_SYMBOLS for abort at load time when a real function is not found.
+ */
+struct Symbols {
+    typedef bool (*load_t)();
+    typedef Stats (*stats_t)();
+    typedef void (*policy_t)(Policy*);
+    struct Entry {
+        const char* name;
+        load_t load;
+        stats_t stats;
+        policy_t policy;
+    };
+    static Entry* entries() {
+        static Entry table[MOCKF_SYMBOLS_MAX];
+        return table;
+    }
+    static unsigned int& size() {
+        static unsigned int count = 0;
+        return count;
+    }
+    static void add(const char* name, load_t load, stats_t stats, policy_t policy) {
+#ifdef MOCKF_ENABLE_STATS
+        if (size() == 0 && getenv("MOCKF_STATS_JSON") != NULL) {
+            atexit(&dumpStatsAtExit);
+        }
+#endif
+        if (size() < MOCKF_SYMBOLS_MAX) {
+            entries()[size()].name = name;
+            entries()[size()].load = load;
+            entries()[size()].stats = stats;
+            entries()[size()].policy = policy;
+            ++size();
+        }
+        if (!load()) {
+#ifdef MOCKF_STRICT_SYMBOLS
+            fprintf(stderr, "MockF '%s' real function not found.\n", name);
+            abort();
+#endif
+        }
+    }
+    /**
+     * @brief Resolve again all real functions (e.g. after a dlopen)
+     * @return unsigned int Number of real functions not found
+     */
+    static unsigned int resolve() {
+        unsigned int missing = 0;
+        for (unsigned int i = 0; i < size(); ++i) {
+            if (!entries()[i].load()) {
+                ++missing;
+            }
+        }
+        return missing;
+    }
+    /**
+     * @brief Set the policy of a mock from its name
+     * @return bool False if the mock is not found
+     */
+    static bool setPolicy(const char* name, Policy* policy) {
+        for (unsigned int i = 0; i < size(); ++i) {
+            if (isEqual(entries()[i].name, name)) {
+                entries()[i].policy(policy);
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * @brief Write the statistics of all mocks in json
+     */
+    static void dumpStats(FILE* file) {
+        fprintf(file, "{");
+        for (unsigned int i = 0; i < size(); ++i) {
+            Stats stats = entries()[i].stats();
+            fprintf(file,
+                    "%s\n  \"%s\": {\"mocked\": %" PRIu64 ", \"passthrough\": %" PRIu64 ", \"injected\": %" PRIu64
+                    ", \"real_ns\": %" PRIu64 ", \"sizes\": {",
+                    i == 0 ? "" : ",", entries()[i].name, stats.mocked, stats.passthrough, stats.injected,
+                    stats.realNs);
+            const char* separator = "";
+            for (unsigned int j = 0; j < Stats::NB_SIZE; ++j) {
+                if (stats.sizes[j] > 0) {
+                    // lower bound of bucket
+                    fprintf(file, "%s\"%" PRIu64 "\": %" PRIu64, separator, j == 0 ? 0 : UINT64_C(1) << (j - 1),
+                            stats.sizes[j]);
+                    separator = ", ";
+                }
+            }
+            fprintf(file, "}}");
+        }
+        fprintf(file, "\n}\n");
+    }
+    // compare without strcmp (can be mocked)
+    static bool isEqual(const char* str1, const char* str2) {
+        while (*str1 != '\0' && *str1 == *str2) {
+            ++str1;
+            ++str2;
+        }
+        return *str1 == *str2;
+    }
+    /**
+     * @brief Write the statistics in the file of MOCKF_STATS_JSON environment variable
+     */
+    static void dumpStatsAtExit() {
+        const char* filename = getenv("MOCKF_STATS_JSON");
+        if (filename != NULL) {
+            FILE* file = fopen(filename, "w");
+            if (file != NULL) {
+                dumpStats(file);
+                fclose(file);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Register a real function in the symbol table
+ */
+struct Symbol {
+    Symbol(const char* name, Symbols::load_t load, Symbols::stats_t stats, Symbols::policy_t policy) {
+        Symbols::add(name, load, stats, policy);
+    }
+};
+
+/**
+ * @brief Forward the call of a disabled variadic mock to its real function (or its handler)
+ * Specialized for the known variadic functions (v-variant or decoded argument).
+ * The primary template does not forward (RealVariadicFunctionUsed is thrown by the fake).
+ * @tparam T Mockf class
+ */
+template<typename T>
+struct Variadic {
+    template<typename F>
+    static void load(F /* real */) {}
+#if __cplusplus >= 201103L
+    template<typename R, typename F, typename... A>
+    static bool forward(R& /* ret */, F /* real */, A... /* args */) {
+        return false;
+    }
+#else
+    template<typename R, typename F, typename A1>
+    static bool forward(R& /* ret */, F /* real */, A1, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9, typename A10>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9, typename A10, typename A11>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12,
+                        va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13,
+                        va_list /* args */) {
+        return false;
+    }
+    template<typename R, typename F, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+             typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13,
+             typename A14>
+    static bool forward(R& /* ret */, F /* real */, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14,
+                        va_list /* args */) {
+        return false;
+    }
+#endif
+};
+
+/**
+ * @brief Call of a variadic mock with a va_list (defined with the fake of mock)
+ * call(args..., va_list) forwards the disabled calls with Variadic<T>, call(forward, args..., va_list) with the
+ * forward(ret, handler, args..., va_list) of forward.
+ * @tparam T Mockf class
+ */
+template<typename T>
+struct VariadicFake;
+
+/* the v-variant is resolved with the real function and used only while the handler is the real function */
+#define MOCKF_INTERNAL_VARIADIC_V_LOAD_(vname, p, vp)                                \
+    typedef int(*function_t) p;                                                      \
+    typedef int(*vfunction_t) vp;                                                    \
+    static void load(function_t real) {                                              \
+        vfunction_t vfunc = reinterpret_cast<vfunction_t>(loadSymbol(#vname, NULL)); \
+        if (vfunc == NULL) {                                                         \
+            /* static binary */                                                      \
+            vfunc = &::vname;                                                        \
+        }                                                                            \
+        __atomic_store_n(&vrealSlot(), vfunc, __ATOMIC_RELAXED);                     \
+        __atomic_store_n(&realSlot(), real, __ATOMIC_RELEASE);                       \
+    }                                                                                \
+    static vfunction_t vreal(function_t handler) {                                   \
+        if (handler != __atomic_load_n(&realSlot(), __ATOMIC_ACQUIRE)) {             \
+            return NULL;                                                             \
+        }                                                                            \
+        return __atomic_load_n(&vrealSlot(), __ATOMIC_RELAXED);                      \
+    }                                                                                \
+    static function_t& realSlot() {                                                  \
+        static function_t slot = NULL;                                               \
+        return slot;                                                                 \
+    }                                                                                \
+    static vfunction_t& vrealSlot() {                                                \
+        static vfunction_t slot = NULL;                                              \
+        return slot;                                                                 \
+    }
+
+#define MOCKF_INTERNAL_VARIADIC_V_FORWARD_1_(name, vname, A1)                 \
+    struct MockF_##name;                                                      \
+    template<>                                                                \
+    struct Variadic<MockF_##name> {                                           \
+        MOCKF_INTERNAL_VARIADIC_V_LOAD_(vname, (A1, ...), (A1, va_list))      \
+        static bool forward(int& ret, function_t real, A1 a1, va_list args) { \
+            vfunction_t vfunc = vreal(real);                                  \
+            if (vfunc == NULL) {                                              \
+                return false;                                                 \
+            }                                                                 \
+            ret = vfunc(a1, args);                                            \
+            return true;                                                      \
+        }                                                                     \
+    }
+#define MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(name, vname, A1, A2)                    \
+    struct MockF_##name;                                                             \
+    template<>                                                                       \
+    struct Variadic<MockF_##name> {                                                  \
+        MOCKF_INTERNAL_VARIADIC_V_LOAD_(vname, (A1, A2, ...), (A1, A2, va_list))     \
+        static bool forward(int& ret, function_t real, A1 a1, A2 a2, va_list args) { \
+            vfunction_t vfunc = vreal(real);                                         \
+            if (vfunc == NULL) {                                                     \
+                return false;                                                        \
+            }                                                                        \
+            ret = vfunc(a1, a2, args);                                               \
+            return true;                                                             \
+        }                                                                            \
+    }
+#define MOCKF_INTERNAL_VARIADIC_V_FORWARD_3_(name, vname, A1, A2, A3)                       \
+    struct MockF_##name;                                                                    \
+    template<>                                                                              \
+    struct Variadic<MockF_##name> {                                                         \
+        MOCKF_INTERNAL_VARIADIC_V_LOAD_(vname, (A1, A2, A3, ...), (A1, A2, A3, va_list))    \
+        static bool forward(int& ret, function_t real, A1 a1, A2 a2, A3 a3, va_list args) { \
+            vfunction_t vfunc = vreal(real);                                                \
+            if (vfunc == NULL) {                                                            \
+                return false;                                                               \
+            }                                                                               \
+            ret = vfunc(a1, a2, a3, args);                                                  \
+            return true;                                                                    \
+        }                                                                                   \
+    }
+
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_1_(printf, vprintf, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(fprintf, vfprintf, FILE*, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(dprintf, vdprintf, int, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(sprintf, vsprintf, char*, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_3_(snprintf, vsnprintf, char*, size_t, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(asprintf, vasprintf, char**, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_1_(scanf, vscanf, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(fscanf, vfscanf, FILE*, const char*);
+MOCKF_INTERNAL_VARIADIC_V_FORWARD_2_(sscanf, vsscanf, const char*, const char*);
+
+/**
+ * @brief Take the mode of open if the flags need it
+ */
+inline int openMode(int flags, va_list args) {
+#ifdef O_TMPFILE
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE) {
+#else
+    if ((flags & O_CREAT) != 0) {
+#endif
+        return va_arg(args, int);
+    }
+    return 0;
+}
+
+#define MOCKF_INTERNAL_VARIADIC_OPEN_FORWARD_(name)                                        \
+    struct MockF_##name;                                                                   \
+    template<>                                                                             \
+    struct Variadic<MockF_##name> {                                                        \
+        template<typename F>                                                               \
+        static void load(F /* real */) {}                                                  \
+        template<typename F>                                                               \
+        static bool forward(int& ret, F real, const char* file, int flags, va_list args) { \
+            ret = real(file, flags, openMode(flags, args));                                \
+            return true;                                                                   \
+        }                                                                                  \
+    }
+#define MOCKF_INTERNAL_VARIADIC_OPENAT_FORWARD_(name)                                              \
+    struct MockF_##name;                                                                           \
+    template<>                                                                                     \
+    struct Variadic<MockF_##name> {                                                                \
+        template<typename F>                                                                       \
+        static void load(F /* real */) {}                                                          \
+        template<typename F>                                                                       \
+        static bool forward(int& ret, F real, int fd, const char* file, int flags, va_list args) { \
+            ret = real(fd, file, flags, openMode(flags, args));                                    \
+            return true;                                                                           \
+        }                                                                                          \
+    }
+// the third argument is taken as a pointer like the glibc implementation
+#define MOCKF_INTERNAL_VARIADIC_POINTER_FORWARD_(name, A1, A2)              \
+    struct MockF_##name;                                                    \
+    template<>                                                              \
+    struct Variadic<MockF_##name> {                                         \
+        template<typename F>                                                \
+        static void load(F /* real */) {}                                   \
+        template<typename F>                                                \
+        static bool forward(int& ret, F real, A1 a1, A2 a2, va_list args) { \
+            ret = real(a1, a2, va_arg(args, void*));                        \
+            return true;                                                    \
+        }                                                                   \
+    }
+
+MOCKF_INTERNAL_VARIADIC_OPEN_FORWARD_(open);
+MOCKF_INTERNAL_VARIADIC_OPEN_FORWARD_(open64);
+MOCKF_INTERNAL_VARIADIC_OPENAT_FORWARD_(openat);
+MOCKF_INTERNAL_VARIADIC_OPENAT_FORWARD_(openat64);
+MOCKF_INTERNAL_VARIADIC_POINTER_FORWARD_(fcntl, int, int);
+MOCKF_INTERNAL_VARIADIC_POINTER_FORWARD_(fcntl64, int, int);
+MOCKF_INTERNAL_VARIADIC_POINTER_FORWARD_(ioctl, int, unsigned long int);
+
+template<typename F>
+struct Function;
+
+template<typename R>
+struct Function<R()> {
+    typedef R Result;
+};
+
+template<typename R, typename A1>
+struct Function<R(A1)> : Function<R()> {
+    typedef A1 Argument1;
+};
+
+template<typename R, typename A1, typename A2>
+struct Function<R(A1, A2)> : Function<R(A1)> {
+    typedef A2 Argument2;
+};
+
+template<typename R, typename A1, typename A2, typename A3>
+struct Function<R(A1, A2, A3)> : Function<R(A1, A2)> {
+    typedef A3 Argument3;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4>
+struct Function<R(A1, A2, A3, A4)> : Function<R(A1, A2, A3)> {
+    typedef A4 Argument4;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct Function<R(A1, A2, A3, A4, A5)> : Function<R(A1, A2, A3, A4)> {
+    typedef A5 Argument5;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct Function<R(A1, A2, A3, A4, A5, A6)> : Function<R(A1, A2, A3, A4, A5)> {
+    typedef A6 Argument6;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7)> : Function<R(A1, A2, A3, A4, A5, A6)> {
+    typedef A7 Argument7;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8)> : Function<R(A1, A2, A3, A4, A5, A6, A7)> {
+    typedef A8 Argument8;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9)> : Function<R(A1, A2, A3, A4, A5, A6, A7, A8)> {
+    typedef A9 Argument9;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10)> : Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9)> {
+    typedef A10 Argument10;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10, typename A11>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11)> :
+    Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10)> {
+    typedef A11 Argument11;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10, typename A11, typename A12>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12)> :
+    Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11)> {
+    typedef A12 Argument12;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13)> :
+    Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12)> {
+    typedef A13 Argument13;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14)> :
+    Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13)> {
+    typedef A14 Argument14;
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7,
+         typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15>
+struct Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15)> :
+    Function<R(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14)> {
+    typedef A15 Argument15;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#define MOCKF_INTERNAL_STRINGIFY_(x) #x
+#define MOCKF_INTERNAL_TO_STRING_(x) MOCKF_INTERNAL_STRINGIFY_(x)
+
+#define MOCKF_INTERNAL_CAT_IMPL_(x, y) x##y
+#define MOCKF_INTERNAL_CAT_(x, y) MOCKF_INTERNAL_CAT_IMPL_(x, y)
+#define MOCKF_INTERNAL_CAT2_(x, y, z) MOCKF_INTERNAL_CAT_(MOCKF_INTERNAL_CAT_(x, y), z)
+
+#define MOCKF_INTERNAL_SUB_1_ 0
+#define MOCKF_INTERNAL_SUB_2_ 1
+#define MOCKF_INTERNAL_SUB_3_ 2
+#define MOCKF_INTERNAL_SUB_4_ 3
+#define MOCKF_INTERNAL_SUB_5_ 4
+#define MOCKF_INTERNAL_SUB_6_ 5
+#define MOCKF_INTERNAL_SUB_7_ 6
+#define MOCKF_INTERNAL_SUB_8_ 7
+#define MOCKF_INTERNAL_SUB_9_ 8
+#define MOCKF_INTERNAL_SUB_10_ 9
+#define MOCKF_INTERNAL_SUB_11_ 10
+#define MOCKF_INTERNAL_SUB_12_ 11
+#define MOCKF_INTERNAL_SUB_13_ 12
+#define MOCKF_INTERNAL_SUB_14_ 13
+#define MOCKF_INTERNAL_SUB_15_ 14
+#define MOCKF_INTERNAL_SUB_(x) MOCKF_INTERNAL_CAT2_(MOCKF_INTERNAL_SUB_, x, _)
+
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_1_(a1) ()
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_2_(a1, a2) (a1)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_3_(a1, a2, a3) (a1, a2)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_4_(a1, a2, a3, a4) (a1, a2, a3)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_5_(a1, a2, a3, a4, a5) (a1, a2, a3, a4)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_6_(a1, a2, a3, a4, a5, a6) (a1, a2, a3, a4, a5)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_7_(a1, a2, a3, a4, a5, a6, a7) (a1, a2, a3, a4, a5, a6)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_8_(a1, a2, a3, a4, a5, a6, a7, a8) (a1, a2, a3, a4, a5, a6, a7)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_9_(a1, a2, a3, a4, a5, a6, a7, a8, a9) (a1, a2, a3, a4, a5, a6, a7, a8)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_10_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) (a1, a2, a3, a4, a5, a6, a7, a8, a9)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_11_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) \
+    (a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_12_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) \
+    (a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_13_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) \
+    (a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_14_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) \
+    (a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_15_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) \
+    (a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14)
+#define MOCKF_INTERNAL_REMOVE_LAST_ARG_(x) MOCKF_INTERNAL_CAT2_(MOCKF_INTERNAL_REMOVE_LAST_ARG_, x, _)
+
+#define MOCKF_INTERNAL_REPEAT_0_(b, m, f) /* nothing */
+#define MOCKF_INTERNAL_REPEAT_1_(b, m, f) m(b, 1, f)
+#define MOCKF_INTERNAL_REPEAT_2_(b, m, f) MOCKF_INTERNAL_REPEAT_1_(b, m, f), m(b, 2, f)
+#define MOCKF_INTERNAL_REPEAT_3_(b, m, f) MOCKF_INTERNAL_REPEAT_2_(b, m, f), m(b, 3, f)
+#define MOCKF_INTERNAL_REPEAT_4_(b, m, f) MOCKF_INTERNAL_REPEAT_3_(b, m, f), m(b, 4, f)
+#define MOCKF_INTERNAL_REPEAT_5_(b, m, f) MOCKF_INTERNAL_REPEAT_4_(b, m, f), m(b, 5, f)
+#define MOCKF_INTERNAL_REPEAT_6_(b, m, f) MOCKF_INTERNAL_REPEAT_5_(b, m, f), m(b, 6, f)
+#define MOCKF_INTERNAL_REPEAT_7_(b, m, f) MOCKF_INTERNAL_REPEAT_6_(b, m, f), m(b, 7, f)
+#define MOCKF_INTERNAL_REPEAT_8_(b, m, f) MOCKF_INTERNAL_REPEAT_7_(b, m, f), m(b, 8, f)
+#define MOCKF_INTERNAL_REPEAT_9_(b, m, f) MOCKF_INTERNAL_REPEAT_8_(b, m, f), m(b, 9, f)
+#define MOCKF_INTERNAL_REPEAT_10_(b, m, f) MOCKF_INTERNAL_REPEAT_9_(b, m, f), m(b, 10, f)
+#define MOCKF_INTERNAL_REPEAT_11_(b, m, f) MOCKF_INTERNAL_REPEAT_10_(b, m, f), m(b, 11, f)
+#define MOCKF_INTERNAL_REPEAT_12_(b, m, f) MOCKF_INTERNAL_REPEAT_11_(b, m, f), m(b, 12, f)
+#define MOCKF_INTERNAL_REPEAT_13_(b, m, f) MOCKF_INTERNAL_REPEAT_12_(b, m, f), m(b, 13, f)
+#define MOCKF_INTERNAL_REPEAT_14_(b, m, f) MOCKF_INTERNAL_REPEAT_13_(b, m, f), m(b, 14, f)
+#define MOCKF_INTERNAL_REPEAT_15_(b, m, f) MOCKF_INTERNAL_REPEAT_14_(b, m, f), m(b, 15, f)
+#define MOCKF_INTERNAL_REPEAT_(i) MOCKF_INTERNAL_CAT2_(MOCKF_INTERNAL_REPEAT_, i, _)
+
+#define MOCKF_INTERNAL_ARG_(b, i, f) MOCKF_INTERNAL_CAT_(mockf_a, MOCKF_INTERNAL_SUB_(i))
+#define MOCKF_INTERNAL_UNUSED_ARG_(b, i, f) static_cast<void>(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_ARG_DECLARATION_(b, i, f) \
+    ::blet::mockf::Function<f>::MOCKF_INTERNAL_CAT_(Argument, i) MOCKF_INTERNAL_ARG_(b, i, f)
+
+#define MOCKF_INTERNAL_(i, r, n, f) \
+    MOCKF_INTERNAL_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_DEFINITION_(i, r, n, f)
+
+#define MOCKF_INTERNAL_ATTRIBUTE_(i, r, n, f, a) \
+    MOCKF_INTERNAL_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_ATTRIBUTE_DEFINITION_(i, r, n, f, a)
+
+#define MOCKF_INTERNAL_VARIADIC_(i, r, n, f) \
+    MOCKF_INTERNAL_VARIADIC_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_VARIADIC_DEFINITION_(i, r, n, f)
+
+#define MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(i, r, n, f, a) \
+    MOCKF_INTERNAL_VARIADIC_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_DEFINITION_(i, r, n, f, a)
+
+/* link-time interception (-Wl,--wrap=n): the fake is __wrap_n and the real function is __real_n */
+#ifdef MOCKF_ENABLE_WRAP
+#define MOCKF_INTERNAL_FAKE_NAME_(n) __wrap_##n
+#define MOCKF_INTERNAL_FAKE_LINKAGE_ extern "C"
+#define MOCKF_INTERNAL_REAL_DECLARATION_(r, n, f) extern "C" r __real_##n f;
+#define MOCKF_INTERNAL_REAL_SYMBOL_(n) reinterpret_cast<function_t>(&__real_##n)
+#else
+#define MOCKF_INTERNAL_FAKE_NAME_(n) n
+#define MOCKF_INTERNAL_FAKE_LINKAGE_
+#define MOCKF_INTERNAL_REAL_DECLARATION_(r, n, f)
+#define MOCKF_INTERNAL_REAL_SYMBOL_(n) reinterpret_cast<function_t>(loadSymbol(#n, version()))
+#endif
+
+/* class of mock (usable in a header) */
+#define MOCKF_INTERNAL_DECLARATION_(i, r, n, f) \
+    MOCKF_INTERNAL_CLASS_IMPL_(i, r, n, f, MOCKF_INTERNAL_METHOD_, MOCKF_INTERNAL_UNRESOLVED_)
+
+#define MOCKF_INTERNAL_VARIADIC_DECLARATION_(i, r, n, f) \
+    MOCKF_INTERNAL_CLASS_IMPL_(i, r, n, f, MOCKF_INTERNAL_VARIADIC_METHOD_, MOCKF_INTERNAL_VARIADIC_UNRESOLVED_)
+
+/* static members, registration and fake function of mock (in one source file) */
+#define MOCKF_INTERNAL_DEFINITION_(i, r, n, f) \
+    MOCKF_INTERNAL_CLASS_DEFINITION_(n)        \
+    MOCKF_INTERNAL_FAKE_FUNC_(i, r, n, f) struct MockFForceSemiColon
+
+#define MOCKF_INTERNAL_ATTRIBUTE_DEFINITION_(i, r, n, f, a) \
+    MOCKF_INTERNAL_CLASS_DEFINITION_(n)                     \
+    MOCKF_INTERNAL_FAKE_ATTRIBUTE_FUNC_(i, r, n, f, a) struct MockFForceSemiColon
+
+#define MOCKF_INTERNAL_VARIADIC_DEFINITION_(i, r, n, f) \
+    MOCKF_INTERNAL_CLASS_DEFINITION_(n)                 \
+    MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_(i, r, n, f) struct MockFForceSemiColon
+
+#define MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_DEFINITION_(i, r, n, f, a) \
+    MOCKF_INTERNAL_CLASS_DEFINITION_(n)                              \
+    MOCKF_INTERNAL_FAKE_ATTRIBUTE_VARIADIC_FUNC_(i, r, n, f, a) struct MockFForceSemiColon
+
+#define MOCKF_INTERNAL_CLASS_IMPL_(i, r, n, f, m, u)                                                \
+    namespace blet {                                                                                \
+    namespace mockf {                                                                               \
+    MOCKF_INTERNAL_REAL_DECLARATION_(r, n, f)                                                       \
+    struct MockF_##n : public MockF<MockF_##n> {                                                    \
+        MockF_##n() :                                                                               \
+            MockF<MockF_##n>() {}                                                                   \
+        explicit MockF_##n(Scope scope) :                                                           \
+            MockF<MockF_##n>(scope) {}                                                              \
+        typedef r(*function_t) f;                                                                   \
+        static const char* functionName() {                                                         \
+            return #n;                                                                              \
+        }                                                                                           \
+        static function_t real() {                                                                  \
+            return __atomic_load_n(&realFunction, __ATOMIC_RELAXED);                                \
+        }                                                                                           \
+        static bool isResolved() {                                                                  \
+            return real() != &unresolved;                                                           \
+        }                                                                                           \
+        static function_t handler() {                                                               \
+            return __atomic_load_n(&handlerFunction, __ATOMIC_ACQUIRE);                             \
+        }                                                                                           \
+        static void setHandler(function_t func) {                                                   \
+            __atomic_store_n(&handlerFunction, func, __ATOMIC_RELEASE);                             \
+        }                                                                                           \
+        static void resetHandler() {                                                                \
+            setHandler(real());                                                                     \
+        }                                                                                           \
+        static bool load() {                                                                        \
+            function_t func = MOCKF_INTERNAL_REAL_SYMBOL_(n);                                       \
+            if (func == NULL) {                                                                     \
+                return false;                                                                       \
+            }                                                                                       \
+            function_t expected = real();                                                           \
+            __atomic_store_n(&realFunction, func, __ATOMIC_RELAXED);                                \
+            __atomic_compare_exchange_n(&handlerFunction, &expected, func, false, __ATOMIC_RELEASE, \
+                                        __ATOMIC_RELAXED);                                          \
+            Variadic<MockF_##n>::load(func);                                                        \
+            return true;                                                                            \
+        }                                                                                           \
+        u(i, r, n, f)                                                                               \
+        static function_t realFunction;                                                             \
+        static function_t handlerFunction;                                                          \
+        m(i, r, n, f);                                                                              \
+    };                                                                                              \
+    }                                                                                               \
+    }
+
+#define MOCKF_INTERNAL_CLASS_DEFINITION_(n)                                                               \
+    namespace blet {                                                                                      \
+    namespace mockf {                                                                                     \
+    MockF_##n::function_t MockF_##n::realFunction = &MockF_##n::unresolved;                               \
+    MockF_##n::function_t MockF_##n::handlerFunction = &MockF_##n::unresolved;                            \
+    static const Symbol mockf_symbol_##n(#n, &MockF_##n::load, &MockF_##n::stats, &MockF_##n::setPolicy); \
+    }                                                                                                     \
+    }
+
+/* first call of real function when it is not resolved at load time */
+#define MOCKF_INTERNAL_UNRESOLVED_(i, r, n, f)                                                            \
+    static MOCKF_INTERNAL_FAKE_FUNC_PROTOTYPE_(i, r, unresolved, f) {                                     \
+        if (!load()) {                                                                                    \
+            throw ::blet::mockf::RealFunctionNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n); \
+        }                                                                                                 \
+        return real()(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_, f));                              \
+    }
+
+#define MOCKF_INTERNAL_VARIADIC_UNRESOLVED_(i, r, n, f)                                                        \
+    static MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_PROTOTYPE_(i, r, unresolved, f) {                                 \
+        MOCKF_INTERNAL_REPEAT_(MOCKF_INTERNAL_SUB_(i))(MOCKF_INTERNAL_SUB_(i), MOCKF_INTERNAL_UNUSED_ARG_, 0); \
+        if (!load()) {                                                                                         \
+            throw ::blet::mockf::RealFunctionNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n);      \
+        }                                                                                                      \
+        throw ::blet::mockf::RealVariadicFunctionUsed(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n);      \
+    }
+
+/* the calls of an enabled mock not matched by its filter use the real function (or handler) */
+#define MOCKF_INTERNAL_FILTER_ARG_(b, i, f) mockf_filter_call.add(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_FILTER_(i, n, f)                                       \
+    if (mockf_instance != NULL) {                                             \
+        const ::blet::mockf::Filter* mockf_filter = MOCKF_CLASS(n)::filter(); \
+        if (mockf_filter != NULL) {                                           \
+            ::blet::mockf::FilterCall mockf_filter_call;                      \
+            MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_FILTER_ARG_, f);      \
+            if (!mockf_filter->match(mockf_filter_call)) {                    \
+                mockf_instance = NULL;                                        \
+            }                                                                 \
+        }                                                                     \
+    }
+
+#ifdef MOCKF_ENABLE_STATS
+#define MOCKF_INTERNAL_STATS_SIZE_ARG_(b, i, f) mockf_stats_size.add(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_STATS_(i, n, f)                               \
+    ::blet::mockf::StatsSize mockf_stats_size;                       \
+    MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_STATS_SIZE_ARG_, f); \
+    ::blet::mockf::StatsCall<MOCKF_CLASS(n)> mockf_stats_##n(mockf_instance != NULL, mockf_stats_size.value);
+#define MOCKF_INTERNAL_STATS_POLICY_(n, isFailure) \
+    if (isFailure) {                               \
+        mockf_stats_##n.inject();                  \
+    }                                              \
+    else {                                         \
+        mockf_stats_##n.restart();                 \
+    }
+#else
+#define MOCKF_INTERNAL_STATS_(i, n, f) /* nothing */
+#define MOCKF_INTERNAL_STATS_POLICY_(n, isFailure) /* nothing */
+#endif
+
+#ifdef MOCKF_ENABLE_TIMELINE
+#define MOCKF_INTERNAL_TIMELINE_ARG_(b, i, f) mockf_timeline_call.arg(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_TIMELINE_(i, n, f)                                                    \
+    ::blet::mockf::TimelineCall<MOCKF_CLASS(n)> mockf_timeline_call(mockf_instance != NULL); \
+    MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_TIMELINE_ARG_, f);
+#define MOCKF_INTERNAL_TIMELINE_RESULT_(r, result) static_cast<r>((result, mockf_timeline_call))
+#else
+#define MOCKF_INTERNAL_TIMELINE_(i, n, f) /* nothing */
+#define MOCKF_INTERNAL_TIMELINE_RESULT_(r, result) result
+#endif
+
+#ifdef MOCKF_ENABLE_SHARED
+#define MOCKF_INTERNAL_SHARED_SIZE_ARG_(b, i, f) mockf_shared_size.add(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_SHARED_(i, n, f)                               \
+    ::blet::mockf::StatsSize mockf_shared_size;                       \
+    MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_SHARED_SIZE_ARG_, f); \
+    ::blet::mockf::SharedCall<MOCKF_CLASS(n)> mockf_shared_call(mockf_instance != NULL, mockf_shared_size.value);
+/* see blet::mockf::CallRecorder */
+#define MOCKF_INTERNAL_SHARED_RESULT_(r, result) \
+    static_cast<r>((MOCKF_INTERNAL_TIMELINE_RESULT_(r, result), mockf_shared_call))
+#else
+#define MOCKF_INTERNAL_SHARED_(i, n, f) /* nothing */
+#define MOCKF_INTERNAL_SHARED_RESULT_(r, result) MOCKF_INTERNAL_TIMELINE_RESULT_(r, result)
+#endif
+
+#define MOCKF_INTERNAL_BUDGET_SIZE_ARG_(b, i, f) mockf_budget_size.add(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_BUDGET_(i, n, f)                                     \
+    ::blet::mockf::BudgetCounter* mockf_budget = MOCKF_CLASS(n)::budget();  \
+    if (mockf_budget != NULL) {                                             \
+        ::blet::mockf::StatsSize mockf_budget_size;                         \
+        MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_BUDGET_SIZE_ARG_, f);   \
+        mockf_budget->add(mockf_budget_size.value, mockf_instance != NULL); \
+    }
+
+#define MOCKF_INTERNAL_POLICY_ARG_(b, i, f) mockf_policy_limit.apply(MOCKF_INTERNAL_ARG_(b, i, f))
+#define MOCKF_INTERNAL_POLICY_(i, r, n, f)                                                     \
+    ::blet::mockf::Policy* mockf_policy = MOCKF_CLASS(n)::policy();                            \
+    if (mockf_policy != NULL) {                                                                \
+        ::blet::mockf::Policy::Decision mockf_decision = mockf_policy->evaluate();             \
+        MOCKF_INTERNAL_STATS_POLICY_(n, mockf_decision.isFailure)                              \
+        if (mockf_decision.isFailure) {                                                        \
+            errno = mockf_decision.error;                                                      \
+            return MOCKF_INTERNAL_SHARED_RESULT_(r, ::blet::mockf::PolicyValue<r>::failure()); \
+        }                                                                                      \
+        ::blet::mockf::PolicyLimit mockf_policy_limit(mockf_decision);                         \
+        MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_POLICY_ARG_, f);                           \
+    }
+
+#define MOCKF_INTERNAL_FAKE_FUNC_PROTOTYPE_(i, r, n, f) \
+    r n(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_DECLARATION_, r f))
+
+#define MOCKF_INTERNAL_FAKE_FUNC_IMPL_(i, r, n, f)                                               \
+    {                                                                                            \
+        MOCKF_CLASS(n)* mockf_instance = MOCKF_CLASS(n)::active();                               \
+        MOCKF_INTERNAL_FILTER_(i, n, f)                                                          \
+        MOCKF_INTERNAL_STATS_(i, n, f)                                                           \
+        MOCKF_INTERNAL_SHARED_(i, n, f)                                                          \
+        MOCKF_INTERNAL_TIMELINE_(i, n, f)                                                        \
+        MOCKF_INTERNAL_BUDGET_(i, n, f)                                                          \
+        MOCKF_INTERNAL_POLICY_(i, r, n, f)                                                       \
+        if (mockf_instance != NULL) {                                                            \
+            ::blet::mockf::DepthGuard mockf_depth_guard_##n(MOCKF_CLASS(n)::depth());            \
+            return MOCKF_INTERNAL_SHARED_RESULT_(                                                \
+                r, mockf_instance->n(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_, f)));     \
+        }                                                                                        \
+        return MOCKF_INTERNAL_SHARED_RESULT_(                                                    \
+            r, MOCKF_CLASS(n)::handler()(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_, f))); \
+    }
+
+#define MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_PROTOTYPE_(i, r, n, f)                                                \
+    r n(MOCKF_INTERNAL_REPEAT_(MOCKF_INTERNAL_SUB_(i))(MOCKF_INTERNAL_SUB_(i), MOCKF_INTERNAL_ARG_DECLARATION_, \
+                                                       r MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f),                 \
+        ...)
+
+/* the arguments before '...' of a variadic mock */
+#define MOCKF_INTERNAL_VARIADIC_ARGS_(i, f)                                                     \
+    MOCKF_INTERNAL_REPEAT_(MOCKF_INTERNAL_SUB_(i))(MOCKF_INTERNAL_SUB_(i), MOCKF_INTERNAL_ARG_, \
+                                                   MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)
+#define MOCKF_INTERNAL_VARIADIC_ARG_DECLARATIONS_(i, r, f)                                                  \
+    MOCKF_INTERNAL_REPEAT_(MOCKF_INTERNAL_SUB_(i))(MOCKF_INTERNAL_SUB_(i), MOCKF_INTERNAL_ARG_DECLARATION_, \
+                                                   r MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)
+
+/* the variadic fake and the aliases with a va_list (e.g. fortified) share the call with the va_list */
+#define MOCKF_INTERNAL_VARIADIC_FAKE_(i, r, n, f)                                                                      \
+    namespace blet {                                                                                                   \
+    namespace mockf {                                                                                                  \
+    template<>                                                                                                         \
+    struct VariadicFake<MockF_##n> {                                                                                   \
+        static r call(MOCKF_INTERNAL_VARIADIC_ARG_DECLARATIONS_(i, r, f), va_list args) {                              \
+            return call(Variadic<MockF_##n>(), MOCKF_INTERNAL_VARIADIC_ARGS_(i, f), args);                             \
+        }                                                                                                              \
+        template<typename F>                                                                                           \
+        static r call(const F& forward, MOCKF_INTERNAL_VARIADIC_ARG_DECLARATIONS_(i, r, f), va_list args) {            \
+            MockF_##n* mockf_instance = MockF_##n::active();                                                           \
+            MOCKF_INTERNAL_FILTER_(MOCKF_INTERNAL_SUB_(i), n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                    \
+            MOCKF_INTERNAL_STATS_(MOCKF_INTERNAL_SUB_(i), n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                     \
+            MOCKF_INTERNAL_SHARED_(MOCKF_INTERNAL_SUB_(i), n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                    \
+            MOCKF_INTERNAL_TIMELINE_(MOCKF_INTERNAL_SUB_(i), n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                  \
+            MOCKF_INTERNAL_BUDGET_(MOCKF_INTERNAL_SUB_(i), n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                    \
+            MOCKF_INTERNAL_POLICY_(MOCKF_INTERNAL_SUB_(i), r, n, MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f)                 \
+            if (mockf_instance != NULL) {                                                                              \
+                DepthGuard mockf_depth_guard_##n(MockF_##n::depth());                                                  \
+                return MOCKF_INTERNAL_SHARED_RESULT_(r, mockf_instance->n(MOCKF_INTERNAL_VARIADIC_ARGS_(i, f), args)); \
+            }                                                                                                          \
+            r ret = r();                                                                                               \
+            if (forward.forward(ret, MockF_##n::handler(), MOCKF_INTERNAL_VARIADIC_ARGS_(i, f), args)) {               \
+                return MOCKF_INTERNAL_SHARED_RESULT_(r, ret);                                                          \
+            }                                                                                                          \
+            if (!MockF_##n::isResolved() && !MockF_##n::load()) {                                                      \
+                throw RealFunctionNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n);                         \
+            }                                                                                                          \
+            throw RealVariadicFunctionUsed(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n);                         \
+        }                                                                                                              \
+    };                                                                                                                 \
+    }                                                                                                                  \
+    }
+
+#define MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_IMPL_(i, r, n, f)                                                       \
+    {                                                                                                             \
+        va_list args;                                                                                             \
+        va_start(args, MOCKF_INTERNAL_ARG_(0, MOCKF_INTERNAL_SUB_(i), 0));                                        \
+        try {                                                                                                     \
+            r ret = ::blet::mockf::VariadicFake<MOCKF_CLASS(n)>::call(MOCKF_INTERNAL_VARIADIC_ARGS_(i, f), args); \
+            va_end(args);                                                                                         \
+            return ret;                                                                                           \
+        }                                                                                                         \
+        catch (...) {                                                                                             \
+            va_end(args);                                                                                         \
+            throw;                                                                                                \
+        }                                                                                                         \
+    }
+
+#define MOCKF_INTERNAL_FAKE_FUNC_(i, r, n, f)                                                               \
+    MOCKF_INTERNAL_FAKE_LINKAGE_ MOCKF_INTERNAL_FAKE_FUNC_PROTOTYPE_(i, r, MOCKF_INTERNAL_FAKE_NAME_(n), f) \
+    MOCKF_INTERNAL_FAKE_FUNC_IMPL_(i, r, n, f)
+
+#define MOCKF_INTERNAL_FAKE_ATTRIBUTE_FUNC_(i, r, n, f, a)                                                    \
+    MOCKF_INTERNAL_FAKE_LINKAGE_ MOCKF_INTERNAL_FAKE_FUNC_PROTOTYPE_(i, r, MOCKF_INTERNAL_FAKE_NAME_(n), f) a \
+    MOCKF_INTERNAL_FAKE_FUNC_IMPL_(i, r, n, f)
+
+#define MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_(i, r, n, f)                                                               \
+    MOCKF_INTERNAL_VARIADIC_FAKE_(i, r, n, f)                                                                        \
+    MOCKF_INTERNAL_FAKE_LINKAGE_ MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_PROTOTYPE_(i, r, MOCKF_INTERNAL_FAKE_NAME_(n), f) \
+    MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_IMPL_(i, r, n, f)
+
+#define MOCKF_INTERNAL_FAKE_ATTRIBUTE_VARIADIC_FUNC_(i, r, n, f, a)                                                    \
+    MOCKF_INTERNAL_VARIADIC_FAKE_(i, r, n, f)                                                                          \
+    MOCKF_INTERNAL_FAKE_LINKAGE_ MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_PROTOTYPE_(i, r, MOCKF_INTERNAL_FAKE_NAME_(n), f) a \
+    MOCKF_INTERNAL_FAKE_VARIADIC_FUNC_IMPL_(i, r, n, f)
+
+/* MOCKF_INTERNAL_METHOD_(i, r, n, f) is the method of instance defined by the backend (mockf.h or mockf/stub.h) */
+#define MOCKF_INTERNAL_VARIADIC_METHOD_(i, r, n, f)                                                              \
+    MOCKF_INTERNAL_METHOD_(                                                                                      \
+        i, r, n,                                                                                                 \
+        (MOCKF_INTERNAL_REPEAT_(MOCKF_INTERNAL_SUB_(i))(MOCKF_INTERNAL_SUB_(i), MOCKF_INTERNAL_ARG_DECLARATION_, \
+                                                        r MOCKF_INTERNAL_REMOVE_LAST_ARG_(i) f),                 \
+         va_list))
+
+#ifdef MOCKF_ENABLE_SHARED
+#include "blet/mockf/shared.h"
+#endif
+
+#ifdef MOCKF_ENABLE_TIMELINE
+#include "blet/mockf/timeline.h"
+#endif
+
+#endif // #ifndef BLET_MOCKF_CORE_H_
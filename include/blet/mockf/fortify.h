@@ -0,0 +1,333 @@
+/**
+ * mockf/fortify.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLET_MOCKF_FORTIFY_H_
+#define BLET_MOCKF_FORTIFY_H_
+
+#include <fcntl.h>      // O_CREAT
+#include <poll.h>       // nfds_t, struct pollfd
+#include <stdarg.h>     // va_list, va_start, va_end
+#include <stdio.h>      // FILE
+#include <string.h>     // strlen
+#include <sys/socket.h> // socklen_t, struct sockaddr
+#include <sys/stat.h>   // struct stat
+#include <unistd.h>     // ssize_t
+
+#include "blet/mockf.h"
+
+extern "C" void __chk_fail(void) __attribute__((__noreturn__));
+
+/**
+ * @brief Define the fortified and versioned aliases of a mocked function
+ * At -O2 with _FORTIFY_SOURCE the compiler calls __read_chk, __memcpy_chk, __printf_chk, ... and the older
+ * glibc call __xstat from the inline stat.
+ * The aliases check their bound like the libc (abort by __chk_fail) then call the mock of the public name.
+ * Must be used in only one source file of a binary, at global scope, after the mock of name.
+ * @param name Name of mocked function: read, pread, recv, recvfrom, poll, open, openat, fgets, getcwd,
+ * readlink, memcpy, memmove, memset, strcpy, strncpy, printf, fprintf, dprintf, sprintf, snprintf, stat,
+ * fstat or lstat
+ */
+#define MOCKF_FORTIFY(name) MOCKF_INTERNAL_FORTIFY_##name##_ struct MockFForceSemiColon
+
+/**
+ * @brief Resolve the real function of mock with a version of symbol (dlvsym)
+ * Use it for the symbols without default version (e.g. compat symbol of glibc).
+ * Must be used at global scope, after the definition of mock.
+ * @param name Name of mocked function
+ * @param version Version of symbol (e.g. "GLIBC_2.2.5")
+ */
+#define MOCKF_SYMBOL_VERSION(name, version)                                                  \
+    namespace blet {                                                                         \
+    namespace mockf {                                                                        \
+    static const bool mockf_symbol_version_##name = loadVersion<MOCKF_CLASS(name)>(version); \
+    }                                                                                        \
+    }                                                                                        \
+    struct MockFForceSemiColon
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Load the real function of mock from a version of symbol
+ * @return bool False if the symbol is not found
+ */
+template<typename T>
+inline bool loadVersion(const char* version) {
+    T::version() = version;
+    return T::load();
+}
+
+/**
+ * @brief Use func as real function of mock when the real symbol is not found
+ */
+template<typename T>
+inline bool fallbackReal(typename T::function_t func) {
+    if (T::isResolved()) {
+        return false;
+    }
+    typename T::function_t expected = T::real();
+    __atomic_store_n(&T::realFunction, func, __ATOMIC_RELAXED);
+    __atomic_compare_exchange_n(&T::handlerFunction, &expected, func, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    return true;
+}
+
+} // namespace mockf
+
+} // namespace blet
+
+/* call the symbol of public name (the mock) without the inline fortified wrapper */
+#define MOCKF_INTERNAL_FORTIFY_SYMBOL_(r, name, args) extern "C" r mockf_fortify_##name args __asm__(#name);
+
+#define MOCKF_INTERNAL_FORTIFY_CHECK_(overflow) \
+    if (overflow) {                             \
+        __chk_fail();                           \
+    }
+
+/* call the variadic fake of mock with the va_list (filter, hooks, instance, then handler) */
+#define MOCKF_INTERNAL_FORTIFY_VARIADIC_(name) ::blet::mockf::VariadicFake<MOCKF_CLASS(name)>::call
+
+#define MOCKF_INTERNAL_FORTIFY_read_                                                 \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(ssize_t, read, (int, void*, size_t))              \
+    extern "C" ssize_t __read_chk(int fd, void* buf, size_t nbytes, size_t buflen) { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(nbytes > buflen)                               \
+        return mockf_fortify_read(fd, buf, nbytes);                                  \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_pread_                                                               \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(ssize_t, pread, (int, void*, size_t, off_t))                     \
+    extern "C" ssize_t __pread_chk(int fd, void* buf, size_t nbytes, off_t offset, size_t buflen) { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(nbytes > buflen)                                              \
+        return mockf_fortify_pread(fd, buf, nbytes, offset);                                        \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_recv_                                                       \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(ssize_t, recv, (int, void*, size_t, int))               \
+    extern "C" ssize_t __recv_chk(int fd, void* buf, size_t n, size_t buflen, int flags) { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(n > buflen)                                          \
+        return mockf_fortify_recv(fd, buf, n, flags);                                      \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_recvfrom_                                                                       \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(ssize_t, recvfrom, (int, void*, size_t, int, struct sockaddr*, socklen_t*)) \
+    extern "C" ssize_t __recvfrom_chk(int fd, void* buf, size_t n, size_t buflen, int flags,                   \
+                                      struct sockaddr* addr, socklen_t* addrLen) {                             \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(n > buflen)                                                              \
+        return mockf_fortify_recvfrom(fd, buf, n, flags, addr, addrLen);                                       \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_poll_                                                         \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(int, poll, (struct pollfd*, nfds_t, int))                 \
+    extern "C" int __poll_chk(struct pollfd* fds, nfds_t nfds, int timeout, size_t fdslen) { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(fdslen / sizeof(*fds) < nfds)                          \
+        return mockf_fortify_poll(fds, nfds, timeout);                                       \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_open_                                   \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(int, open, (const char*, int, ...)) \
+    extern "C" int __open_2(const char* path, int flags) {             \
+        MOCKF_INTERNAL_FORTIFY_CHECK_((flags & O_CREAT) != 0)          \
+        return mockf_fortify_open(path, flags);                        \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_openat_                                        \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(int, openat, (int, const char*, int, ...)) \
+    extern "C" int __openat_2(int fd, const char* path, int flags) {          \
+        MOCKF_INTERNAL_FORTIFY_CHECK_((flags & O_CREAT) != 0)                 \
+        return mockf_fortify_openat(fd, path, flags);                         \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_fgets_                                         \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(char*, fgets, (char*, int, FILE*))         \
+    extern "C" char* __fgets_chk(char* buf, size_t size, int n, FILE* file) { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(n > 0 && static_cast<size_t>(n) > size) \
+        return mockf_fortify_fgets(buf, n, file);                             \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_getcwd_                                             \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(char*, getcwd, (char*, size_t))                 \
+    extern "C" char* __getcwd_chk(char* buf, size_t size, size_t buflen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(size > buflen)                               \
+        return mockf_fortify_getcwd(buf, size);                                    \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_readlink_                                                                \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(ssize_t, readlink, (const char*, char*, size_t))                     \
+    extern "C" ssize_t __readlink_chk(const char* path, char* buf, size_t len, size_t buflen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(len > buflen)                                                     \
+        return mockf_fortify_readlink(path, buf, len);                                                  \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_memcpy_                                                               \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(void*, memcpy, (void*, const void*, size_t))                      \
+    extern "C" void* __memcpy_chk(void* dest, const void* src, size_t len, size_t destlen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(len > destlen)                                                 \
+        return mockf_fortify_memcpy(dest, src, len);                                                 \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_memmove_                                                               \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(void*, memmove, (void*, const void*, size_t))                      \
+    extern "C" void* __memmove_chk(void* dest, const void* src, size_t len, size_t destlen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(len > destlen)                                                  \
+        return mockf_fortify_memmove(dest, src, len);                                                 \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_memset_                                                     \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(void*, memset, (void*, int, size_t))                    \
+    extern "C" void* __memset_chk(void* dest, int c, size_t len, size_t destlen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(len > destlen)                                       \
+        return mockf_fortify_memset(dest, c, len);                                         \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_strcpy_                                                   \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(char*, strcpy, (char*, const char*))                  \
+    extern "C" char* __strcpy_chk(char* dest, const char* src, size_t destlen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(strlen(src) >= destlen)                            \
+        return mockf_fortify_strcpy(dest, src);                                          \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_strncpy_                                                             \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(char*, strncpy, (char*, const char*, size_t))                    \
+    extern "C" char* __strncpy_chk(char* dest, const char* src, size_t n, size_t destlen) throw() { \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(n > destlen)                                                  \
+        return mockf_fortify_strncpy(dest, src, n);                                                 \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_printf_                                               \
+    extern "C" int __vprintf_chk(int /* flag */, const char* format, va_list args) { \
+        return MOCKF_INTERNAL_FORTIFY_VARIADIC_(printf)(format, args);               \
+    }                                                                                \
+    extern "C" int __printf_chk(int flag, const char* format, ...) {                 \
+        va_list args;                                                                \
+        va_start(args, format);                                                      \
+        int ret = __vprintf_chk(flag, format, args);                                 \
+        va_end(args);                                                                \
+        return ret;                                                                  \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_fprintf_                                                           \
+    extern "C" int __vfprintf_chk(FILE* file, int /* flag */, const char* format, va_list args) { \
+        return MOCKF_INTERNAL_FORTIFY_VARIADIC_(fprintf)(file, format, args);                     \
+    }                                                                                             \
+    extern "C" int __fprintf_chk(FILE* file, int flag, const char* format, ...) {                 \
+        va_list args;                                                                             \
+        va_start(args, format);                                                                   \
+        int ret = __vfprintf_chk(file, flag, format, args);                                       \
+        va_end(args);                                                                             \
+        return ret;                                                                               \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_dprintf_                                                       \
+    extern "C" int __vdprintf_chk(int fd, int /* flag */, const char* format, va_list args) { \
+        return MOCKF_INTERNAL_FORTIFY_VARIADIC_(dprintf)(fd, format, args);                   \
+    }                                                                                         \
+    extern "C" int __dprintf_chk(int fd, int flag, const char* format, ...) {                 \
+        va_list args;                                                                         \
+        va_start(args, format);                                                               \
+        int ret = __vdprintf_chk(fd, flag, format, args);                                     \
+        va_end(args);                                                                         \
+        return ret;                                                                           \
+    }
+
+/* the real sprintf is bounded by the size of the destination */
+#define MOCKF_INTERNAL_FORTIFY_sprintf_                                                                           \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(int, vsnprintf, (char*, size_t, const char*, va_list))                         \
+    namespace blet {                                                                                              \
+    namespace mockf {                                                                                             \
+    struct FortifySprintf {                                                                                       \
+        explicit FortifySprintf(size_t size_) :                                                                   \
+            size(size_) {}                                                                                        \
+        bool forward(int& ret, Variadic<MockF_sprintf>::function_t handler, char* str, const char* format,        \
+                     va_list args) const {                                                                        \
+            if (Variadic<MockF_sprintf>::vreal(handler) == NULL) {                                                \
+                return false;                                                                                     \
+            }                                                                                                     \
+            ret = mockf_fortify_vsnprintf(str, size, format, args);                                               \
+            MOCKF_INTERNAL_FORTIFY_CHECK_(ret >= 0 && static_cast<size_t>(ret) >= size)                           \
+            return true;                                                                                          \
+        }                                                                                                         \
+        size_t size;                                                                                              \
+    };                                                                                                            \
+    }                                                                                                             \
+    }                                                                                                             \
+    extern "C" int __vsprintf_chk(char* str, int /* flag */, size_t slen, const char* format,                     \
+                                  va_list args) throw() {                                                         \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(slen == 0)                                                                  \
+        return MOCKF_INTERNAL_FORTIFY_VARIADIC_(sprintf)(::blet::mockf::FortifySprintf(slen), str, format, args); \
+    }                                                                                                             \
+    extern "C" int __sprintf_chk(char* str, int flag, size_t slen, const char* format, ...) throw() {             \
+        va_list args;                                                                                             \
+        va_start(args, format);                                                                                   \
+        int ret = __vsprintf_chk(str, flag, slen, format, args);                                                  \
+        va_end(args);                                                                                             \
+        return ret;                                                                                               \
+    }
+
+#define MOCKF_INTERNAL_FORTIFY_snprintf_                                                                      \
+    extern "C" int __vsnprintf_chk(char* str, size_t maxlen, int /* flag */, size_t slen, const char* format, \
+                                   va_list args) throw() {                                                    \
+        MOCKF_INTERNAL_FORTIFY_CHECK_(maxlen > slen)                                                          \
+        return MOCKF_INTERNAL_FORTIFY_VARIADIC_(snprintf)(str, maxlen, format, args);                         \
+    }                                                                                                         \
+    extern "C" int __snprintf_chk(char* str, size_t maxlen, int flag, size_t slen, const char* format,        \
+                                  ...) throw() {                                                              \
+        va_list args;                                                                                         \
+        va_start(args, format);                                                                               \
+        int ret = __vsnprintf_chk(str, maxlen, flag, slen, format, args);                                     \
+        va_end(args);                                                                                         \
+        return ret;                                                                                           \
+    }
+
+/* glibc < 2.33: stat, fstat and lstat are inline wrappers of __xstat, __fxstat and __lxstat */
+#ifdef _STAT_VER
+#define MOCKF_INTERNAL_FORTIFY_XSTAT_REAL_(name, xname, A1)                        \
+    namespace blet {                                                               \
+    namespace mockf {                                                              \
+    static int mockf_fortify_real_##name(A1 a1, struct stat* buf) {                \
+        typedef int (*xstat_t)(int, A1, struct stat*);                             \
+        static xstat_t real = reinterpret_cast<xstat_t>(loadSymbol(#xname, NULL)); \
+        return real(_STAT_VER, a1, buf);                                           \
+    }                                                                              \
+    static const bool mockf_fortify_fallback_##name =                              \
+        fallbackReal<MOCKF_CLASS(name)>(&mockf_fortify_real_##name);               \
+    }                                                                              \
+    }
+#else
+#define MOCKF_INTERNAL_FORTIFY_XSTAT_REAL_(name, xname, A1)
+#endif
+
+#define MOCKF_INTERNAL_FORTIFY_XSTAT_(name, xname, A1)                         \
+    MOCKF_INTERNAL_FORTIFY_SYMBOL_(int, name, (A1, struct stat*))              \
+    extern "C" int xname(int /* version */, A1 a1, struct stat* buf) throw() { \
+        return mockf_fortify_##name(a1, buf);                                  \
+    }                                                                          \
+    MOCKF_INTERNAL_FORTIFY_XSTAT_REAL_(name, xname, A1)
+
+#define MOCKF_INTERNAL_FORTIFY_stat_ MOCKF_INTERNAL_FORTIFY_XSTAT_(stat, __xstat, const char*)
+#define MOCKF_INTERNAL_FORTIFY_fstat_ MOCKF_INTERNAL_FORTIFY_XSTAT_(fstat, __fxstat, int)
+#define MOCKF_INTERNAL_FORTIFY_lstat_ MOCKF_INTERNAL_FORTIFY_XSTAT_(lstat, __lxstat, const char*)
+
+#endif // #ifndef BLET_MOCKF_FORTIFY_H_
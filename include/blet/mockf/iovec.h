@@ -0,0 +1,403 @@
+/**
+ * mockf/iovec.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLET_MOCKF_IOVEC_H_
+#define BLET_MOCKF_IOVEC_H_
+
+#include <stdio.h>      // snprintf
+#include <string.h>     // memcpy, memcmp
+#include <sys/socket.h> // sendmsg, recvmsg
+#include <sys/types.h>  // off_t, ssize_t
+#include <sys/uio.h>    // readv, writev, preadv, pwritev
+
+#include <ostream>
+#include <string>
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Declare the mocks of the vectored functions
+ * Must be used in only one source file of a binary (not with MOCKF_NET_FUNCTIONS: sendmsg and recvmsg)
+ */
+#define MOCKF_IOVEC_FUNCTIONS()                                                                             \
+    MOCKF_FUNCTION3(ssize_t, readv, (int /* fd */, const struct iovec* /* iov */, int /* iovcnt */));       \
+    MOCKF_FUNCTION3(ssize_t, writev, (int /* fd */, const struct iovec* /* iov */, int /* iovcnt */));      \
+    MOCKF_FUNCTION4(ssize_t, preadv,                                                                        \
+                    (int /* fd */, const struct iovec* /* iov */, int /* iovcnt */, off_t /* offset */));   \
+    MOCKF_FUNCTION4(ssize_t, pwritev,                                                                       \
+                    (int /* fd */, const struct iovec* /* iov */, int /* iovcnt */, off_t /* offset */));   \
+    MOCKF_FUNCTION3(ssize_t, sendmsg, (int /* fd */, const struct msghdr* /* message */, int /* flags */)); \
+    MOCKF_FUNCTION3(ssize_t, recvmsg, (int /* fd */, struct msghdr* /* message */, int /* flags */));       \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Select the iovec and the count of iovec of readv, writev, preadv and pwritev for the payload matchers
+ * MOCKF_EXPECT_CALL(writev, (fd, _, _)).With(MOCKF_IOVEC_ARGS(blet::mockf::IovecEq("payload")))
+ */
+#define MOCKF_IOVEC_ARGS(matcher) ::testing::Args<1, 2>(matcher)
+
+/**
+ * @brief Maximum number of bytes of payload printed in the messages of matchers
+ */
+#ifndef MOCKF_IOVEC_PRINT_MAX
+#define MOCKF_IOVEC_PRINT_MAX 64
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief View of the logical payload of iovecs (the segments are not copied)
+ */
+class IovecView {
+  public:
+    IovecView(const struct iovec* iov, int iovcnt) :
+        iov_(iov),
+        iovcnt_(iov == NULL || iovcnt < 0 ? 0 : iovcnt) {}
+
+    explicit IovecView(const struct msghdr* message) :
+        iov_(message == NULL ? NULL : message->msg_iov),
+        iovcnt_(message == NULL || message->msg_iov == NULL ? 0 : static_cast<int>(message->msg_iovlen)) {}
+
+    template<typename A, typename B>
+    explicit IovecView(const ::testing::tuple<A, B>& args) :
+        iov_(::testing::get<0>(args)),
+        iovcnt_(::testing::get<0>(args) == NULL || ::testing::get<1>(args) < 0
+                    ? 0
+                    : static_cast<int>(::testing::get<1>(args))) {}
+
+    /**
+     * @brief Total size of the payload
+     */
+    size_t size() const {
+        size_t size = 0;
+        for (int i = 0; i < iovcnt_; ++i) {
+            size += iov_[i].iov_len;
+        }
+        return size;
+    }
+
+    int count() const {
+        return iovcnt_;
+    }
+
+    /**
+     * @brief Offset of the first difference with data (the common size if the common part is equal)
+     */
+    size_t mismatch(const char* data, size_t size) const {
+        size_t offset = 0;
+        for (int i = 0; i < iovcnt_ && offset < size; ++i) {
+            const char* base = static_cast<const char*>(iov_[i].iov_base);
+            size_t len = iov_[i].iov_len < size - offset ? iov_[i].iov_len : size - offset;
+            if (memcmp(base, data + offset, len) != 0) {
+                for (size_t j = 0; j < len; ++j) {
+                    if (base[j] != data[offset + j]) {
+                        return offset + j;
+                    }
+                }
+            }
+            offset += len;
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Copy data in the iovecs
+     * @return number of bytes copied
+     */
+    size_t scatter(const char* data, size_t size) const {
+        size_t offset = 0;
+        for (int i = 0; i < iovcnt_ && offset < size; ++i) {
+            size_t len = iov_[i].iov_len < size - offset ? iov_[i].iov_len : size - offset;
+            memcpy(iov_[i].iov_base, data + offset, len);
+            offset += len;
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Append the first bytes of payload to out
+     * @return number of bytes appended
+     */
+    size_t gather(std::string* out, size_t max) const {
+        size_t offset = 0;
+        for (int i = 0; i < iovcnt_ && offset < max; ++i) {
+            size_t len = iov_[i].iov_len < max - offset ? iov_[i].iov_len : max - offset;
+            out->append(static_cast<const char*>(iov_[i].iov_base), len);
+            offset += len;
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Payload escaped for a message (truncated at MOCKF_IOVEC_PRINT_MAX bytes)
+     */
+    std::string print() const {
+        std::string payload;
+        gather(&payload, MOCKF_IOVEC_PRINT_MAX);
+        std::string ret = "\"" + escape(payload.data(), payload.size());
+        if (payload.size() < size()) {
+            ret += "\"...";
+        }
+        else {
+            ret += "\"";
+        }
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), " (%lu byte(s) in %d iovec(s))", static_cast<unsigned long>(size()),
+                 iovcnt_);
+        return ret + buffer;
+    }
+
+    static std::string escape(const char* data, size_t size) {
+        std::string ret;
+        for (size_t i = 0; i < size; ++i) {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c == '"' || c == '\\') {
+                ret += '\\';
+                ret += static_cast<char>(c);
+            }
+            else if (c >= 0x20 && c < 0x7f) {
+                ret += static_cast<char>(c);
+            }
+            else {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\x%02x", c);
+                ret += buffer;
+            }
+        }
+        return ret;
+    }
+
+  private:
+    const struct iovec* iov_;
+    int iovcnt_;
+};
+
+/**
+ * @brief Matcher of the payload of iovecs: equal or prefix
+ */
+class IovecPayloadMatcher {
+  public:
+    IovecPayloadMatcher(const std::string& expected, bool isPrefix) :
+        expected_(expected),
+        isPrefix_(isPrefix) {}
+
+    template<typename T>
+    bool MatchAndExplain(const T& value, ::testing::MatchResultListener* listener) const {
+        IovecView view(value);
+        size_t size = view.size();
+        size_t offset = view.mismatch(expected_.data(), expected_.size());
+        *listener << "whose payload is " << view.print();
+        if (offset < expected_.size() && offset < size) {
+            *listener << ", different at offset " << offset;
+            return false;
+        }
+        if (isPrefix_) {
+            return size >= expected_.size();
+        }
+        return size == expected_.size();
+    }
+
+    void DescribeTo(std::ostream* os) const {
+        *os << (isPrefix_ ? "has a payload starting with \"" : "has the payload \"")
+            << IovecView::escape(expected_.data(), expected_.size()) << "\"";
+    }
+
+    void DescribeNegationTo(std::ostream* os) const {
+        *os << (isPrefix_ ? "has not a payload starting with \"" : "has not the payload \"")
+            << IovecView::escape(expected_.data(), expected_.size()) << "\"";
+    }
+
+  private:
+    std::string expected_;
+    bool isPrefix_;
+};
+
+/**
+ * @brief Matcher of the total size of iovecs
+ */
+class IovecSizeMatcher {
+  public:
+    IovecSizeMatcher(const ::testing::Matcher<size_t>& matcher) :
+        matcher_(matcher) {}
+
+    template<typename T>
+    bool MatchAndExplain(const T& value, ::testing::MatchResultListener* listener) const {
+        IovecView view(value);
+        *listener << "whose payload is " << view.print();
+        return matcher_.Matches(view.size());
+    }
+
+    void DescribeTo(std::ostream* os) const {
+        *os << "has a payload whose size ";
+        matcher_.DescribeTo(os);
+    }
+
+    void DescribeNegationTo(std::ostream* os) const {
+        *os << "has a payload whose size ";
+        matcher_.DescribeNegationTo(os);
+    }
+
+  private:
+    ::testing::Matcher<size_t> matcher_;
+};
+
+/**
+ * @brief The payload of iovecs is equal to expected
+ * Argument of sendmsg/recvmsg or MOCKF_IOVEC_ARGS for readv/writev/preadv/pwritev
+ */
+inline ::testing::PolymorphicMatcher<IovecPayloadMatcher> IovecEq(const std::string& expected) {
+    return ::testing::MakePolymorphicMatcher(IovecPayloadMatcher(expected, false));
+}
+
+inline ::testing::PolymorphicMatcher<IovecPayloadMatcher> IovecEq(const void* data, size_t size) {
+    return IovecEq(std::string(static_cast<const char*>(data), size));
+}
+
+/**
+ * @brief The payload of iovecs starts with prefix
+ */
+inline ::testing::PolymorphicMatcher<IovecPayloadMatcher> IovecStartsWith(const std::string& prefix) {
+    return ::testing::MakePolymorphicMatcher(IovecPayloadMatcher(prefix, true));
+}
+
+/**
+ * @brief The total size of iovecs matches (a value or a matcher of size_t)
+ */
+inline ::testing::PolymorphicMatcher<IovecSizeMatcher> IovecSize(const ::testing::Matcher<size_t>& matcher) {
+    return ::testing::MakePolymorphicMatcher(IovecSizeMatcher(matcher));
+}
+
+/**
+ * @brief Action of readv, preadv and recvmsg: copy the next bytes of a fixture in the iovecs
+ * The copies of the action share the position in the fixture, the end of fixture returns 0.
+ */
+class IovecScatterAction {
+  public:
+    IovecScatterAction(const std::string& fixture, size_t chunk) :
+        state_(new State(fixture, chunk)) {}
+    IovecScatterAction(const IovecScatterAction& rhs) :
+        state_(rhs.state_) {
+        ++state_->nbRef;
+    }
+    ~IovecScatterAction() {
+        if (--state_->nbRef == 0) {
+            delete state_;
+        }
+    }
+
+    template<typename Result, typename ArgumentTuple>
+    Result Perform(const ArgumentTuple& args) const {
+        return static_cast<Result>(scatter(view(::testing::get<1>(args), ::testing::get<2>(args))));
+    }
+
+  private:
+    IovecScatterAction& operator=(const IovecScatterAction&); // disable copy
+
+    struct State {
+        State(const std::string& fixture_, size_t chunk_) :
+            fixture(fixture_),
+            chunk(chunk_),
+            offset(0),
+            nbRef(1) {}
+        std::string fixture;
+        size_t chunk;
+        size_t offset;
+        int nbRef;
+    };
+
+    static IovecView view(const struct iovec* iov, int iovcnt) {
+        return IovecView(iov, iovcnt);
+    }
+
+    static IovecView view(const struct msghdr* message, int /* flags */) {
+        return IovecView(message);
+    }
+
+    size_t scatter(const IovecView& view) const {
+        size_t size = state_->fixture.size() - state_->offset;
+        if (size > state_->chunk) {
+            size = state_->chunk;
+        }
+        size = view.scatter(state_->fixture.data() + state_->offset, size);
+        state_->offset += size;
+        return size;
+    }
+
+    State* state_;
+};
+
+/**
+ * @brief Action of writev, pwritev and sendmsg: append the first bytes of payload to out
+ */
+class IovecGatherAction {
+  public:
+    IovecGatherAction(std::string* out, size_t chunk) :
+        out_(out),
+        chunk_(chunk) {}
+
+    template<typename Result, typename ArgumentTuple>
+    Result Perform(const ArgumentTuple& args) const {
+        return static_cast<Result>(view(::testing::get<1>(args), ::testing::get<2>(args)).gather(out_, chunk_));
+    }
+
+  private:
+    static IovecView view(const struct iovec* iov, int iovcnt) {
+        return IovecView(iov, iovcnt);
+    }
+
+    static IovecView view(const struct msghdr* message, int /* flags */) {
+        return IovecView(message);
+    }
+
+    std::string* out_;
+    size_t chunk_;
+};
+
+/**
+ * @brief Scatter a fixture across the iovecs of readv, preadv or recvmsg
+ * @param chunk Maximum of bytes by call (partial completion)
+ */
+inline ::testing::PolymorphicAction<IovecScatterAction> ScatterIovec(const std::string& fixture,
+                                                                     size_t chunk = static_cast<size_t>(-1)) {
+    return ::testing::MakePolymorphicAction(IovecScatterAction(fixture, chunk));
+}
+
+/**
+ * @brief Gather the payload of writev, pwritev or sendmsg in out
+ * @param chunk Maximum of bytes by call (partial completion)
+ */
+inline ::testing::PolymorphicAction<IovecGatherAction> GatherIovec(std::string* out,
+                                                                   size_t chunk = static_cast<size_t>(-1)) {
+    return ::testing::MakePolymorphicAction(IovecGatherAction(out, chunk));
+}
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_IOVEC_H_
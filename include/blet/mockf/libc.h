@@ -0,0 +1,41 @@
+/**
+ * mockf/libc.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_LIBC_H_
+#define BLET_MOCKF_LIBC_H_
+
+#include "blet/mockf.h"
+#include "blet/mockf/libc_functions.h"
+
+#define MOCKF_INTERNAL_LIBC_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_DECLARATION_(i, r, n, f)
+#define MOCKF_INTERNAL_LIBC_ATTRIBUTE_DECLARATION_(i, r, n, f, a) MOCKF_INTERNAL_DECLARATION_(i, r, n, f)
+#define MOCKF_INTERNAL_LIBC_VARIADIC_DECLARATION_(i, r, n, f) MOCKF_INTERNAL_VARIADIC_DECLARATION_(i, r, n, f)
+#define MOCKF_INTERNAL_LIBC_ATTRIBUTE_VARIADIC_DECLARATION_(i, r, n, f, a) \
+    MOCKF_INTERNAL_VARIADIC_DECLARATION_(i, r, n, f)
+
+MOCKF_LIBC_FUNCTIONS(MOCKF_INTERNAL_LIBC_DECLARATION_, MOCKF_INTERNAL_LIBC_ATTRIBUTE_DECLARATION_,
+                     MOCKF_INTERNAL_LIBC_VARIADIC_DECLARATION_, MOCKF_INTERNAL_LIBC_ATTRIBUTE_VARIADIC_DECLARATION_)
+
+#endif // #ifndef BLET_MOCKF_LIBC_H_
@@ -0,0 +1,125 @@
+/**
+ * mockf/libc_functions.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_LIBC_FUNCTIONS_H_
+#define BLET_MOCKF_LIBC_FUNCTIONS_H_
+
+#include <fcntl.h>      // open, openat, creat, fcntl
+#include <netdb.h>      // getaddrinfo, freeaddrinfo
+#include <poll.h>       // poll
+#include <stdio.h>      // fopen, fclose, fread, fwrite, printf
+#include <string.h>     // strlen, strcmp, strncmp, strdup
+#include <sys/ioctl.h>  // ioctl
+#include <sys/select.h> // select
+#include <sys/socket.h> // socket, bind, listen, accept, connect, send, recv
+#include <sys/stat.h>   // stat, fstat, lstat, fstatat, mkdir
+#include <sys/time.h>   // gettimeofday
+#include <time.h>       // time, clock_gettime, nanosleep, localtime_r
+#include <unistd.h>     // read, write, close, lseek, access, unlink
+
+/**
+ * @brief Catalog of the libc mocks of blet_mockf_libc and blet_mockf_preload libraries
+ * FUNCTION(nb_argument, return_type, name, arguments)
+ * ATTRIBUTE_FUNCTION(nb_argument, return_type, name, arguments, attribute)
+ * VARIADIC_FUNCTION(nb_argument, return_type, name, arguments)
+ * VARIADIC_ATTRIBUTE_FUNCTION(nb_argument, return_type, name, arguments, attribute)
+ */
+#define MOCKF_LIBC_FUNCTIONS(FUNCTION, ATTRIBUTE_FUNCTION, VARIADIC_FUNCTION, VARIADIC_ATTRIBUTE_FUNCTION) \
+    /* file */                                                                                             \
+    VARIADIC_FUNCTION(3, int, open, (const char*, int, ...))                                               \
+    VARIADIC_FUNCTION(4, int, openat, (int, const char*, int, ...))                                        \
+    FUNCTION(2, int, creat, (const char*, mode_t))                                                         \
+    FUNCTION(1, int, close, (int))                                                                         \
+    FUNCTION(3, ssize_t, read, (int, void*, size_t))                                                       \
+    FUNCTION(3, ssize_t, write, (int, const void*, size_t))                                                \
+    FUNCTION(4, ssize_t, pread, (int, void*, size_t, off_t))                                               \
+    FUNCTION(4, ssize_t, pwrite, (int, const void*, size_t, off_t))                                        \
+    ATTRIBUTE_FUNCTION(3, off_t, lseek, (int, off_t, int), throw())                                        \
+    FUNCTION(1, int, fsync, (int))                                                                         \
+    ATTRIBUTE_FUNCTION(2, int, ftruncate, (int, off_t), throw())                                           \
+    ATTRIBUTE_FUNCTION(2, int, truncate, (const char*, off_t), throw())                                    \
+    ATTRIBUTE_FUNCTION(1, int, dup, (int), throw())                                                        \
+    ATTRIBUTE_FUNCTION(2, int, dup2, (int, int), throw())                                                  \
+    ATTRIBUTE_FUNCTION(1, int, pipe, (int*), throw())                                                      \
+    VARIADIC_FUNCTION(3, int, fcntl, (int, int, ...))                                                      \
+    VARIADIC_ATTRIBUTE_FUNCTION(3, int, ioctl, (int, unsigned long int, ...), throw())                     \
+    ATTRIBUTE_FUNCTION(2, int, access, (const char*, int), throw())                                        \
+    ATTRIBUTE_FUNCTION(1, int, unlink, (const char*), throw())                                             \
+    ATTRIBUTE_FUNCTION(2, int, rename, (const char*, const char*), throw())                                \
+    ATTRIBUTE_FUNCTION(2, int, mkdir, (const char*, mode_t), throw())                                      \
+    ATTRIBUTE_FUNCTION(1, int, rmdir, (const char*), throw())                                              \
+    ATTRIBUTE_FUNCTION(1, int, chdir, (const char*), throw())                                              \
+    ATTRIBUTE_FUNCTION(2, char*, getcwd, (char*, size_t), throw())                                         \
+    /* stat */                                                                                             \
+    ATTRIBUTE_FUNCTION(2, int, stat, (const char*, struct stat*), throw())                                 \
+    ATTRIBUTE_FUNCTION(2, int, fstat, (int, struct stat*), throw())                                        \
+    ATTRIBUTE_FUNCTION(2, int, lstat, (const char*, struct stat*), throw())                                \
+    ATTRIBUTE_FUNCTION(4, int, fstatat, (int, const char*, struct stat*, int), throw())                    \
+    /* string */                                                                                           \
+    ATTRIBUTE_FUNCTION(1, size_t, strlen, (const char*), throw())                                          \
+    ATTRIBUTE_FUNCTION(2, int, strcmp, (const char*, const char*), throw())                                \
+    ATTRIBUTE_FUNCTION(3, int, strncmp, (const char*, const char*, size_t), throw())                       \
+    ATTRIBUTE_FUNCTION(1, char*, strdup, (const char*), throw())                                           \
+    /* stdio */                                                                                            \
+    FUNCTION(2, FILE*, fopen, (const char*, const char*))                                                  \
+    FUNCTION(1, int, fclose, (FILE*))                                                                      \
+    FUNCTION(4, size_t, fread, (void*, size_t, size_t, FILE*))                                             \
+    FUNCTION(4, size_t, fwrite, (const void*, size_t, size_t, FILE*))                                      \
+    FUNCTION(3, char*, fgets, (char*, int, FILE*))                                                         \
+    FUNCTION(2, int, fputs, (const char*, FILE*))                                                          \
+    FUNCTION(1, int, fflush, (FILE*))                                                                      \
+    FUNCTION(3, int, fseek, (FILE*, long, int))                                                            \
+    FUNCTION(1, long, ftell, (FILE*))                                                                      \
+    ATTRIBUTE_FUNCTION(1, int, fileno, (FILE*), throw())                                                   \
+    VARIADIC_FUNCTION(2, int, printf, (const char*, ...))                                                  \
+    VARIADIC_FUNCTION(3, int, fprintf, (FILE*, const char*, ...))                                          \
+    VARIADIC_ATTRIBUTE_FUNCTION(4, int, snprintf, (char*, size_t, const char*, ...), throw())              \
+    /* time */                                                                                             \
+    ATTRIBUTE_FUNCTION(1, time_t, time, (time_t*), throw())                                                \
+    ATTRIBUTE_FUNCTION(2, int, clock_gettime, (clockid_t, struct timespec*), throw())                      \
+    ATTRIBUTE_FUNCTION(2, int, gettimeofday, (struct timeval*, void*), throw())                            \
+    FUNCTION(2, int, nanosleep, (const struct timespec*, struct timespec*))                                \
+    FUNCTION(1, unsigned int, sleep, (unsigned int))                                                       \
+    FUNCTION(1, int, usleep, (useconds_t))                                                                 \
+    ATTRIBUTE_FUNCTION(2, struct tm*, localtime_r, (const time_t*, struct tm*), throw())                   \
+    /* socket */                                                                                           \
+    ATTRIBUTE_FUNCTION(3, int, socket, (int, int, int), throw())                                           \
+    ATTRIBUTE_FUNCTION(3, int, bind, (int, const struct sockaddr*, socklen_t), throw())                    \
+    ATTRIBUTE_FUNCTION(2, int, listen, (int, int), throw())                                                \
+    FUNCTION(3, int, accept, (int, struct sockaddr*, socklen_t*))                                          \
+    FUNCTION(3, int, connect, (int, const struct sockaddr*, socklen_t))                                    \
+    FUNCTION(4, ssize_t, send, (int, const void*, size_t, int))                                            \
+    FUNCTION(4, ssize_t, recv, (int, void*, size_t, int))                                                  \
+    FUNCTION(6, ssize_t, sendto, (int, const void*, size_t, int, const struct sockaddr*, socklen_t))       \
+    FUNCTION(6, ssize_t, recvfrom, (int, void*, size_t, int, struct sockaddr*, socklen_t*))                \
+    ATTRIBUTE_FUNCTION(5, int, setsockopt, (int, int, int, const void*, socklen_t), throw())               \
+    ATTRIBUTE_FUNCTION(5, int, getsockopt, (int, int, int, void*, socklen_t*), throw())                    \
+    ATTRIBUTE_FUNCTION(2, int, shutdown, (int, int), throw())                                              \
+    FUNCTION(4, int, getaddrinfo, (const char*, const char*, const struct addrinfo*, struct addrinfo**))   \
+    ATTRIBUTE_FUNCTION(1, void, freeaddrinfo, (struct addrinfo*), throw())                                 \
+    FUNCTION(3, int, poll, (struct pollfd*, nfds_t, int))                                                  \
+    FUNCTION(5, int, select, (int, fd_set*, fd_set*, fd_set*, struct timeval*))
+
+#endif // #ifndef BLET_MOCKF_LIBC_FUNCTIONS_H_
@@ -0,0 +1,2013 @@
+/**
+ * mockf/net.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLET_MOCKF_NET_H_
+#define BLET_MOCKF_NET_H_
+
+#include <errno.h>      // errno
+#include <fcntl.h>      // fcntl, O_NONBLOCK
+#include <netinet/in.h> // sockaddr_in, sockaddr_in6
+#include <poll.h>       // poll
+#include <pthread.h>    // pthread_mutex_t, pthread_cond_t
+#include <stdarg.h>     // va_list
+#include <stddef.h>     // offsetof
+#include <stdint.h>     // uint64_t
+#include <string.h>     // memcpy, memset
+#include <sys/epoll.h>  // epoll_create1, epoll_ctl, epoll_wait
+#include <sys/socket.h> // socket, bind, listen, accept, connect, send, recv
+#include <sys/uio.h>    // iovec
+#include <sys/un.h>     // sockaddr_un
+#include <unistd.h>     // read, write, close
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Declare the mocks of the socket functions with the simulated network as handler
+ * Must be used in only one source file of a binary (not with MOCKF_VFS_FUNCTIONS: close, read and write)
+ */
+#define MOCKF_NET_FUNCTIONS()                                                                                          \
+    MOCKF_ATTRIBUTE_FUNCTION3(int, socket, (int /* domain */, int /* type */, int /* protocol */), throw());           \
+    MOCKF_ATTRIBUTE_FUNCTION3(int, bind, (int /* fd */, const struct sockaddr* /* addr */, socklen_t /* len */),       \
+                              throw());                                                                                \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, listen, (int /* fd */, int /* n */), throw());                                      \
+    MOCKF_FUNCTION3(int, accept, (int /* fd */, struct sockaddr* /* addr */, socklen_t* /* len */));                   \
+    MOCKF_FUNCTION4(int, accept4, (int /* fd */, struct sockaddr* /* addr */, socklen_t* /* len */, int /* flags */)); \
+    MOCKF_FUNCTION3(int, connect, (int /* fd */, const struct sockaddr* /* addr */, socklen_t /* len */));             \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, shutdown, (int /* fd */, int /* how */), throw());                                  \
+    MOCKF_ATTRIBUTE_FUNCTION5(int, setsockopt,                                                                         \
+                              (int /* fd */, int /* level */, int /* optname */, const void* /* optval */,             \
+                               socklen_t /* optlen */),                                                                \
+                              throw());                                                                                \
+    MOCKF_ATTRIBUTE_FUNCTION5(                                                                                         \
+        int, getsockopt,                                                                                               \
+        (int /* fd */, int /* level */, int /* optname */, void* /* optval */, socklen_t* /* optlen */), throw());     \
+    MOCKF_ATTRIBUTE_FUNCTION3(int, getsockname, (int /* fd */, struct sockaddr* /* addr */, socklen_t* /* len */),     \
+                              throw());                                                                                \
+    MOCKF_ATTRIBUTE_FUNCTION3(int, getpeername, (int /* fd */, struct sockaddr* /* addr */, socklen_t* /* len */),     \
+                              throw());                                                                                \
+    MOCKF_FUNCTION4(ssize_t, send, (int /* fd */, const void* /* buf */, size_t /* n */, int /* flags */));            \
+    MOCKF_FUNCTION4(ssize_t, recv, (int /* fd */, void* /* buf */, size_t /* n */, int /* flags */));                  \
+    MOCKF_FUNCTION3(ssize_t, sendmsg, (int /* fd */, const struct msghdr* /* message */, int /* flags */));            \
+    MOCKF_FUNCTION3(ssize_t, recvmsg, (int /* fd */, struct msghdr* /* message */, int /* flags */));                  \
+    MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));                              \
+    MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* n */));                            \
+    MOCKF_FUNCTION1(int, close, (int /* fd */));                                                                       \
+    MOCKF_VARIADIC_FUNCTION3(int, fcntl, (int /* fd */, int /* cmd */, ...));                                          \
+    MOCKF_FUNCTION3(int, poll, (struct pollfd* /* fds */, nfds_t /* nfds */, int /* timeout */));                      \
+    MOCKF_ATTRIBUTE_FUNCTION1(int, epoll_create1, (int /* flags */), throw());                                         \
+    MOCKF_ATTRIBUTE_FUNCTION4(int, epoll_ctl,                                                                          \
+                              (int /* epfd */, int /* op */, int /* fd */, struct epoll_event* /* event */),           \
+                              throw());                                                                                \
+    MOCKF_FUNCTION4(int, epoll_wait,                                                                                   \
+                    (int /* epfd */, struct epoll_event* /* events */, int /* maxevents */, int /* timeout */));       \
+    namespace blet {                                                                                                   \
+    namespace mockf {                                                                                                  \
+    static const NetHandlers<MockF_socket, MockF_bind, MockF_listen, MockF_accept, MockF_accept4, MockF_connect,       \
+                             MockF_shutdown, MockF_setsockopt, MockF_getsockopt, MockF_getsockname,                    \
+                             MockF_getpeername, MockF_send, MockF_recv, MockF_sendmsg, MockF_recvmsg, MockF_read,      \
+                             MockF_write, MockF_close, MockF_fcntl, MockF_poll, MockF_epoll_create1, MockF_epoll_ctl,  \
+                             MockF_epoll_wait>                                                                         \
+        mockf_net_handlers;                                                                                            \
+    }                                                                                                                  \
+    }                                                                                                                  \
+    struct MockFForceSemiColon
+
+/**
+ * @brief First file descriptor of the simulated network (below the file descriptors of the virtual filesystem)
+ */
+#ifndef MOCKF_NET_FD_BASE
+#define MOCKF_NET_FD_BASE (1 << 29)
+#endif
+
+/**
+ * @brief Maximum number of bytes in flight by direction of a connection (the send returns EAGAIN when full)
+ */
+#ifndef MOCKF_NET_BUFFER_SIZE
+#define MOCKF_NET_BUFFER_SIZE 65536
+#endif
+
+/**
+ * @brief First port given to a socket without address
+ */
+#ifndef MOCKF_NET_EPHEMERAL_PORT
+#define MOCKF_NET_EPHEMERAL_PORT 32768
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Model of a link: each send is a segment delivered after its transmission and the latency
+ * A lost segment is delivered after a retransmission (the order of the stream is kept)
+ */
+struct NetLink {
+    NetLink(uint64_t bandwidth_ = 0, uint64_t latencyNs_ = 0, double loss_ = 0.0,
+            uint64_t retransmitNs_ = 200000000u) :
+        bandwidth(bandwidth_),
+        latencyNs(latencyNs_),
+        loss(loss_),
+        retransmitNs(retransmitNs_) {}
+    uint64_t bandwidth;    // bytes by second (0: unlimited)
+    uint64_t latencyNs;    // one way latency
+    double loss;           // probability of loss of a segment
+    uint64_t retransmitNs; // delay of a lost segment
+};
+
+/**
+ * @brief One direction of a connection: ring buffer of bytes and delivery time of segments
+ */
+class NetPipe {
+  public:
+    NetPipe(const NetLink& link, uint64_t seed) :
+        isWriterClosed(false),
+        isReaderClosed(false),
+        isReaderShut(false),
+        link_(link),
+        seed_(seed),
+        nbSegment_(0),
+        nbLost_(0),
+        read_(0),
+        delivered_(0),
+        written_(0),
+        nextFree_(0) {}
+
+    void setLink(const NetLink& link) {
+        link_ = link;
+    }
+
+    /**
+     * @brief Deliver the segments arrived at now
+     */
+    void update(uint64_t now) {
+        while (!segments_.empty() && segments_.front().deliverAt <= now) {
+            delivered_ = segments_.front().end;
+            segments_.pop_front();
+        }
+    }
+
+    /**
+     * @brief Time of the next delivery (0: nothing in flight)
+     */
+    uint64_t nextDelivery() const {
+        return segments_.empty() ? 0 : segments_.front().deliverAt;
+    }
+
+    size_t readable() const {
+        return static_cast<size_t>(delivered_ - read_);
+    }
+
+    size_t writable() const {
+        return MOCKF_NET_BUFFER_SIZE - static_cast<size_t>(written_ - read_);
+    }
+
+    // the writer is closed and all bytes are read
+    bool isEof() const {
+        return isWriterClosed && read_ == written_;
+    }
+
+    // counter of events for the edge triggered epoll
+    uint64_t sequence() const {
+        return delivered_ + read_;
+    }
+
+    uint64_t nbLost() const {
+        return nbLost_;
+    }
+
+    /**
+     * @brief Write a segment from the iovecs after skip bytes
+     * @return number of bytes written (limited by writable)
+     */
+    size_t write(const struct iovec* iov, int iovcnt, size_t skip, uint64_t now) {
+        size_t size = 0;
+        for (int i = 0; i < iovcnt && writable() > 0; ++i) {
+            size_t len = iov[i].iov_len;
+            if (skip >= len) {
+                skip -= len;
+                continue;
+            }
+            len -= skip;
+            if (len > writable()) {
+                len = writable();
+            }
+            reserve(static_cast<size_t>(written_ - read_) + len);
+            copy(written_, static_cast<const char*>(iov[i].iov_base) + skip, len, true);
+            written_ += len;
+            size += len;
+            skip = 0;
+        }
+        if (size > 0) {
+            schedule(size, now);
+        }
+        return size;
+    }
+
+    /**
+     * @brief Read the delivered bytes in the iovecs
+     * @return number of bytes read
+     */
+    size_t read(const struct iovec* iov, int iovcnt, bool isPeek) {
+        uint64_t position = read_;
+        for (int i = 0; i < iovcnt && position < delivered_; ++i) {
+            size_t len = iov[i].iov_len;
+            if (len > static_cast<size_t>(delivered_ - position)) {
+                len = static_cast<size_t>(delivered_ - position);
+            }
+            copy(position, static_cast<char*>(iov[i].iov_base), len, false);
+            position += len;
+        }
+        size_t size = static_cast<size_t>(position - read_);
+        if (!isPeek) {
+            read_ = position;
+        }
+        return size;
+    }
+
+  private:
+    struct Segment {
+        uint64_t end;
+        uint64_t deliverAt;
+    };
+
+    // copy between the ring at a position and a buffer
+    void copy(uint64_t position, const char* data, size_t len, bool isWrite) {
+        while (len > 0) {
+            size_t offset = static_cast<size_t>(position % ring_.size());
+            size_t size = ring_.size() - offset < len ? ring_.size() - offset : len;
+            if (isWrite) {
+                memcpy(&ring_[offset], data, size);
+            }
+            else {
+                memcpy(const_cast<char*>(data), &ring_[offset], size);
+            }
+            position += size;
+            data += size;
+            len -= size;
+        }
+    }
+
+    // grow the ring (by power of 2) up to the size of buffer
+    void reserve(size_t size) {
+        if (size <= ring_.size()) {
+            return;
+        }
+        size_t capacity = ring_.empty() ? 4096 : ring_.size();
+        while (capacity < size) {
+            capacity *= 2;
+        }
+        if (capacity > MOCKF_NET_BUFFER_SIZE) {
+            capacity = MOCKF_NET_BUFFER_SIZE;
+        }
+        std::vector<char> ring(capacity);
+        for (uint64_t i = read_; i < written_; ++i) {
+            ring[static_cast<size_t>(i % capacity)] = ring_[static_cast<size_t>(i % ring_.size())];
+        }
+        ring_.swap(ring);
+    }
+
+    void schedule(size_t size, uint64_t now) {
+        uint64_t start = nextFree_ > now ? nextFree_ : now;
+        nextFree_ = start;
+        if (link_.bandwidth > 0) {
+            nextFree_ += static_cast<uint64_t>(size) * 1000000000u / link_.bandwidth;
+        }
+        uint64_t deliverAt = nextFree_ + link_.latencyNs;
+        if (link_.loss > 0.0 && draw() < link_.loss) {
+            deliverAt += link_.retransmitNs;
+            ++nbLost_;
+        }
+        if (!segments_.empty() && deliverAt < segments_.back().deliverAt) {
+            deliverAt = segments_.back().deliverAt;
+        }
+        if (deliverAt <= now && segments_.empty()) {
+            delivered_ = written_;
+            return;
+        }
+        Segment segment;
+        segment.end = written_;
+        segment.deliverAt = deliverAt;
+        segments_.push_back(segment);
+    }
+
+    // splitmix64 of the number of segment
+    double draw() {
+        uint64_t z = seed_ + (++nbSegment_) * 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z = z ^ (z >> 31);
+        return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+  public:
+    bool isWriterClosed;
+    bool isReaderClosed;
+    bool isReaderShut; // shutdown of the read side (the writer can send)
+
+  private:
+    NetLink link_;
+    uint64_t seed_;
+    uint64_t nbSegment_;
+    uint64_t nbLost_;
+    uint64_t read_;      // bytes read
+    uint64_t delivered_; // bytes readable
+    uint64_t written_;   // bytes written
+    uint64_t nextFree_;  // end of the transmission of the last segment
+    std::deque<Segment> segments_;
+    std::vector<char> ring_;
+};
+
+/**
+ * @brief Condition of the monotonic clock
+ */
+class NetCondition {
+  public:
+    NetCondition() {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&cond_, &attr);
+        pthread_condattr_destroy(&attr);
+    }
+
+    ~NetCondition() {
+        pthread_cond_destroy(&cond_);
+    }
+
+    /**
+     * @brief Wait a broadcast or the time (0: no time)
+     */
+    void wait(pthread_mutex_t& mutex, uint64_t time) {
+        if (time == 0) {
+            pthread_cond_wait(&cond_, &mutex);
+            return;
+        }
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(time / 1000000000u);
+        ts.tv_nsec = static_cast<long>(time % 1000000000u);
+        pthread_cond_timedwait(&cond_, &mutex, &ts);
+    }
+
+    void broadcast() {
+        pthread_cond_broadcast(&cond_);
+    }
+
+  private:
+    NetCondition(const NetCondition&);            // disable copy
+    NetCondition& operator=(const NetCondition&); // disable copy
+
+    pthread_cond_t cond_;
+};
+
+struct NetEpoll;
+
+/**
+ * @brief Epoll to notify at a change of a connection
+ */
+struct NetWatcher {
+    NetEpoll* epoll;
+    int fd;
+};
+
+/**
+ * @brief Connection between a client and a server (deleted after the close of both sides and the end of the calls)
+ * The lock of a connection protects its pipes and its watchers, the send and the recv wait on its condition.
+ */
+struct NetConnection {
+    NetConnection(const NetLink& link, uint64_t seed) :
+        toServer(link, seed),
+        toClient(link, ~seed),
+        nbRef(2) {
+        pthread_mutex_init(&mutex, NULL);
+    }
+    ~NetConnection() {
+        pthread_mutex_destroy(&mutex);
+    }
+    NetPipe toServer;
+    NetPipe toClient;
+    std::string client;
+    std::string server;
+    std::vector<NetWatcher> watchers;
+    pthread_mutex_t mutex;
+    NetCondition cond;
+    int nbRef; // sockets and calls
+
+  private:
+    NetConnection(const NetConnection&);            // disable copy
+    NetConnection& operator=(const NetConnection&); // disable copy
+};
+
+/**
+ * @brief Registration of a file descriptor in a simulated epoll
+ */
+struct NetInterest {
+    struct epoll_event event;
+    uint32_t lastEvents;
+    uint64_t sequence;
+    uint64_t wakeAt; // time of the timer (0: no timer)
+    bool isDisabled;
+    bool isQueued;
+};
+
+/**
+ * @brief Simulated epoll: a change of a watched socket queues its file descriptor in the ready queue
+ * The interests are changed with the locks of the network and of the epoll, their states with the lock of the epoll.
+ */
+struct NetEpoll {
+    NetEpoll() :
+        realEpoll(-1),
+        isClosed(false),
+        nbRef(1) {
+        pthread_mutex_init(&mutex, NULL);
+    }
+    ~NetEpoll() {
+        pthread_mutex_destroy(&mutex);
+    }
+
+    /**
+     * @brief Queue a file descriptor to check at the next wait (locked)
+     */
+    void queue(int fd) {
+        std::map<int, NetInterest>::iterator it = interests.find(fd);
+        if (it != interests.end() && !it->second.isQueued) {
+            it->second.isQueued = true;
+            ready.push_back(fd);
+            cond.broadcast();
+        }
+    }
+
+    pthread_mutex_t mutex;
+    NetCondition cond;
+    std::map<int, NetInterest> interests;
+    std::deque<int> ready;               // file descriptors to check
+    std::multimap<uint64_t, int> timers; // file descriptors to check at the delivery of a segment
+    int realEpoll;                       // epoll of the real file descriptors
+    bool isClosed;
+    int nbRef; // socket and calls
+
+  private:
+    NetEpoll(const NetEpoll&);            // disable copy
+    NetEpoll& operator=(const NetEpoll&); // disable copy
+};
+
+/**
+ * @brief Socket, listener or epoll of the simulated network
+ */
+struct NetSocket {
+    enum Type {
+        STREAM,
+        LISTENER,
+        EPOLL
+    };
+    NetSocket(Type type_, int domain_) :
+        type(type_),
+        domain(domain_),
+        isNonBlock(false),
+        fdFlags(0),
+        connection(NULL),
+        isClient(false),
+        backlog(0),
+        nbIncoming(0),
+        epoll(NULL) {}
+    Type type;
+    int domain;
+    bool isNonBlock;
+    int fdFlags;
+    std::string local; // bytes of sockaddr
+    // stream
+    NetConnection* connection;
+    bool isClient;
+    // listener
+    int backlog;
+    uint64_t nbIncoming;
+    std::deque<NetConnection*> pending;
+    // epoll
+    NetEpoll* epoll;
+    // epolls of the socket
+    std::vector<NetEpoll*> epolls;
+};
+
+/**
+ * @brief In-memory stream sockets (AF_INET, AF_INET6, AF_UNIX) with a model of link by listener
+ * The functions have the same behavior of the syscall (return -1 and set errno on error)
+ * The lock of the network protects the table of sockets and the listeners, a call on a connection only takes the lock
+ * of its connection and wakes the waiters of this connection and of its epolls.
+ * Order of the locks: network, connection, epoll.
+ */
+class Net {
+  public:
+    typedef int (*poll_t)(struct pollfd*, nfds_t, int);
+    typedef int (*epoll_create1_t)(int);
+    typedef int (*epoll_ctl_t)(int, int, int, struct epoll_event*);
+    typedef int (*epoll_wait_t)(int, struct epoll_event*, int, int);
+
+    /**
+     * @param seed Seed of the losses
+     * @throw blet::mockf::Net::NetAlreadyExists if another simulated network exists
+     */
+    Net(uint64_t seed = 0) :
+        seed_(seed),
+        nextPort_(MOCKF_NET_EPHEMERAL_PORT),
+        nbConnection_(0),
+        nbLost_(0),
+        bytes_(0) {
+        pthread_mutex_init(&mutex_, NULL);
+        Net* expected = NULL;
+        if (!__atomic_compare_exchange_n(&instance(), &expected, this, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            pthread_mutex_destroy(&mutex_);
+            throw NetAlreadyExists(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), "net");
+        }
+    }
+
+    ~Net() {
+        __atomic_store_n(&instance(), static_cast<Net*>(NULL), __ATOMIC_RELEASE);
+        for (std::size_t i = 0; i < sockets_.size(); ++i) {
+            if (sockets_[i] != NULL) {
+                int realEpoll = -1;
+                close(static_cast<int>(MOCKF_NET_FD_BASE + i), &realEpoll);
+                if (realEpoll >= 0) {
+                    ::close(realEpoll); // the instance is NULL: real close
+                }
+            }
+        }
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    static Net*& instance() {
+        static Net* singleton = NULL;
+        return singleton;
+    }
+
+    struct NetAlreadyExists : public Exception {
+        NetAlreadyExists(const char* file, const char* line, const char* name) throw() :
+            Exception(file, line, name) {
+            message_ += "simulated network already exists.";
+        }
+    };
+
+    /**
+     * @brief Check if the file descriptor is a file descriptor of the simulated network
+     */
+    static bool isFd(int fd) {
+        return fd >= MOCKF_NET_FD_BASE && fd < (MOCKF_NET_FD_BASE << 1);
+    }
+
+    /**
+     * @brief Check if the socket is simulated (stream of AF_INET, AF_INET6 or AF_UNIX)
+     */
+    static bool isSocket(int domain, int type) {
+        return (domain == AF_INET || domain == AF_INET6 || domain == AF_UNIX) &&
+               (type & ~(SOCK_NONBLOCK | SOCK_CLOEXEC)) == SOCK_STREAM;
+    }
+
+    /**
+     * @brief Model of the new connections to a listener address
+     */
+    void setLink(const struct sockaddr* addr, socklen_t len, const NetLink& link) {
+        Lock lock(mutex_);
+        links_[key(std::string(reinterpret_cast<const char*>(addr), len), false)] = link;
+    }
+
+    /**
+     * @brief Model of the new connections without link of address
+     */
+    void setDefaultLink(const NetLink& link) {
+        Lock lock(mutex_);
+        defaultLink_ = link;
+    }
+
+    /**
+     * @brief Model of an established connection (both directions)
+     * @return false if fd is not a connected socket
+     */
+    bool setLink(int fd, const NetLink& link) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL || sock->connection == NULL) {
+            return false;
+        }
+        Lock connectionLock(sock->connection->mutex);
+        sock->connection->toServer.setLink(link);
+        sock->connection->toClient.setLink(link);
+        return true;
+    }
+
+    /**
+     * @brief Number of accepted connects
+     */
+    uint64_t nbConnection() const {
+        Lock lock(mutex_);
+        return nbConnection_;
+    }
+
+    /**
+     * @brief Number of lost segments of the closed connections and the opened sockets
+     */
+    uint64_t nbLost() const {
+        Lock lock(mutex_);
+        uint64_t nbLost = __atomic_load_n(&nbLost_, __ATOMIC_RELAXED);
+        for (std::size_t i = 0; i < sockets_.size(); ++i) {
+            if (sockets_[i] != NULL && sockets_[i]->connection != NULL) {
+                Lock connectionLock(sockets_[i]->connection->mutex);
+                nbLost += output(sockets_[i]).nbLost();
+            }
+        }
+        return nbLost;
+    }
+
+    /**
+     * @brief Number of sent bytes
+     */
+    uint64_t bytes() const {
+        return __atomic_load_n(&bytes_, __ATOMIC_RELAXED);
+    }
+
+    int socket(int domain, int type) {
+        Lock lock(mutex_);
+        NetSocket* sock = new NetSocket(NetSocket::STREAM, domain);
+        sock->isNonBlock = (type & SOCK_NONBLOCK) != 0;
+        sock->fdFlags = (type & SOCK_CLOEXEC) != 0 ? FD_CLOEXEC : 0;
+        return add(sock);
+    }
+
+    int bind(int fd, const struct sockaddr* addr, socklen_t len) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (sock->type != NetSocket::STREAM || !sock->local.empty()) {
+            return error(EINVAL);
+        }
+        if (addr == NULL || len < sizeof(sa_family_t) || addr->sa_family != sock->domain) {
+            return error(EINVAL);
+        }
+        std::string local(reinterpret_cast<const char*>(addr), len);
+        if (!isEphemeral(local) && bound_.find(key(local, false)) != bound_.end()) {
+            return error(EADDRINUSE);
+        }
+        setLocal(sock, local);
+        return 0;
+    }
+
+    int listen(int fd, int backlog) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (sock->type == NetSocket::LISTENER) {
+            sock->backlog = backlog > 0 ? backlog : 1;
+            cond_.broadcast();
+            return 0;
+        }
+        if (sock->type != NetSocket::STREAM || sock->connection != NULL) {
+            return error(EINVAL);
+        }
+        if (sock->local.empty()) {
+            setLocal(sock, anyAddress(sock->domain));
+        }
+        sock->type = NetSocket::LISTENER;
+        sock->backlog = backlog > 0 ? backlog : 1;
+        listeners_[key(sock->local, false)] = fd;
+        notify(sock, fd);
+        return 0;
+    }
+
+    int accept(int fd, struct sockaddr* addr, socklen_t* len, int flags) {
+        Lock lock(mutex_);
+        for (;;) {
+            NetSocket* sock = find(fd);
+            if (sock == NULL) {
+                return error(EBADF);
+            }
+            if (sock->type != NetSocket::LISTENER) {
+                return error(EINVAL);
+            }
+            if (!sock->pending.empty()) {
+                NetConnection* connection = sock->pending.front();
+                sock->pending.pop_front();
+                NetSocket* accepted = new NetSocket(NetSocket::STREAM, sock->domain);
+                accepted->isNonBlock = (flags & SOCK_NONBLOCK) != 0;
+                accepted->fdFlags = (flags & SOCK_CLOEXEC) != 0 ? FD_CLOEXEC : 0;
+                accepted->local = connection->server;
+                accepted->connection = connection;
+                copyAddress(connection->client, addr, len);
+                cond_.broadcast();
+                return add(accepted);
+            }
+            if (sock->isNonBlock) {
+                return error(EAGAIN);
+            }
+            cond_.wait(mutex_, 0);
+        }
+    }
+
+    /**
+     * @brief Connect to a listener (established without handshake)
+     * The connect of a nonblocking socket returns EAGAIN if the backlog is full
+     */
+    int connect(int fd, const struct sockaddr* addr, socklen_t len) {
+        Lock lock(mutex_);
+        for (;;) {
+            NetSocket* sock = find(fd);
+            if (sock == NULL) {
+                return error(EBADF);
+            }
+            if (sock->type != NetSocket::STREAM) {
+                return error(EINVAL);
+            }
+            if (sock->connection != NULL) {
+                return error(EISCONN);
+            }
+            if (addr == NULL || len < sizeof(sa_family_t)) {
+                return error(EINVAL);
+            }
+            if (addr->sa_family != sock->domain) {
+                return error(EAFNOSUPPORT);
+            }
+            std::string server(reinterpret_cast<const char*>(addr), len);
+            std::map<std::string, int>::const_iterator it = listeners_.find(key(server, false));
+            if (it == listeners_.end()) {
+                it = listeners_.find(key(server, true));
+            }
+            if (it == listeners_.end()) {
+                return error(ECONNREFUSED);
+            }
+            NetSocket* listener = find(it->second);
+            if (static_cast<int>(listener->pending.size()) >= listener->backlog) {
+                if (sock->isNonBlock) {
+                    return error(EAGAIN);
+                }
+                cond_.wait(mutex_, 0);
+                continue;
+            }
+            if (sock->local.empty()) {
+                setLocal(sock, loopbackAddress(sock->domain));
+            }
+            std::map<std::string, NetLink>::const_iterator itLink = links_.find(key(server, false));
+            if (itLink == links_.end()) {
+                itLink = links_.find(key(listener->local, false));
+            }
+            NetConnection* connection =
+                new NetConnection(itLink != links_.end() ? itLink->second : defaultLink_, seed_ + nbConnection_);
+            connection->client = sock->local;
+            connection->server = server;
+            // the epolls of the socket watch its connection
+            for (std::size_t i = 0; i < sock->epolls.size(); ++i) {
+                NetWatcher watcher;
+                watcher.epoll = sock->epolls[i];
+                watcher.fd = fd;
+                connection->watchers.push_back(watcher);
+            }
+            sock->connection = connection;
+            sock->isClient = true;
+            listener->pending.push_back(connection);
+            ++listener->nbIncoming;
+            ++nbConnection_;
+            notify(listener, it->second);
+            notify(sock, fd);
+            cond_.broadcast();
+            return 0;
+        }
+    }
+
+    int shutdown(int fd, int how) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (how != SHUT_RD && how != SHUT_WR && how != SHUT_RDWR) {
+            return error(EINVAL);
+        }
+        if (sock->connection == NULL) {
+            return error(ENOTCONN);
+        }
+        Lock connectionLock(sock->connection->mutex);
+        if (how != SHUT_WR) {
+            input(sock).isReaderShut = true;
+        }
+        if (how != SHUT_RD) {
+            output(sock).isWriterClosed = true;
+        }
+        notify(sock->connection);
+        return 0;
+    }
+
+    /**
+     * @brief The options are ignored
+     */
+    int setsockopt(int fd) {
+        Lock lock(mutex_);
+        if (find(fd) == NULL) {
+            return error(EBADF);
+        }
+        return 0;
+    }
+
+    int getsockopt(int fd, int level, int optname, void* optval, socklen_t* optlen) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (optval == NULL || optlen == NULL || *optlen < sizeof(int)) {
+            return error(EINVAL);
+        }
+        int value = 0;
+        if (level == SOL_SOCKET && optname == SO_TYPE) {
+            value = SOCK_STREAM;
+        }
+        else if (level == SOL_SOCKET && (optname == SO_SNDBUF || optname == SO_RCVBUF)) {
+            value = MOCKF_NET_BUFFER_SIZE;
+        }
+        else if (level == SOL_SOCKET && optname == SO_ACCEPTCONN) {
+            value = sock->type == NetSocket::LISTENER ? 1 : 0;
+        }
+        memcpy(optval, &value, sizeof(value));
+        *optlen = sizeof(value);
+        return 0;
+    }
+
+    int getsockname(int fd, struct sockaddr* addr, socklen_t* len) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        copyAddress(sock->local.empty() ? anyAddress(sock->domain) : sock->local, addr, len);
+        return 0;
+    }
+
+    int getpeername(int fd, struct sockaddr* addr, socklen_t* len) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (sock->connection == NULL) {
+            return error(ENOTCONN);
+        }
+        copyAddress(peer(sock), addr, len);
+        return 0;
+    }
+
+    /**
+     * @brief Send the iovecs (a blocking send waits for the space of buffer)
+     * The send to a closed peer returns EPIPE without SIGPIPE
+     */
+    ssize_t send(int fd, const struct iovec* iov, int iovcnt, int flags) {
+        size_t size = 0;
+        for (int i = 0; i < iovcnt; ++i) {
+            size += iov[i].iov_len;
+        }
+        Stream stream(*this);
+        int err = acquire(fd, &stream);
+        if (err != 0) {
+            return error(err);
+        }
+        size_t sent = 0;
+        for (;;) {
+            if (stream.isClosed()) {
+                return sent > 0 ? static_cast<ssize_t>(sent) : error(EBADF);
+            }
+            NetPipe& out = stream.output();
+            if (out.isWriterClosed || out.isReaderClosed) {
+                return sent > 0 ? static_cast<ssize_t>(sent) : error(EPIPE);
+            }
+            size_t n = out.write(iov, iovcnt, sent, Clock::now());
+            if (n > 0) {
+                sent += n;
+                __atomic_add_fetch(&bytes_, n, __ATOMIC_RELAXED);
+                notify(stream.connection);
+            }
+            if (sent == size) {
+                return static_cast<ssize_t>(sent);
+            }
+            if (stream.isNonBlock || (flags & MSG_DONTWAIT) != 0) {
+                return sent > 0 ? static_cast<ssize_t>(sent) : error(EAGAIN);
+            }
+            stream.connection->cond.wait(stream.connection->mutex, 0);
+        }
+    }
+
+    /**
+     * @brief Receive in the iovecs (a blocking receive waits for the delivery of segments)
+     */
+    ssize_t recv(int fd, const struct iovec* iov, int iovcnt, int flags, struct sockaddr* addr, socklen_t* len) {
+        size_t size = 0;
+        for (int i = 0; i < iovcnt; ++i) {
+            size += iov[i].iov_len;
+        }
+        Stream stream(*this);
+        int err = acquire(fd, &stream);
+        if (err != 0) {
+            return error(err);
+        }
+        if (addr != NULL && len != NULL) {
+            copyAddress(stream.peer(), addr, len);
+        }
+        for (;;) {
+            if (stream.isClosed()) {
+                return error(EBADF);
+            }
+            NetPipe& in = stream.input();
+            in.update(Clock::now());
+            if (size == 0) {
+                return 0;
+            }
+            if (in.readable() > 0) {
+                bool isPeek = (flags & MSG_PEEK) != 0;
+                size_t n = in.read(iov, iovcnt, isPeek);
+                if (!isPeek) {
+                    notify(stream.connection); // space of buffer
+                }
+                return static_cast<ssize_t>(n);
+            }
+            if (in.isEof() || in.isReaderShut) {
+                return 0;
+            }
+            if (stream.isNonBlock || (flags & MSG_DONTWAIT) != 0) {
+                return error(EAGAIN);
+            }
+            stream.connection->cond.wait(stream.connection->mutex, in.nextDelivery());
+        }
+    }
+
+    /**
+     * @param realEpoll Set to the epoll of the real file descriptors to close
+     */
+    int close(int fd, int* realEpoll) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        sockets_[fd - MOCKF_NET_FD_BASE] = NULL;
+        free_.push_back(fd);
+        // a closed file descriptor is removed from its epolls
+        for (std::size_t i = 0; i < sock->epolls.size(); ++i) {
+            Lock epollLock(sock->epolls[i]->mutex);
+            sock->epolls[i]->interests.erase(fd);
+        }
+        if (sock->epoll != NULL) {
+            NetEpoll* epoll = sock->epoll;
+            for (std::map<int, NetInterest>::iterator it = epoll->interests.begin(); it != epoll->interests.end();
+                 ++it) {
+                unwatch(epoll, it->first, find(it->first));
+            }
+            *realEpoll = epoll->realEpoll;
+            {
+                Lock epollLock(epoll->mutex);
+                epoll->isClosed = true;
+                epoll->cond.broadcast();
+            }
+            release(epoll);
+        }
+        if (sock->connection != NULL) {
+            NetConnection* connection = sock->connection;
+            {
+                Lock connectionLock(connection->mutex);
+                input(sock).isReaderClosed = true;
+                output(sock).isWriterClosed = true;
+                for (std::size_t i = connection->watchers.size(); i-- > 0;) {
+                    if (connection->watchers[i].fd == fd) {
+                        connection->watchers.erase(connection->watchers.begin() + static_cast<std::ptrdiff_t>(i));
+                    }
+                }
+                notify(connection);
+            }
+            release(connection);
+        }
+        for (std::size_t i = 0; i < sock->pending.size(); ++i) {
+            {
+                Lock connectionLock(sock->pending[i]->mutex);
+                sock->pending[i]->toServer.isReaderClosed = true;
+                sock->pending[i]->toClient.isWriterClosed = true;
+                notify(sock->pending[i]);
+            }
+            release(sock->pending[i]);
+        }
+        if (sock->type == NetSocket::LISTENER) {
+            listeners_.erase(key(sock->local, false));
+            cond_.broadcast();
+        }
+        // an accepted socket has the address of its listener
+        if (!sock->local.empty() && (sock->connection == NULL || sock->isClient)) {
+            bound_.erase(key(sock->local, false));
+        }
+        delete sock;
+        return 0;
+    }
+
+    int fcntl(int fd, int cmd, long arg) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(fd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        switch (cmd) {
+            case F_GETFL:
+                return O_RDWR | (sock->isNonBlock ? O_NONBLOCK : 0);
+            case F_SETFL:
+                sock->isNonBlock = (arg & O_NONBLOCK) != 0;
+                return 0;
+            case F_GETFD:
+                return sock->fdFlags;
+            case F_SETFD:
+                sock->fdFlags = static_cast<int>(arg);
+                return 0;
+            default:
+                return error(EINVAL);
+        }
+    }
+
+    /**
+     * @brief Poll of simulated and real file descriptors (the real ones are polled each millisecond)
+     * The simulated file descriptors wake the poll by a local epoll.
+     */
+    int poll(struct pollfd* fds, nfds_t nfds, int timeout, poll_t realPoll) {
+        std::vector<struct pollfd> reals;
+        for (nfds_t i = 0; i < nfds; ++i) {
+            if (fds[i].fd >= 0 && !isFd(fds[i].fd)) {
+                reals.push_back(fds[i]);
+            }
+        }
+        NetEpoll epoll;
+        {
+            Lock lock(mutex_);
+            for (nfds_t i = 0; i < nfds; ++i) {
+                NetSocket* sock = find(fds[i].fd);
+                if (sock != NULL) {
+                    bool isNew = false;
+                    {
+                        Lock epollLock(epoll.mutex);
+                        isNew = epoll.interests.insert(std::pair<int, NetInterest>(fds[i].fd, NetInterest())).second;
+                    }
+                    if (isNew) {
+                        watch(&epoll, fds[i].fd, sock);
+                    }
+                }
+            }
+        }
+        uint64_t deadline = timeout > 0 ? Clock::now() + static_cast<uint64_t>(timeout) * 1000000u : 0;
+        int ret = 0;
+        for (;;) {
+            {
+                Lock epollLock(epoll.mutex);
+                while (!epoll.ready.empty()) {
+                    std::map<int, NetInterest>::iterator it = epoll.interests.find(epoll.ready.front());
+                    if (it != epoll.interests.end()) {
+                        it->second.isQueued = false;
+                    }
+                    epoll.ready.pop_front();
+                }
+            }
+            uint64_t now = Clock::now();
+            uint64_t wake = 0;
+            int nbReady = 0;
+            if (!reals.empty() && realPoll(&reals[0], static_cast<nfds_t>(reals.size()), 0) < 0) {
+                ret = -1;
+                break;
+            }
+            {
+                Lock lock(mutex_);
+                std::size_t real = 0;
+                for (nfds_t i = 0; i < nfds; ++i) {
+                    fds[i].revents = 0;
+                    if (fds[i].fd < 0) {
+                        continue;
+                    }
+                    if (!isFd(fds[i].fd)) {
+                        fds[i].revents = reals[real++].revents;
+                    }
+                    else {
+                        NetSocket* sock = find(fds[i].fd);
+                        if (sock == NULL) {
+                            fds[i].revents = POLLNVAL;
+                        }
+                        else {
+                            uint64_t sequence = 0;
+                            uint32_t ready = events(sock, now, &wake, &sequence);
+                            fds[i].revents = static_cast<short>(
+                                ready & (static_cast<uint16_t>(fds[i].events) | POLLERR | POLLHUP));
+                        }
+                    }
+                    if (fds[i].revents != 0) {
+                        ++nbReady;
+                    }
+                }
+            }
+            if (nbReady > 0 || timeout == 0 || (deadline != 0 && now >= deadline)) {
+                ret = nbReady;
+                break;
+            }
+            wait(&epoll, earliest(earliest(wake, deadline), reals.empty() ? 0 : now + 1000000u));
+        }
+        Lock lock(mutex_);
+        for (std::map<int, NetInterest>::iterator it = epoll.interests.begin(); it != epoll.interests.end(); ++it) {
+            unwatch(&epoll, it->first, find(it->first));
+        }
+        return ret;
+    }
+
+    int epollCreate(int flags) {
+        if ((flags & ~EPOLL_CLOEXEC) != 0) {
+            return error(EINVAL);
+        }
+        Lock lock(mutex_);
+        NetSocket* sock = new NetSocket(NetSocket::EPOLL, AF_UNSPEC);
+        sock->fdFlags = (flags & EPOLL_CLOEXEC) != 0 ? FD_CLOEXEC : 0;
+        sock->epoll = new NetEpoll();
+        return add(sock);
+    }
+
+    /**
+     * @brief Control a simulated epoll (the real file descriptors are added in a real epoll)
+     */
+    int epollCtl(int epfd, int op, int fd, struct epoll_event* event, epoll_create1_t realEpollCreate1,
+                 epoll_ctl_t realEpollCtl) {
+        Lock lock(mutex_);
+        NetSocket* sock = find(epfd);
+        if (sock == NULL) {
+            return error(EBADF);
+        }
+        if (sock->type != NetSocket::EPOLL || fd == epfd) {
+            return error(EINVAL);
+        }
+        if (op != EPOLL_CTL_DEL && event == NULL) {
+            return error(EFAULT);
+        }
+        NetEpoll* epoll = sock->epoll;
+        if (!isFd(fd)) {
+            if (epoll->realEpoll < 0) {
+                int realEpoll = realEpollCreate1(EPOLL_CLOEXEC);
+                if (realEpoll < 0) {
+                    return -1;
+                }
+                __atomic_store_n(&epoll->realEpoll, realEpoll, __ATOMIC_RELEASE);
+            }
+            return realEpollCtl(epoll->realEpoll, op, fd, event);
+        }
+        NetSocket* target = find(fd);
+        if (target == NULL) {
+            return error(EBADF);
+        }
+        if (target->type == NetSocket::EPOLL) {
+            return error(EINVAL);
+        }
+        bool isFound = epoll->interests.find(fd) != epoll->interests.end();
+        switch (op) {
+            case EPOLL_CTL_ADD:
+                if (isFound) {
+                    return error(EEXIST);
+                }
+                // watch before the registration: a change is not lost
+                watch(epoll, fd, target);
+                break;
+            case EPOLL_CTL_MOD:
+                if (!isFound) {
+                    return error(ENOENT);
+                }
+                break;
+            case EPOLL_CTL_DEL:
+                if (!isFound) {
+                    return error(ENOENT);
+                }
+                {
+                    Lock epollLock(epoll->mutex);
+                    epoll->interests.erase(fd);
+                }
+                unwatch(epoll, fd, target);
+                return 0;
+            default:
+                return error(EINVAL);
+        }
+        Lock epollLock(epoll->mutex);
+        NetInterest& interest = epoll->interests[fd];
+        interest.event = *event;
+        interest.lastEvents = 0;
+        interest.sequence = 0;
+        interest.wakeAt = 0;
+        interest.isDisabled = false;
+        epoll->queue(fd);
+        return 0;
+    }
+
+    /**
+     * @brief Wait on a simulated epoll (level or edge triggered, oneshot)
+     * Only the queued file descriptors are checked, a ready level triggered one is queued again after the others.
+     */
+    int epollWait(int epfd, struct epoll_event* events, int maxevents, int timeout, epoll_wait_t realEpollWait) {
+        if (maxevents <= 0) {
+            return error(EINVAL);
+        }
+        NetEpoll* epoll = NULL;
+        {
+            Lock lock(mutex_);
+            NetSocket* sock = find(epfd);
+            if (sock == NULL) {
+                return error(EBADF);
+            }
+            if (sock->type != NetSocket::EPOLL) {
+                return error(EINVAL);
+            }
+            epoll = sock->epoll;
+            __atomic_add_fetch(&epoll->nbRef, 1, __ATOMIC_RELAXED);
+        }
+        uint64_t deadline = timeout > 0 ? Clock::now() + static_cast<uint64_t>(timeout) * 1000000u : 0;
+        int ret = 0;
+        for (;;) {
+            uint64_t now = Clock::now();
+            uint64_t wake = 0;
+            int nbReady = scan(epoll, events, maxevents, now, &wake);
+            if (nbReady < 0) {
+                ret = error(EBADF);
+                break;
+            }
+            int realEpoll = __atomic_load_n(&epoll->realEpoll, __ATOMIC_ACQUIRE);
+            if (nbReady < maxevents && realEpoll >= 0) {
+                int nbReal = realEpollWait(realEpoll, events + nbReady, maxevents - nbReady, 0);
+                if (nbReal > 0) {
+                    nbReady += nbReal;
+                }
+            }
+            if (nbReady > 0 || timeout == 0 || (deadline != 0 && now >= deadline)) {
+                ret = nbReady;
+                break;
+            }
+            wait(epoll, earliest(earliest(wake, deadline), realEpoll < 0 ? 0 : now + 1000000u));
+        }
+        release(epoll);
+        return ret;
+    }
+
+  private:
+    Net(const Net&);            // disable copy
+    Net& operator=(const Net&); // disable copy
+
+    struct Lock {
+        Lock(pthread_mutex_t& mutex) :
+            mutex_(mutex) {
+            pthread_mutex_lock(&mutex_);
+        }
+        ~Lock() {
+            pthread_mutex_unlock(&mutex_);
+        }
+        pthread_mutex_t& mutex_;
+    };
+
+    /**
+     * @brief Connection of a stream socket referenced and locked during a call (another thread can close the socket)
+     */
+    class Stream {
+      public:
+        Stream(Net& net) :
+            connection(NULL),
+            isClient(false),
+            isNonBlock(false),
+            net_(net) {}
+        ~Stream() {
+            if (connection != NULL) {
+                pthread_mutex_unlock(&connection->mutex);
+                net_.release(connection);
+            }
+        }
+        NetPipe& input() const {
+            return isClient ? connection->toClient : connection->toServer;
+        }
+        NetPipe& output() const {
+            return isClient ? connection->toServer : connection->toClient;
+        }
+        const std::string& peer() const {
+            return isClient ? connection->server : connection->client;
+        }
+        // the socket of the call is closed
+        bool isClosed() const {
+            return input().isReaderClosed;
+        }
+        NetConnection* connection;
+        bool isClient;
+        bool isNonBlock;
+
+      private:
+        Stream(const Stream&);            // disable copy
+        Stream& operator=(const Stream&); // disable copy
+
+        Net& net_;
+    };
+
+    // reference and lock the connection of a socket (0 or an error number)
+    int acquire(int fd, Stream* stream) {
+        NetConnection* connection = NULL;
+        {
+            Lock lock(mutex_);
+            NetSocket* sock = find(fd);
+            if (sock == NULL) {
+                return EBADF;
+            }
+            if (sock->type == NetSocket::EPOLL) {
+                return EINVAL;
+            }
+            if (sock->connection == NULL) {
+                return ENOTCONN;
+            }
+            connection = sock->connection;
+            __atomic_add_fetch(&connection->nbRef, 1, __ATOMIC_RELAXED);
+            stream->isClient = sock->isClient;
+            stream->isNonBlock = sock->isNonBlock;
+        }
+        pthread_mutex_lock(&connection->mutex);
+        stream->connection = connection;
+        return 0;
+    }
+
+    static int error(int err) {
+        errno = err;
+        return -1;
+    }
+
+    // 0 is no time
+    static uint64_t earliest(uint64_t a, uint64_t b) {
+        if (a == 0) {
+            return b;
+        }
+        return b == 0 || a < b ? a : b;
+    }
+
+    // wait a queued file descriptor or the time (0: no time)
+    static void wait(NetEpoll* epoll, uint64_t time) {
+        Lock lock(epoll->mutex);
+        if (epoll->ready.empty() && !epoll->isClosed) {
+            epoll->cond.wait(epoll->mutex, time);
+        }
+    }
+
+    NetSocket* find(int fd) const {
+        if (!isFd(fd) || static_cast<std::size_t>(fd - MOCKF_NET_FD_BASE) >= sockets_.size()) {
+            return NULL;
+        }
+        return sockets_[fd - MOCKF_NET_FD_BASE];
+    }
+
+    int add(NetSocket* sock) {
+        if (!free_.empty()) {
+            int fd = free_.back();
+            free_.pop_back();
+            sockets_[fd - MOCKF_NET_FD_BASE] = sock;
+            return fd;
+        }
+        sockets_.push_back(sock);
+        return static_cast<int>(MOCKF_NET_FD_BASE + sockets_.size() - 1);
+    }
+
+    static NetPipe& input(const NetSocket* sock) {
+        return sock->isClient ? sock->connection->toClient : sock->connection->toServer;
+    }
+
+    static NetPipe& output(const NetSocket* sock) {
+        return sock->isClient ? sock->connection->toServer : sock->connection->toClient;
+    }
+
+    static const std::string& peer(const NetSocket* sock) {
+        return sock->isClient ? sock->connection->server : sock->connection->client;
+    }
+
+    void release(NetConnection* connection) {
+        if (__atomic_sub_fetch(&connection->nbRef, 1, __ATOMIC_ACQ_REL) == 0) {
+            __atomic_add_fetch(&nbLost_, connection->toServer.nbLost() + connection->toClient.nbLost(),
+                               __ATOMIC_RELAXED);
+            delete connection;
+        }
+    }
+
+    static void release(NetEpoll* epoll) {
+        if (__atomic_sub_fetch(&epoll->nbRef, 1, __ATOMIC_ACQ_REL) == 0) {
+            delete epoll;
+        }
+    }
+
+    // add an epoll to the watchers of a socket (locked)
+    static void watch(NetEpoll* epoll, int fd, NetSocket* sock) {
+        sock->epolls.push_back(epoll);
+        if (sock->connection != NULL) {
+            NetWatcher watcher;
+            watcher.epoll = epoll;
+            watcher.fd = fd;
+            Lock connectionLock(sock->connection->mutex);
+            sock->connection->watchers.push_back(watcher);
+        }
+    }
+
+    // remove an epoll from the watchers of a socket (locked, sock can be NULL)
+    static void unwatch(NetEpoll* epoll, int fd, NetSocket* sock) {
+        if (sock == NULL) {
+            return;
+        }
+        for (std::size_t i = 0; i < sock->epolls.size(); ++i) {
+            if (sock->epolls[i] == epoll) {
+                sock->epolls.erase(sock->epolls.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+        if (sock->connection != NULL) {
+            Lock connectionLock(sock->connection->mutex);
+            std::vector<NetWatcher>& watchers = sock->connection->watchers;
+            for (std::size_t i = 0; i < watchers.size(); ++i) {
+                if (watchers[i].epoll == epoll && watchers[i].fd == fd) {
+                    watchers.erase(watchers.begin() + static_cast<std::ptrdiff_t>(i));
+                    break;
+                }
+            }
+        }
+    }
+
+    // queue a socket in its epolls (locked)
+    static void notify(NetSocket* sock, int fd) {
+        for (std::size_t i = 0; i < sock->epolls.size(); ++i) {
+            Lock epollLock(sock->epolls[i]->mutex);
+            sock->epolls[i]->queue(fd);
+        }
+    }
+
+    // wake the waiters of a connection and queue its sockets in their epolls (connection locked)
+    static void notify(NetConnection* connection) {
+        connection->cond.broadcast();
+        for (std::size_t i = 0; i < connection->watchers.size(); ++i) {
+            Lock epollLock(connection->watchers[i].epoll->mutex);
+            connection->watchers[i].epoll->queue(connection->watchers[i].fd);
+        }
+    }
+
+    /**
+     * @brief Events of a socket at now (locked)
+     * @param wake Set to the earliest delivery in the future
+     * @param sequence Set to the counter of changes
+     */
+    static uint32_t events(NetSocket* sock, uint64_t now, uint64_t* wake, uint64_t* sequence) {
+        if (sock->type == NetSocket::LISTENER) {
+            *sequence = sock->nbIncoming;
+            return sock->pending.empty() ? 0 : static_cast<uint32_t>(EPOLLIN);
+        }
+        if (sock->connection == NULL) {
+            return EPOLLOUT | EPOLLHUP;
+        }
+        Lock connectionLock(sock->connection->mutex);
+        NetPipe& in = input(sock);
+        NetPipe& out = output(sock);
+        in.update(now);
+        *wake = earliest(*wake, in.nextDelivery());
+        *sequence = in.sequence() + out.sequence();
+        uint32_t ready = 0;
+        if (in.readable() > 0 || in.isEof() || in.isReaderShut) {
+            ready |= EPOLLIN;
+        }
+        if (in.isEof()) {
+            ready |= EPOLLRDHUP;
+        }
+        if (out.isReaderClosed) {
+            ready |= EPOLLOUT | EPOLLERR;
+        }
+        else if (out.writable() > 0 && !out.isWriterClosed) {
+            ready |= EPOLLOUT;
+        }
+        if (in.isEof() && (out.isReaderClosed || out.isWriterClosed)) {
+            ready |= EPOLLHUP;
+        }
+        return ready;
+    }
+
+    /**
+     * @brief Report the ready interests of the queue of an epoll
+     * @param wake Set to the earliest timer
+     * @return number of events, -1 if the epoll is closed
+     */
+    int scan(NetEpoll* epoll, struct epoll_event* events, int maxevents, uint64_t now, uint64_t* wake) {
+        // take the queue and the expired timers
+        std::vector<int> fds;
+        {
+            Lock epollLock(epoll->mutex);
+            if (epoll->isClosed) {
+                return -1;
+            }
+            while (!epoll->timers.empty() && epoll->timers.begin()->first <= now) {
+                std::map<int, NetInterest>::iterator it = epoll->interests.find(epoll->timers.begin()->second);
+                if (it != epoll->interests.end() && it->second.wakeAt == epoll->timers.begin()->first) {
+                    it->second.wakeAt = 0;
+                    epoll->queue(it->first);
+                }
+                epoll->timers.erase(epoll->timers.begin());
+            }
+            fds.reserve(epoll->ready.size());
+            while (!epoll->ready.empty()) {
+                std::map<int, NetInterest>::iterator it = epoll->interests.find(epoll->ready.front());
+                epoll->ready.pop_front();
+                if (it != epoll->interests.end() && it->second.isQueued) {
+                    it->second.isQueued = false;
+                    fds.push_back(it->first);
+                }
+            }
+        }
+        // the events of the sockets without the lock of the epoll
+        std::vector<uint32_t> readies(fds.size(), 0);
+        std::vector<uint64_t> sequences(fds.size(), 0);
+        std::vector<uint64_t> wakes(fds.size(), 0);
+        {
+            Lock lock(mutex_);
+            for (std::size_t i = 0; i < fds.size(); ++i) {
+                NetSocket* sock = find(fds[i]);
+                if (sock != NULL) {
+                    readies[i] = Net::events(sock, now, &wakes[i], &sequences[i]);
+                }
+            }
+        }
+        Lock epollLock(epoll->mutex);
+        int nbReady = 0;
+        std::vector<int> levels;
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            std::map<int, NetInterest>::iterator it = epoll->interests.find(fds[i]);
+            if (it == epoll->interests.end()) {
+                continue; // removed or closed
+            }
+            NetInterest& interest = it->second;
+            if (wakes[i] != 0 && wakes[i] != interest.wakeAt) {
+                interest.wakeAt = wakes[i];
+                epoll->timers.insert(std::pair<uint64_t, int>(wakes[i], fds[i]));
+            }
+            uint32_t ready = readies[i] & (interest.event.events | EPOLLERR | EPOLLHUP);
+            if (ready == 0) {
+                interest.lastEvents = 0;
+                continue;
+            }
+            if (interest.isDisabled) {
+                continue;
+            }
+            if (nbReady == maxevents) {
+                epoll->queue(fds[i]); // reported at the next wait
+                continue;
+            }
+            if ((interest.event.events & EPOLLET) != 0 && (ready & ~interest.lastEvents) == 0 &&
+                sequences[i] == interest.sequence) {
+                continue;
+            }
+            interest.lastEvents = ready;
+            interest.sequence = sequences[i];
+            if ((interest.event.events & EPOLLONESHOT) != 0) {
+                interest.isDisabled = true;
+            }
+            else if ((interest.event.events & EPOLLET) == 0) {
+                levels.push_back(fds[i]);
+            }
+            events[nbReady].events = ready;
+            events[nbReady].data = interest.event.data;
+            ++nbReady;
+        }
+        // a level triggered interest is checked again after the others
+        for (std::size_t i = 0; i < levels.size(); ++i) {
+            epoll->queue(levels[i]);
+        }
+        *wake = epoll->timers.empty() ? 0 : epoll->timers.begin()->first;
+        return nbReady;
+    }
+
+    // key of an address for the listeners (without the padding of sockaddr)
+    static std::string key(const std::string& address, bool isAny) {
+        std::string ret;
+        if (address.size() < sizeof(sa_family_t)) {
+            return ret;
+        }
+        const struct sockaddr* addr = reinterpret_cast<const struct sockaddr*>(address.data());
+        if (addr->sa_family == AF_INET && address.size() >= sizeof(struct sockaddr_in)) {
+            const struct sockaddr_in* in = reinterpret_cast<const struct sockaddr_in*>(address.data());
+            struct in_addr any;
+            any.s_addr = htonl(INADDR_ANY);
+            ret.assign("4");
+            ret.append(reinterpret_cast<const char*>(&in->sin_port), sizeof(in->sin_port));
+            ret.append(reinterpret_cast<const char*>(isAny ? &any : &in->sin_addr), sizeof(in->sin_addr));
+        }
+        else if (addr->sa_family == AF_INET6 && address.size() >= sizeof(struct sockaddr_in6)) {
+            const struct sockaddr_in6* in6 = reinterpret_cast<const struct sockaddr_in6*>(address.data());
+            ret.assign("6");
+            ret.append(reinterpret_cast<const char*>(&in6->sin6_port), sizeof(in6->sin6_port));
+            ret.append(reinterpret_cast<const char*>(isAny ? &in6addr_any : &in6->sin6_addr),
+                       sizeof(in6->sin6_addr));
+        }
+        else if (addr->sa_family == AF_UNIX) {
+            std::string path = address.substr(offsetof(struct sockaddr_un, sun_path));
+            if (!path.empty() && path[0] != '\0') {
+                path = path.substr(0, path.find('\0'));
+            }
+            ret.assign("u");
+            ret.append(path);
+        }
+        return ret;
+    }
+
+    // the port of address is 0
+    static bool isEphemeral(const std::string& address) {
+        const struct sockaddr* addr = reinterpret_cast<const struct sockaddr*>(address.data());
+        if (addr->sa_family == AF_INET && address.size() >= sizeof(struct sockaddr_in)) {
+            return reinterpret_cast<const struct sockaddr_in*>(address.data())->sin_port == 0;
+        }
+        if (addr->sa_family == AF_INET6 && address.size() >= sizeof(struct sockaddr_in6)) {
+            return reinterpret_cast<const struct sockaddr_in6*>(address.data())->sin6_port == 0;
+        }
+        return false;
+    }
+
+    // bind the socket (with a new port if the port is 0)
+    void setLocal(NetSocket* sock, std::string local) {
+        if (isEphemeral(local)) {
+            uint16_t port = 0;
+            do {
+                port = htons(nextPort_);
+                nextPort_ = nextPort_ == 65535 ? MOCKF_NET_EPHEMERAL_PORT : nextPort_ + 1;
+                if (sock->domain == AF_INET) {
+                    reinterpret_cast<struct sockaddr_in*>(&local[0])->sin_port = port;
+                }
+                else {
+                    reinterpret_cast<struct sockaddr_in6*>(&local[0])->sin6_port = port;
+                }
+            } while (bound_.find(key(local, false)) != bound_.end());
+        }
+        sock->local = local;
+        if (sock->domain != AF_UNIX || local.size() > offsetof(struct sockaddr_un, sun_path)) {
+            bound_.insert(key(local, false));
+        }
+    }
+
+    static std::string anyAddress(int domain) {
+        if (domain == AF_INET) {
+            struct sockaddr_in in;
+            memset(&in, 0, sizeof(in));
+            in.sin_family = AF_INET;
+            in.sin_addr.s_addr = htonl(INADDR_ANY);
+            return std::string(reinterpret_cast<const char*>(&in), sizeof(in));
+        }
+        if (domain == AF_INET6) {
+            struct sockaddr_in6 in6;
+            memset(&in6, 0, sizeof(in6));
+            in6.sin6_family = AF_INET6;
+            in6.sin6_addr = in6addr_any;
+            return std::string(reinterpret_cast<const char*>(&in6), sizeof(in6));
+        }
+        sa_family_t family = AF_UNIX;
+        return std::string(reinterpret_cast<const char*>(&family), sizeof(family));
+    }
+
+    static std::string loopbackAddress(int domain) {
+        std::string address = anyAddress(domain);
+        if (domain == AF_INET) {
+            reinterpret_cast<struct sockaddr_in*>(&address[0])->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        }
+        else if (domain == AF_INET6) {
+            reinterpret_cast<struct sockaddr_in6*>(&address[0])->sin6_addr = in6addr_loopback;
+        }
+        return address;
+    }
+
+    // copy with truncation, len is set to the size of address
+    static void copyAddress(const std::string& address, struct sockaddr* addr, socklen_t* len) {
+        if (addr == NULL || len == NULL) {
+            return;
+        }
+        memcpy(addr, address.data(), address.size() < *len ? address.size() : *len);
+        *len = static_cast<socklen_t>(address.size());
+    }
+
+    uint64_t seed_;
+    uint16_t nextPort_;
+    uint64_t nbConnection_;
+    uint64_t nbLost_;
+    uint64_t bytes_;
+    mutable pthread_mutex_t mutex_;
+    NetCondition cond_; // waiters of the listeners
+    NetLink defaultLink_;
+    std::map<std::string, NetLink> links_;
+    std::map<std::string, int> listeners_;
+    std::set<std::string> bound_;
+    std::vector<NetSocket*> sockets_;
+    std::vector<int> free_;
+};
+
+/**
+ * @brief Handlers of mocks: call the simulated network or the real function
+ */
+template<typename T>
+int netSocket(int domain, int type, int protocol) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isSocket(domain, type)) {
+        return net->socket(domain, type);
+    }
+    return T::real()(domain, type, protocol);
+}
+
+template<typename T>
+int netBind(int fd, const struct sockaddr* addr, socklen_t len) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->bind(fd, addr, len);
+    }
+    return T::real()(fd, addr, len);
+}
+
+template<typename T>
+int netListen(int fd, int n) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->listen(fd, n);
+    }
+    return T::real()(fd, n);
+}
+
+template<typename T>
+int netAccept(int fd, struct sockaddr* addr, socklen_t* len) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->accept(fd, addr, len, 0);
+    }
+    return T::real()(fd, addr, len);
+}
+
+template<typename T>
+int netAccept4(int fd, struct sockaddr* addr, socklen_t* len, int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->accept(fd, addr, len, flags);
+    }
+    return T::real()(fd, addr, len, flags);
+}
+
+template<typename T>
+int netConnect(int fd, const struct sockaddr* addr, socklen_t len) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->connect(fd, addr, len);
+    }
+    return T::real()(fd, addr, len);
+}
+
+template<typename T>
+int netShutdown(int fd, int how) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->shutdown(fd, how);
+    }
+    return T::real()(fd, how);
+}
+
+template<typename T>
+int netSetsockopt(int fd, int level, int optname, const void* optval, socklen_t optlen) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->setsockopt(fd);
+    }
+    return T::real()(fd, level, optname, optval, optlen);
+}
+
+template<typename T>
+int netGetsockopt(int fd, int level, int optname, void* optval, socklen_t* optlen) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->getsockopt(fd, level, optname, optval, optlen);
+    }
+    return T::real()(fd, level, optname, optval, optlen);
+}
+
+template<typename T>
+int netGetsockname(int fd, struct sockaddr* addr, socklen_t* len) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->getsockname(fd, addr, len);
+    }
+    return T::real()(fd, addr, len);
+}
+
+template<typename T>
+int netGetpeername(int fd, struct sockaddr* addr, socklen_t* len) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->getpeername(fd, addr, len);
+    }
+    return T::real()(fd, addr, len);
+}
+
+template<typename T>
+ssize_t netSend(int fd, const void* buf, size_t n, int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        struct iovec iov;
+        iov.iov_base = const_cast<void*>(buf);
+        iov.iov_len = n;
+        return net->send(fd, &iov, 1, flags);
+    }
+    return T::real()(fd, buf, n, flags);
+}
+
+template<typename T>
+ssize_t netRecv(int fd, void* buf, size_t n, int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        struct iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = n;
+        return net->recv(fd, &iov, 1, flags, NULL, NULL);
+    }
+    return T::real()(fd, buf, n, flags);
+}
+
+template<typename T>
+ssize_t netSendmsg(int fd, const struct msghdr* message, int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        if (message == NULL) {
+            errno = EFAULT;
+            return -1;
+        }
+        return net->send(fd, message->msg_iov, static_cast<int>(message->msg_iovlen), flags);
+    }
+    return T::real()(fd, message, flags);
+}
+
+template<typename T>
+ssize_t netRecvmsg(int fd, struct msghdr* message, int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        if (message == NULL) {
+            errno = EFAULT;
+            return -1;
+        }
+        message->msg_controllen = 0;
+        message->msg_flags = 0;
+        return net->recv(fd, message->msg_iov, static_cast<int>(message->msg_iovlen), flags,
+                         static_cast<struct sockaddr*>(message->msg_name),
+                         message->msg_name != NULL ? &message->msg_namelen : NULL);
+    }
+    return T::real()(fd, message, flags);
+}
+
+template<typename T>
+ssize_t netRead(int fd, void* buf, size_t nbytes) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        struct iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = nbytes;
+        return net->recv(fd, &iov, 1, 0, NULL, NULL);
+    }
+    return T::real()(fd, buf, nbytes);
+}
+
+template<typename T>
+ssize_t netWrite(int fd, const void* buf, size_t n) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        struct iovec iov;
+        iov.iov_base = const_cast<void*>(buf);
+        iov.iov_len = n;
+        return net->send(fd, &iov, 1, 0);
+    }
+    return T::real()(fd, buf, n);
+}
+
+template<typename T>
+int netClose(int fd) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        int realEpoll = -1;
+        int ret = net->close(fd, &realEpoll);
+        if (realEpoll >= 0) {
+            T::real()(realEpoll);
+        }
+        return ret;
+    }
+    return T::real()(fd);
+}
+
+template<typename T>
+int netFcntl(int fd, int cmd, ...) {
+    va_list args;
+    va_start(args, cmd);
+    void* arg = va_arg(args, void*); // same of glibc: the argument is an int or a pointer
+    va_end(args);
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(fd)) {
+        return net->fcntl(fd, cmd, static_cast<long>(reinterpret_cast<intptr_t>(arg)));
+    }
+    return T::real()(fd, cmd, arg);
+}
+
+template<typename T>
+int netPoll(struct pollfd* fds, nfds_t nfds, int timeout) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL) {
+        for (nfds_t i = 0; i < nfds; ++i) {
+            if (Net::isFd(fds[i].fd)) {
+                return net->poll(fds, nfds, timeout, T::real());
+            }
+        }
+    }
+    return T::real()(fds, nfds, timeout);
+}
+
+template<typename T>
+int netEpollCreate1(int flags) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL) {
+        return net->epollCreate(flags);
+    }
+    return T::real()(flags);
+}
+
+template<typename T, typename EpollCreate1>
+int netEpollCtl(int epfd, int op, int fd, struct epoll_event* event) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(epfd)) {
+        return net->epollCtl(epfd, op, fd, event, EpollCreate1::real(), T::real());
+    }
+    if (net != NULL && Net::isFd(fd)) {
+        errno = EPERM; // same of a regular file in a real epoll
+        return -1;
+    }
+    return T::real()(epfd, op, fd, event);
+}
+
+template<typename T>
+int netEpollWait(int epfd, struct epoll_event* events, int maxevents, int timeout) {
+    Net* net = __atomic_load_n(&Net::instance(), __ATOMIC_ACQUIRE);
+    if (net != NULL && Net::isFd(epfd)) {
+        return net->epollWait(epfd, events, maxevents, timeout, T::real());
+    }
+    return T::real()(epfd, events, maxevents, timeout);
+}
+
+/**
+ * @brief Set the handlers of the simulated network at load time
+ */
+template<typename Socket, typename Bind, typename Listen, typename Accept, typename Accept4, typename Connect,
+         typename Shutdown, typename Setsockopt, typename Getsockopt, typename Getsockname, typename Getpeername,
+         typename Send, typename Recv, typename Sendmsg, typename Recvmsg, typename Read, typename Write,
+         typename Close, typename Fcntl, typename Poll, typename EpollCreate1, typename EpollCtl, typename EpollWait>
+struct NetHandlers {
+    NetHandlers() {
+        Socket::setHandler(&netSocket<Socket>);
+        Bind::setHandler(&netBind<Bind>);
+        Listen::setHandler(&netListen<Listen>);
+        Accept::setHandler(&netAccept<Accept>);
+        Accept4::setHandler(&netAccept4<Accept4>);
+        Connect::setHandler(&netConnect<Connect>);
+        Shutdown::setHandler(&netShutdown<Shutdown>);
+        Setsockopt::setHandler(&netSetsockopt<Setsockopt>);
+        Getsockopt::setHandler(&netGetsockopt<Getsockopt>);
+        Getsockname::setHandler(&netGetsockname<Getsockname>);
+        Getpeername::setHandler(&netGetpeername<Getpeername>);
+        Send::setHandler(&netSend<Send>);
+        Recv::setHandler(&netRecv<Recv>);
+        Sendmsg::setHandler(&netSendmsg<Sendmsg>);
+        Recvmsg::setHandler(&netRecvmsg<Recvmsg>);
+        Read::setHandler(&netRead<Read>);
+        Write::setHandler(&netWrite<Write>);
+        Close::setHandler(&netClose<Close>);
+        Fcntl::setHandler(&netFcntl<Fcntl>);
+        Poll::setHandler(&netPoll<Poll>);
+        EpollCreate1::setHandler(&netEpollCreate1<EpollCreate1>);
+        EpollCtl::setHandler(&netEpollCtl<EpollCtl, EpollCreate1>);
+        EpollWait::setHandler(&netEpollWait<EpollWait>);
+    }
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_NET_H_
@@ -0,0 +1,329 @@
+/**
+ * mockf/preload.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_PRELOAD_H_
+#define BLET_MOCKF_PRELOAD_H_
+
+#include <errno.h>       // errno, ESRCH
+#include <fcntl.h>       // O_CREAT, O_RDWR, AT_FDCWD
+#include <sched.h>       // sched_yield
+#include <stdint.h>      // uint32_t, uint64_t
+#include <stdio.h>       // fprintf
+#include <stdlib.h>      // getenv
+#include <string.h>      // memcmp, memcpy
+#include <sys/mman.h>    // mmap, munmap
+#include <sys/syscall.h> // SYS_openat, SYS_close, SYS_ftruncate, SYS_unlink, SYS_kill, SYS_getpid
+#include <unistd.h>      // syscall
+
+#include <new>
+#include <string>
+
+#include "blet/mockf/core.h"
+
+/**
+ * @brief Attach the mocks to the control block at load time (in one source file of a preloaded library)
+ * The name of shared memory is the MOCKF_PRELOAD_SHM environment variable (or MOCKF_PRELOAD_DEFAULT_SHM).
+ * An error is written on stderr and the mocks stay without policy.
+ */
+#define MOCKF_PRELOAD() static const ::blet::mockf::PreloadAttach mockf_preload_attach
+
+/**
+ * @brief Default name of the shared memory of control block
+ */
+#ifndef MOCKF_PRELOAD_DEFAULT_SHM
+#define MOCKF_PRELOAD_DEFAULT_SHM "/blet_mockf_preload"
+#endif
+
+/**
+ * @brief Maximum number of mocks in the control block
+ */
+#ifndef MOCKF_PRELOAD_SLOTS_MAX
+#define MOCKF_PRELOAD_SLOTS_MAX 256
+#endif
+
+/**
+ * @brief Maximum size of the name of mocks in the control block
+ */
+#ifndef MOCKF_PRELOAD_NAME_MAX
+#define MOCKF_PRELOAD_NAME_MAX 64
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+struct PreloadError : public Exception {
+    PreloadError(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "preload shared memory error.";
+    }
+};
+
+/**
+ * @brief Policy of a mock in the control block
+ * The state of a slot in initialization has the pid of its process (INITIALIZING | pid << 2),
+ * the slot left by a dead process is reclaimed.
+ */
+struct PreloadSlot {
+    enum State {
+        FREE = 0,
+        READY = 1,
+        INITIALIZING = 2
+    };
+    uint32_t state;
+    char name[MOCKF_PRELOAD_NAME_MAX];
+    Policy policy;
+
+    /**
+     * @brief State of initialization by the current process
+     */
+    static uint32_t initializing() {
+        return INITIALIZING | (static_cast<uint32_t>(::syscall(SYS_getpid)) << 2);
+    }
+    /**
+     * @brief The process of initialization is dead
+     */
+    static bool isStale(uint32_t state) {
+        if ((state & INITIALIZING) == 0) {
+            return false;
+        }
+        int error = errno;
+        bool isDead = ::syscall(SYS_kill, static_cast<pid_t>(state >> 2), 0) != 0 && errno == ESRCH;
+        errno = error;
+        return isDead;
+    }
+};
+
+/**
+ * @brief Control block in shared memory: a policy and a call counter by mock
+ * The block is shared by the processes of mocks and the processes of control.
+ */
+struct PreloadControl {
+    char magic[8];
+    uint32_t version;
+    PreloadSlot slots[MOCKF_PRELOAD_SLOTS_MAX];
+
+    /**
+     * @brief Find the slot of mock
+     * @return PreloadSlot* Slot or NULL
+     */
+    PreloadSlot* find(const char* name) {
+        for (unsigned int i = 0; i < MOCKF_PRELOAD_SLOTS_MAX; ++i) {
+            uint32_t state = wait(slots[i]);
+            if (state == PreloadSlot::FREE) {
+                break;
+            }
+            if (state == PreloadSlot::READY && isName(slots[i], name)) {
+                return &slots[i];
+            }
+        }
+        return NULL;
+    }
+
+    /**
+     * @brief Find or create the slot of mock (with a disabled policy)
+     * @return PreloadSlot* Slot or NULL if the control block is full
+     */
+    PreloadSlot* acquire(const char* name, uint64_t seed = 0) {
+        for (unsigned int i = 0; i < MOCKF_PRELOAD_SLOTS_MAX; ++i) {
+            uint32_t state = PreloadSlot::FREE;
+            if (__atomic_compare_exchange_n(&slots[i].state, &state, PreloadSlot::initializing(), false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return initialize(slots[i], name, seed);
+            }
+            state = wait(slots[i]);
+            // reclaim the slot of a dead process
+            if (state != PreloadSlot::READY &&
+                __atomic_compare_exchange_n(&slots[i].state, &state, PreloadSlot::initializing(), false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return initialize(slots[i], name, seed);
+            }
+            if (state == PreloadSlot::READY && isName(slots[i], name)) {
+                return &slots[i];
+            }
+        }
+        return NULL;
+    }
+
+  private:
+    static PreloadSlot* initialize(PreloadSlot& slot, const char* name, uint64_t seed) {
+        size_t size = 0;
+        while (name[size] != '\0' && size < MOCKF_PRELOAD_NAME_MAX - 1) {
+            slot.name[size] = name[size];
+            ++size;
+        }
+        slot.name[size] = '\0';
+        new (&slot.policy) Policy(seed, false);
+        __atomic_store_n(&slot.state, static_cast<uint32_t>(PreloadSlot::READY), __ATOMIC_RELEASE);
+        return &slot;
+    }
+
+    // wait the end of initialization of slot (the state of a dead process is returned)
+    static uint32_t wait(PreloadSlot& slot) {
+        uint32_t state = __atomic_load_n(&slot.state, __ATOMIC_ACQUIRE);
+        while ((state & PreloadSlot::INITIALIZING) != 0 && !PreloadSlot::isStale(state)) {
+            sched_yield();
+            state = __atomic_load_n(&slot.state, __ATOMIC_ACQUIRE);
+        }
+        return state;
+    }
+
+    static bool isName(const PreloadSlot& slot, const char* name) {
+        size_t size = 0;
+        while (name[size] != '\0' && size < MOCKF_PRELOAD_NAME_MAX - 1) {
+            if (slot.name[size] != name[size]) {
+                return false;
+            }
+            ++size;
+        }
+        return slot.name[size] == '\0';
+    }
+};
+
+/**
+ * @brief Mapping of the control block in shared memory (/dev/shm)
+ * Attach mode binds the policies of slots to the mocks of the process, control mode only maps the block.
+ * The shared memory is managed with syscall for never use a mocked function.
+ */
+class Preload {
+  public:
+    enum Mode {
+        ATTACH,
+        CONTROL
+    };
+
+    Preload(const char* name, Mode mode) :
+        mode_(mode),
+        control_(NULL) {
+        std::string path = "/dev/shm/";
+        path += (name[0] == '/' ? name + 1 : name);
+        int fd = static_cast<int>(::syscall(SYS_openat, AT_FDCWD, path.c_str(), O_RDWR | O_CREAT, 0600));
+        if (fd < 0) {
+            throw PreloadError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        // the block of a new shared memory is filled by 0 (free slots)
+        if (::syscall(SYS_ftruncate, fd, sizeof(PreloadControl)) != 0) {
+            ::syscall(SYS_close, fd);
+            throw PreloadError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        void* map = ::mmap(NULL, sizeof(PreloadControl), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::syscall(SYS_close, fd);
+        if (map == MAP_FAILED) {
+            throw PreloadError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        control_ = static_cast<PreloadControl*>(map);
+        if (__atomic_load_n(&control_->version, __ATOMIC_ACQUIRE) == 0) {
+            memcpy(control_->magic, magic(), sizeof(control_->magic));
+            uint32_t expected = 0;
+            __atomic_compare_exchange_n(&control_->version, &expected, version(), false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE);
+        }
+        if (__atomic_load_n(&control_->version, __ATOMIC_ACQUIRE) != version() ||
+            !Symbols::isEqual(control_->magic, magic())) {
+            ::munmap(control_, sizeof(PreloadControl));
+            throw PreloadError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        if (mode_ == ATTACH) {
+            const char* seed = getenv("MOCKF_PRELOAD_SEED");
+            for (unsigned int i = 0; i < Symbols::size(); ++i) {
+                PreloadSlot* slot = control_->acquire(Symbols::entries()[i].name,
+                                                      seed == NULL ? 0 : strtoull(seed, NULL, 10));
+                if (slot != NULL) {
+                    Symbols::entries()[i].policy(&slot->policy);
+                }
+            }
+        }
+    }
+
+    ~Preload() {
+        if (mode_ == ATTACH) {
+            for (unsigned int i = 0; i < Symbols::size(); ++i) {
+                Symbols::entries()[i].policy(NULL);
+            }
+        }
+        ::munmap(control_, sizeof(PreloadControl));
+    }
+
+    PreloadControl& control() {
+        return *control_;
+    }
+
+    /**
+     * @brief Name of shared memory from the MOCKF_PRELOAD_SHM environment variable
+     */
+    static const char* environmentName() {
+        const char* name = getenv("MOCKF_PRELOAD_SHM");
+        return name == NULL ? MOCKF_PRELOAD_DEFAULT_SHM : name;
+    }
+
+    /**
+     * @brief Remove the shared memory
+     */
+    static bool unlink(const char* name) {
+        std::string path = "/dev/shm/";
+        path += (name[0] == '/' ? name + 1 : name);
+        return ::syscall(SYS_unlinkat, AT_FDCWD, path.c_str(), 0) == 0;
+    }
+
+  private:
+    Preload(const Preload&);            // disable copy
+    Preload& operator=(const Preload&); // disable copy
+
+    static const char* magic() {
+        return "MOCKFPL";
+    }
+
+    static uint32_t version() {
+        return 2;
+    }
+
+    Mode mode_;
+    PreloadControl* control_;
+};
+
+/**
+ * @brief Attach the mocks at the construction without throw
+ */
+struct PreloadAttach {
+    PreloadAttach() :
+        preload(NULL) {
+        try {
+            preload = new Preload(Preload::environmentName(), Preload::ATTACH);
+        }
+        catch (const Exception& e) {
+            fprintf(stderr, "%s\n", e.what());
+        }
+    }
+    ~PreloadAttach() {
+        delete preload;
+    }
+    Preload* preload;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_PRELOAD_H_
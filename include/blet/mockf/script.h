@@ -0,0 +1,895 @@
+/**
+ * mockf/script.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_SCRIPT_H_
+#define BLET_MOCKF_SCRIPT_H_
+
+#include <errno.h>  // errno
+#include <stdint.h> // int64_t, intptr_t
+#include <string.h> // memcpy
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Expect the calls of a script of steps consumed in order (constant time by call)
+ * The mock is not usable with a variadic function.
+ * @param name Name of function
+ * @param container Container of blet::mockf::ScriptStep
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_EXPECT_SCRIPT(name, container)                                            \
+    EXPECT_CALL(MOCKF_INSTANCE(name), name)                                             \
+        .Times(::blet::mockf::ScriptHandler<MOCKF_CLASS(name)>::script().load(          \
+            MOCKF_CLASS(name)::functionName(), (container).begin(), (container).end())) \
+        .WillRepeatedly(::testing::Invoke(&::blet::mockf::ScriptHandler<MOCKF_CLASS(name)>::call))
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Step of script: matches of arguments, outputs and result
+ */
+struct ScriptStep {
+    /**
+     * @brief Match of an argument (integral value or bytes pointed)
+     */
+    struct Match {
+        unsigned int index;
+        bool isData;
+        int64_t value;
+        std::string data;
+    };
+    /**
+     * @brief Bytes copied in a pointer argument
+     */
+    struct Output {
+        unsigned int index;
+        std::string data;
+    };
+
+    ScriptStep() :
+        result(0),
+        error(0) {}
+
+    /**
+     * @brief Expect the value of an argument
+     */
+    ScriptStep& arg(unsigned int index, int64_t value) {
+        Match match;
+        match.index = index;
+        match.isData = false;
+        match.value = value;
+        matches.push_back(match);
+        return *this;
+    }
+
+    /**
+     * @brief Expect the bytes pointed by an argument
+     */
+    ScriptStep& data(unsigned int index, const void* data, size_t size) {
+        Match match;
+        match.index = index;
+        match.isData = true;
+        match.value = 0;
+        match.data.assign(static_cast<const char*>(data), size);
+        matches.push_back(match);
+        return *this;
+    }
+
+    /**
+     * @brief Copy bytes in a pointer argument
+     */
+    ScriptStep& output(unsigned int index, const void* data, size_t size) {
+        Output out;
+        out.index = index;
+        out.data.assign(static_cast<const char*>(data), size);
+        outputs.push_back(out);
+        return *this;
+    }
+
+    /**
+     * @brief Result and errno (if not 0) of call
+     */
+    ScriptStep& returns(int64_t value, int errorValue = 0) {
+        result = value;
+        error = errorValue;
+        return *this;
+    }
+
+    std::vector<Match> matches;
+    std::vector<Output> outputs;
+    int64_t result;
+    int error;
+};
+
+/**
+ * @brief Capacity of a buffer argument: the value of the next argument (read, write, recv, send, getcwd, readlink)
+ */
+static const size_t SCRIPT_BUFFER_CAPACITY = static_cast<size_t>(-1);
+
+/**
+ * @brief Arguments of a call of script
+ * Integral argument: value, pointer: address and bytes, not const pointer: output,
+ * bytes accessible at a pointer: sizeof(*pointer), length of string or next argument for a buffer
+ * @tparam A Type of argument
+ */
+template<typename A>
+struct ScriptArgument {
+    static int64_t value(const A& a) {
+        return static_cast<int64_t>(a);
+    }
+    static const void* input(const A& /* a */) {
+        return NULL;
+    }
+    static void* output(const A& /* a */) {
+        return NULL;
+    }
+    static size_t capacity(const A& /* a */) {
+        return 0;
+    }
+};
+
+template<typename A>
+struct ScriptArgument<const A*> {
+    static int64_t value(const A* a) {
+        return static_cast<int64_t>(reinterpret_cast<intptr_t>(a));
+    }
+    static const void* input(const A* a) {
+        return a;
+    }
+    static void* output(const A* /* a */) {
+        return NULL;
+    }
+    static size_t capacity(const A* /* a */) {
+        return sizeof(A);
+    }
+};
+
+template<typename A>
+struct ScriptArgument<A*> {
+    static int64_t value(A* a) {
+        return static_cast<int64_t>(reinterpret_cast<intptr_t>(a));
+    }
+    static const void* input(A* a) {
+        return a;
+    }
+    static void* output(A* a) {
+        return a;
+    }
+    static size_t capacity(A* /* a */) {
+        return sizeof(A);
+    }
+};
+
+template<typename A>
+struct ScriptBufferArgument {
+    static int64_t value(A a) {
+        return static_cast<int64_t>(reinterpret_cast<intptr_t>(a));
+    }
+    static const void* input(A a) {
+        return a;
+    }
+    static void* output(A a) {
+        return a;
+    }
+    static size_t capacity(A /* a */) {
+        return SCRIPT_BUFFER_CAPACITY;
+    }
+};
+
+template<>
+struct ScriptArgument<void*> : ScriptBufferArgument<void*> {};
+
+template<>
+struct ScriptArgument<char*> : ScriptBufferArgument<char*> {};
+
+template<>
+struct ScriptArgument<const void*> {
+    static int64_t value(const void* a) {
+        return static_cast<int64_t>(reinterpret_cast<intptr_t>(a));
+    }
+    static const void* input(const void* a) {
+        return a;
+    }
+    static void* output(const void* /* a */) {
+        return NULL;
+    }
+    static size_t capacity(const void* /* a */) {
+        return SCRIPT_BUFFER_CAPACITY;
+    }
+};
+
+template<>
+struct ScriptArgument<const char*> {
+    static int64_t value(const char* a) {
+        return static_cast<int64_t>(reinterpret_cast<intptr_t>(a));
+    }
+    static const void* input(const char* a) {
+        return a;
+    }
+    static void* output(const char* /* a */) {
+        return NULL;
+    }
+    // without strlen (can be mocked)
+    static size_t capacity(const char* a) {
+        size_t size = 0;
+        if (a != NULL) {
+            while (a[size] != '\0') {
+                ++size;
+            }
+            ++size;
+        }
+        return size;
+    }
+};
+
+/**
+ * @brief Result of a call of script
+ * @tparam R Return type of function
+ */
+template<typename R>
+struct ScriptResult {
+    static R cast(int64_t result) {
+        return static_cast<R>(result);
+    }
+};
+
+template<typename R>
+struct ScriptResult<R*> {
+    static R* cast(int64_t result) {
+        return reinterpret_cast<R*>(static_cast<intptr_t>(result));
+    }
+};
+
+template<>
+struct ScriptResult<void> {
+    static void cast(int64_t /* result */) {}
+};
+
+/**
+ * @brief Steps of script of a mock
+ */
+class Script {
+  public:
+    Script() :
+        name_(""),
+        index_(0) {}
+
+    /**
+     * @brief Replace the steps
+     * @return int Number of steps
+     */
+    template<typename Iterator>
+    int load(const char* name, Iterator begin, Iterator end) {
+        name_ = name;
+        steps_.assign(begin, end);
+        __atomic_store_n(&index_, 0, __ATOMIC_RELEASE);
+        return static_cast<int>(steps_.size());
+    }
+
+    /**
+     * @brief Consume the next step: check the arguments, copy the outputs (bounded by their capacity) and set errno
+     * The outputs are not copied when the arguments do not match.
+     * @return int64_t Result of step
+     */
+    int64_t call(const int64_t* values, const void* const* inputs, void* const* outputs, const size_t* capacities,
+                 unsigned int nbArgument) {
+        size_t index = __atomic_fetch_add(&index_, 1, __ATOMIC_ACQ_REL);
+        if (index >= steps_.size()) {
+            ADD_FAILURE() << "MockF '" << name_ << "' script: call " << index + 1 << " after the last step "
+                          << steps_.size() << ".";
+            return 0;
+        }
+        const ScriptStep& step = steps_[index];
+        std::string diff;
+        for (size_t i = 0; i < step.matches.size(); ++i) {
+            diff += compare(step.matches[i], values, inputs, capacities, nbArgument);
+        }
+        if (!diff.empty()) {
+            ADD_FAILURE() << "MockF '" << name_ << "' script: step " << index + 1 << "/" << steps_.size()
+                          << " mismatch\n"
+                          << diff;
+        }
+        else {
+            for (size_t i = 0; i < step.outputs.size(); ++i) {
+                const ScriptStep::Output& out = step.outputs[i];
+                if (out.index < nbArgument && outputs[out.index] != NULL) {
+                    size_t size = capacity(out.index, values, capacities, nbArgument);
+                    memcpy(outputs[out.index], out.data.data(), out.data.size() < size ? out.data.size() : size);
+                }
+            }
+        }
+        if (step.error != 0) {
+            errno = step.error;
+        }
+        return step.result;
+    }
+
+    /**
+     * @brief Number of consumed steps
+     */
+    size_t index() const {
+        return __atomic_load_n(&index_, __ATOMIC_ACQUIRE);
+    }
+
+  private:
+    // bytes accessible at the pointer of argument
+    static size_t capacity(unsigned int index, const int64_t* values, const size_t* capacities,
+                           unsigned int nbArgument) {
+        if (capacities[index] != SCRIPT_BUFFER_CAPACITY) {
+            return capacities[index];
+        }
+        if (index + 1 >= nbArgument || values[index + 1] < 0) {
+            return 0;
+        }
+        return static_cast<size_t>(values[index + 1]);
+    }
+
+    static std::string compare(const ScriptStep::Match& match, const int64_t* values, const void* const* inputs,
+                               const size_t* capacities, unsigned int nbArgument) {
+        std::ostringstream oss;
+        if (match.index >= nbArgument) {
+            oss << "  argument " << match.index << ": not found (" << nbArgument << " arguments)\n";
+        }
+        else if (!match.isData) {
+            if (values[match.index] != match.value) {
+                oss << "  argument " << match.index << ": expected " << match.value << ", actual "
+                    << values[match.index] << "\n";
+            }
+        }
+        else if (inputs[match.index] == NULL) {
+            oss << "  argument " << match.index << ": expected " << escape(match.data.data(), match.data.size())
+                << ", actual NULL\n";
+        }
+        else {
+            const char* actual = static_cast<const char*>(inputs[match.index]);
+            size_t size = capacity(match.index, values, capacities, nbArgument);
+            if (size > match.data.size()) {
+                size = match.data.size();
+            }
+            size_t offset = 0;
+            while (offset < size && actual[offset] == match.data[offset]) {
+                ++offset;
+            }
+            if (offset < match.data.size()) {
+                oss << "  argument " << match.index << ": differ at byte " << offset << "\n"
+                    << "    expected " << escape(match.data.data(), match.data.size()) << "\n"
+                    << "    actual   " << escape(actual, size) << "\n";
+            }
+        }
+        return oss.str();
+    }
+
+    // printable string of the first bytes
+    static std::string escape(const char* data, size_t size) {
+        static const size_t MAX_SIZE = 32;
+        static const char HEX[] = "0123456789abcdef";
+        std::string str = "\"";
+        for (size_t i = 0; i < size && i < MAX_SIZE; ++i) {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c >= 0x20 && c < 0x7f && c != '"' && c != '\\') {
+                str += static_cast<char>(c);
+            }
+            else {
+                str += "\\x";
+                str += HEX[c >> 4];
+                str += HEX[c & 0xf];
+            }
+        }
+        str += "\"";
+        if (size > MAX_SIZE) {
+            str += "...";
+        }
+        return str;
+    }
+
+    const char* name_;
+    std::vector<ScriptStep> steps_;
+    size_t index_;
+};
+
+/**
+ * @brief Action of script of a mock
+ * @tparam T Mockf class
+ * @tparam F Function pointer type of mock
+ */
+template<typename T, typename F = typename T::function_t>
+struct ScriptHandler;
+
+#if __cplusplus >= 201103L
+
+template<typename T, typename R, typename... A>
+struct ScriptHandler<T, R (*)(A...)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A... a) {
+        const int64_t values[sizeof...(A) + 1] = {ScriptArgument<A>::value(a)..., 0};
+        const void* const inputs[sizeof...(A) + 1] = {ScriptArgument<A>::input(a)..., NULL};
+        void* const outputs[sizeof...(A) + 1] = {ScriptArgument<A>::output(a)..., NULL};
+        const size_t capacities[sizeof...(A) + 1] = {ScriptArgument<A>::capacity(a)..., 0};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, sizeof...(A)));
+    }
+};
+
+#else
+
+template<typename T, typename R>
+struct ScriptHandler<T, R (*)()> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call() {
+        return ScriptResult<R>::cast(script().call(NULL, NULL, NULL, NULL, 0));
+    }
+};
+
+template<typename T, typename R, typename A1>
+struct ScriptHandler<T, R (*)(A1)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1) {
+        const int64_t values[1] = {ScriptArgument<A1>::value(a1)};
+        const void* const inputs[1] = {ScriptArgument<A1>::input(a1)};
+        void* const outputs[1] = {ScriptArgument<A1>::output(a1)};
+        const size_t capacities[1] = {ScriptArgument<A1>::capacity(a1)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 1));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2>
+struct ScriptHandler<T, R (*)(A1, A2)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2) {
+        const int64_t values[2] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2)};
+        const void* const inputs[2] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2)};
+        void* const outputs[2] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2)};
+        const size_t capacities[2] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 2));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3>
+struct ScriptHandler<T, R (*)(A1, A2, A3)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3) {
+        const int64_t values[3] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3)};
+        const void* const inputs[3] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3)};
+        void* const outputs[3] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3)};
+        const size_t capacities[3] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 3));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4) {
+        const int64_t values[4] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4)};
+        const void* const inputs[4] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4)};
+        void* const outputs[4] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4)};
+        const size_t capacities[4] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 4));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
+        const int64_t values[5] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                   ScriptArgument<A5>::value(a5)};
+        const void* const inputs[5] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                       ScriptArgument<A5>::input(a5)};
+        void* const outputs[5] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                  ScriptArgument<A5>::output(a5)};
+        const size_t capacities[5] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                      ScriptArgument<A5>::capacity(a5)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 5));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6) {
+        const int64_t values[6] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                   ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6)};
+        const void* const inputs[6] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                       ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6)};
+        void* const outputs[6] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                  ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6)};
+        const size_t capacities[6] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                      ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 6));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7) {
+        const int64_t values[7] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                   ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                   ScriptArgument<A7>::value(a7)};
+        const void* const inputs[7] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                       ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                       ScriptArgument<A7>::input(a7)};
+        void* const outputs[7] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                  ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                  ScriptArgument<A7>::output(a7)};
+        const size_t capacities[7] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                      ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                      ScriptArgument<A7>::capacity(a7)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 7));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8) {
+        const int64_t values[8] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                   ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                   ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8)};
+        const void* const inputs[8] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                       ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                       ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8)};
+        void* const outputs[8] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                  ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                  ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8)};
+        const size_t capacities[8] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                      ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                      ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 8));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9) {
+        const int64_t values[9] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                   ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                   ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                   ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                   ScriptArgument<A9>::value(a9)};
+        const void* const inputs[9] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                       ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                       ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                       ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                       ScriptArgument<A9>::input(a9)};
+        void* const outputs[9] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                  ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                  ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                  ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                  ScriptArgument<A9>::output(a9)};
+        const size_t capacities[9] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                      ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                      ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                      ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                      ScriptArgument<A9>::capacity(a9)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 9));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10) {
+        const int64_t values[10] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10)};
+        const void* const inputs[10] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10)};
+        void* const outputs[10] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10)};
+        const size_t capacities[10] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 10));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11) {
+        const int64_t values[11] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10),
+                                    ScriptArgument<A11>::value(a11)};
+        const void* const inputs[11] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10),
+                                        ScriptArgument<A11>::input(a11)};
+        void* const outputs[11] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10),
+                                   ScriptArgument<A11>::output(a11)};
+        const size_t capacities[11] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10),
+                                       ScriptArgument<A11>::capacity(a11)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 11));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12) {
+        const int64_t values[12] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10),
+                                    ScriptArgument<A11>::value(a11), ScriptArgument<A12>::value(a12)};
+        const void* const inputs[12] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10),
+                                        ScriptArgument<A11>::input(a11), ScriptArgument<A12>::input(a12)};
+        void* const outputs[12] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10),
+                                   ScriptArgument<A11>::output(a11), ScriptArgument<A12>::output(a12)};
+        const size_t capacities[12] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10),
+                                       ScriptArgument<A11>::capacity(a11), ScriptArgument<A12>::capacity(a12)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 12));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13) {
+        const int64_t values[13] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10),
+                                    ScriptArgument<A11>::value(a11), ScriptArgument<A12>::value(a12),
+                                    ScriptArgument<A13>::value(a13)};
+        const void* const inputs[13] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10),
+                                        ScriptArgument<A11>::input(a11), ScriptArgument<A12>::input(a12),
+                                        ScriptArgument<A13>::input(a13)};
+        void* const outputs[13] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10),
+                                   ScriptArgument<A11>::output(a11), ScriptArgument<A12>::output(a12),
+                                   ScriptArgument<A13>::output(a13)};
+        const size_t capacities[13] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10),
+                                       ScriptArgument<A11>::capacity(a11), ScriptArgument<A12>::capacity(a12),
+                                       ScriptArgument<A13>::capacity(a13)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 13));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                  A14 a14) {
+        const int64_t values[14] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10),
+                                    ScriptArgument<A11>::value(a11), ScriptArgument<A12>::value(a12),
+                                    ScriptArgument<A13>::value(a13), ScriptArgument<A14>::value(a14)};
+        const void* const inputs[14] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10),
+                                        ScriptArgument<A11>::input(a11), ScriptArgument<A12>::input(a12),
+                                        ScriptArgument<A13>::input(a13), ScriptArgument<A14>::input(a14)};
+        void* const outputs[14] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10),
+                                   ScriptArgument<A11>::output(a11), ScriptArgument<A12>::output(a12),
+                                   ScriptArgument<A13>::output(a13), ScriptArgument<A14>::output(a14)};
+        const size_t capacities[14] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10),
+                                       ScriptArgument<A11>::capacity(a11), ScriptArgument<A12>::capacity(a12),
+                                       ScriptArgument<A13>::capacity(a13), ScriptArgument<A14>::capacity(a14)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 14));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14,
+         typename A15>
+struct ScriptHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15)> {
+    static Script& script() {
+        static Script instance;
+        return instance;
+    }
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                  A14 a14, A15 a15) {
+        const int64_t values[15] = {ScriptArgument<A1>::value(a1), ScriptArgument<A2>::value(a2),
+                                    ScriptArgument<A3>::value(a3), ScriptArgument<A4>::value(a4),
+                                    ScriptArgument<A5>::value(a5), ScriptArgument<A6>::value(a6),
+                                    ScriptArgument<A7>::value(a7), ScriptArgument<A8>::value(a8),
+                                    ScriptArgument<A9>::value(a9), ScriptArgument<A10>::value(a10),
+                                    ScriptArgument<A11>::value(a11), ScriptArgument<A12>::value(a12),
+                                    ScriptArgument<A13>::value(a13), ScriptArgument<A14>::value(a14),
+                                    ScriptArgument<A15>::value(a15)};
+        const void* const inputs[15] = {ScriptArgument<A1>::input(a1), ScriptArgument<A2>::input(a2),
+                                        ScriptArgument<A3>::input(a3), ScriptArgument<A4>::input(a4),
+                                        ScriptArgument<A5>::input(a5), ScriptArgument<A6>::input(a6),
+                                        ScriptArgument<A7>::input(a7), ScriptArgument<A8>::input(a8),
+                                        ScriptArgument<A9>::input(a9), ScriptArgument<A10>::input(a10),
+                                        ScriptArgument<A11>::input(a11), ScriptArgument<A12>::input(a12),
+                                        ScriptArgument<A13>::input(a13), ScriptArgument<A14>::input(a14),
+                                        ScriptArgument<A15>::input(a15)};
+        void* const outputs[15] = {ScriptArgument<A1>::output(a1), ScriptArgument<A2>::output(a2),
+                                   ScriptArgument<A3>::output(a3), ScriptArgument<A4>::output(a4),
+                                   ScriptArgument<A5>::output(a5), ScriptArgument<A6>::output(a6),
+                                   ScriptArgument<A7>::output(a7), ScriptArgument<A8>::output(a8),
+                                   ScriptArgument<A9>::output(a9), ScriptArgument<A10>::output(a10),
+                                   ScriptArgument<A11>::output(a11), ScriptArgument<A12>::output(a12),
+                                   ScriptArgument<A13>::output(a13), ScriptArgument<A14>::output(a14),
+                                   ScriptArgument<A15>::output(a15)};
+        const size_t capacities[15] = {ScriptArgument<A1>::capacity(a1), ScriptArgument<A2>::capacity(a2),
+                                       ScriptArgument<A3>::capacity(a3), ScriptArgument<A4>::capacity(a4),
+                                       ScriptArgument<A5>::capacity(a5), ScriptArgument<A6>::capacity(a6),
+                                       ScriptArgument<A7>::capacity(a7), ScriptArgument<A8>::capacity(a8),
+                                       ScriptArgument<A9>::capacity(a9), ScriptArgument<A10>::capacity(a10),
+                                       ScriptArgument<A11>::capacity(a11), ScriptArgument<A12>::capacity(a12),
+                                       ScriptArgument<A13>::capacity(a13), ScriptArgument<A14>::capacity(a14),
+                                       ScriptArgument<A15>::capacity(a15)};
+        return ScriptResult<R>::cast(script().call(values, inputs, outputs, capacities, 15));
+    }
+};
+
+#endif
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_SCRIPT_H_
@@ -0,0 +1,354 @@
+/**
+ * mockf/shared.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_SHARED_H_
+#define BLET_MOCKF_SHARED_H_
+
+#include <stdint.h>   // int64_t, uint64_t
+#include <sys/mman.h> // mmap, munmap
+#include <unistd.h>   // getpid
+
+#include <vector>
+
+#include "blet/mockf/core.h"
+
+/**
+ * @brief Get the calls of function counted in the shared memory (all processes)
+ * Counted only if MOCKF_ENABLE_SHARED is defined
+ * @param name Name of function
+ * @return blet::mockf::SharedStats
+ * @throw blet::mockf::SharedNotFound if no blet::mockf::Shared exists
+ */
+#define MOCKF_SHARED_STATS(name) ::blet::mockf::Shared::current(#name).stats(#name)
+/**
+ * @brief Get the calls of function recorded in the shared memory (all processes, in order)
+ * Recorded only if MOCKF_ENABLE_SHARED is defined
+ * @param name Name of function
+ * @return std::vector<blet::mockf::SharedRecord>
+ * @throw blet::mockf::SharedNotFound if no blet::mockf::Shared exists
+ */
+#define MOCKF_SHARED_RECORDS(name) ::blet::mockf::Shared::current(#name).records(#name)
+
+/**
+ * @brief Maximum number of mocks in the shared memory
+ */
+#ifndef MOCKF_SHARED_SLOTS_MAX
+#define MOCKF_SHARED_SLOTS_MAX 128
+#endif
+
+/**
+ * @brief Maximum number of recorded calls in the shared memory (the next calls are only counted)
+ */
+#ifndef MOCKF_SHARED_RECORDS_MAX
+#define MOCKF_SHARED_RECORDS_MAX 65536
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+struct SharedNotFound : public Exception {
+    SharedNotFound(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "shared memory not found.";
+    }
+};
+
+struct SharedError : public Exception {
+    SharedError(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "shared memory error.";
+    }
+};
+
+/**
+ * @brief Calls of a mock in all processes
+ */
+struct SharedStats {
+    uint64_t mocked;         // number of calls of mock
+    uint64_t passthrough;    // number of calls of real function (or handler)
+    uint64_t bytes;          // sum of the first size_t argument
+    uint64_t sizes[Stats::NB_SIZE]; // log2 histogram of the first size_t argument
+    uint64_t calls() const {
+        return mocked + passthrough;
+    }
+};
+
+/**
+ * @brief Call of a mock
+ */
+struct SharedRecord {
+    uint32_t state; // 0: writing, 1: done
+    uint32_t slot;  // index of mock
+    int32_t pid;
+    int32_t error;  // errno after the call
+    int64_t result; // integer result, address of pointer result, 0 otherwise
+    int64_t size;   // first size_t argument (-1 without)
+    bool isMocked;
+};
+
+struct SharedSlot {
+    uint32_t state; // 0: free, 1: initializing, 2: ready
+    char name[64];
+    SharedStats stats;
+};
+
+struct SharedBlock {
+    SharedSlot slots[MOCKF_SHARED_SLOTS_MAX];
+    uint64_t nbRecord;
+    SharedRecord records[MOCKF_SHARED_RECORDS_MAX];
+};
+
+/**
+ * @brief Call accounting in an anonymous shared mapping inherited by the forked processes
+ * The calls of the children (e.g. pre-forked workers) are visible by the parent for its verification.
+ * Define MOCKF_ENABLE_SHARED before the include of blet/mockf.h for count the calls of the fake functions.
+ */
+class Shared {
+  public:
+    Shared() :
+        block_(NULL) {
+        void* map = ::mmap(NULL, sizeof(SharedBlock), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            throw SharedError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), "shared");
+        }
+        block_ = static_cast<SharedBlock*>(map);
+        Shared* expected = NULL;
+        if (!__atomic_compare_exchange_n(&instance(), &expected, this, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            ::munmap(block_, sizeof(SharedBlock));
+            throw SharedError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), "shared");
+        }
+        __atomic_add_fetch(&generation(), 1, __ATOMIC_RELEASE);
+    }
+
+    ~Shared() {
+        __atomic_store_n(&instance(), static_cast<Shared*>(NULL), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&generation(), 1, __ATOMIC_RELEASE);
+        ::munmap(block_, sizeof(SharedBlock));
+    }
+
+    static Shared*& instance() {
+        static Shared* singleton = NULL;
+        return singleton;
+    }
+
+    static Shared& current(const char* name) {
+        Shared* shared = __atomic_load_n(&instance(), __ATOMIC_ACQUIRE);
+        if (shared == NULL) {
+            throw SharedNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        return *shared;
+    }
+
+    /**
+     * @brief Incremented at each construction and destruction (invalidate the slots cached by the mocks)
+     */
+    static uint64_t& generation() {
+        static uint64_t count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Calls of mock from name
+     */
+    SharedStats stats(const char* name) const {
+        SharedStats total = SharedStats();
+        const SharedSlot* slot = find(name);
+        if (slot != NULL) {
+            total.mocked = __atomic_load_n(&slot->stats.mocked, __ATOMIC_RELAXED);
+            total.passthrough = __atomic_load_n(&slot->stats.passthrough, __ATOMIC_RELAXED);
+            total.bytes = __atomic_load_n(&slot->stats.bytes, __ATOMIC_RELAXED);
+            for (unsigned int i = 0; i < Stats::NB_SIZE; ++i) {
+                total.sizes[i] = __atomic_load_n(&slot->stats.sizes[i], __ATOMIC_RELAXED);
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Recorded calls of mock from name (in order of call)
+     */
+    std::vector<SharedRecord> records(const char* name) const {
+        std::vector<SharedRecord> ret;
+        const SharedSlot* slot = find(name);
+        if (slot == NULL) {
+            return ret;
+        }
+        uint32_t index = static_cast<uint32_t>(slot - block_->slots);
+        uint64_t nbRecord = nbRecorded();
+        for (uint64_t i = 0; i < nbRecord; ++i) {
+            const SharedRecord& record = block_->records[i];
+            if (__atomic_load_n(&record.state, __ATOMIC_ACQUIRE) == 1 && record.slot == index) {
+                ret.push_back(record);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Number of recorded calls of all mocks (at most MOCKF_SHARED_RECORDS_MAX)
+     */
+    uint64_t nbRecorded() const {
+        uint64_t nbRecord = __atomic_load_n(&block_->nbRecord, __ATOMIC_ACQUIRE);
+        return nbRecord < MOCKF_SHARED_RECORDS_MAX ? nbRecord : MOCKF_SHARED_RECORDS_MAX;
+    }
+
+    /**
+     * @brief Find or create the slot of mock
+     * @return SharedSlot* Slot or NULL if the shared memory is full
+     */
+    SharedSlot* acquire(const char* name) {
+        for (unsigned int i = 0; i < MOCKF_SHARED_SLOTS_MAX; ++i) {
+            SharedSlot& slot = block_->slots[i];
+            uint32_t state = 0;
+            if (__atomic_compare_exchange_n(&slot.state, &state, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                size_t size = 0;
+                while (name[size] != '\0' && size < sizeof(slot.name) - 1) {
+                    slot.name[size] = name[size];
+                    ++size;
+                }
+                slot.name[size] = '\0';
+                __atomic_store_n(&slot.state, 2, __ATOMIC_RELEASE);
+                return &slot;
+            }
+            while (state == 1) {
+                state = __atomic_load_n(&slot.state, __ATOMIC_ACQUIRE);
+            }
+            if (Symbols::isEqual(slot.name, name)) {
+                return &slot;
+            }
+        }
+        return NULL;
+    }
+
+    /**
+     * @brief Count and record a call (called by the fake functions)
+     */
+    void add(SharedSlot* slot, bool isMocked, int64_t size, int64_t result, int error) {
+        __atomic_add_fetch(isMocked ? &slot->stats.mocked : &slot->stats.passthrough, 1, __ATOMIC_RELAXED);
+        if (size >= 0) {
+            __atomic_add_fetch(&slot->stats.bytes, static_cast<uint64_t>(size), __ATOMIC_RELAXED);
+            __atomic_add_fetch(&slot->stats.sizes[Stats::sizeIndex(static_cast<uint64_t>(size))], 1,
+                               __ATOMIC_RELAXED);
+        }
+        uint64_t index = __atomic_fetch_add(&block_->nbRecord, 1, __ATOMIC_ACQ_REL);
+        if (index < MOCKF_SHARED_RECORDS_MAX) {
+            SharedRecord& record = block_->records[index];
+            record.slot = static_cast<uint32_t>(slot - block_->slots);
+            record.pid = static_cast<int32_t>(::getpid());
+            record.error = error;
+            record.result = result;
+            record.size = size;
+            record.isMocked = isMocked;
+            __atomic_store_n(&record.state, 1, __ATOMIC_RELEASE);
+        }
+    }
+
+  private:
+    Shared(const Shared&);            // disable copy
+    Shared& operator=(const Shared&); // disable copy
+
+    const SharedSlot* find(const char* name) const {
+        for (unsigned int i = 0; i < MOCKF_SHARED_SLOTS_MAX; ++i) {
+            const SharedSlot& slot = block_->slots[i];
+            if (__atomic_load_n(&slot.state, __ATOMIC_ACQUIRE) != 2) {
+                break;
+            }
+            if (Symbols::isEqual(slot.name, name)) {
+                return &slot;
+            }
+        }
+        return NULL;
+    }
+
+    SharedBlock* block_;
+};
+
+/**
+ * @brief Call of a fake function counted in the shared memory at its end
+ * @tparam T Mock class
+ */
+template<typename T>
+class SharedCall : public CallRecorder<SharedCall<T> > {
+  public:
+    SharedCall(bool isMocked, int64_t size) :
+        shared_(NULL),
+        slot_(NULL),
+        isMocked_(isMocked),
+        size_(size),
+        result_(0) {
+        uint64_t generation = __atomic_load_n(&Shared::generation(), __ATOMIC_ACQUIRE);
+        Cache& cache = threadCache();
+        if (cache.generation != generation) {
+            // the slot is cached by thread until the next construction or destruction of blet::mockf::Shared
+            cache.shared = __atomic_load_n(&Shared::instance(), __ATOMIC_ACQUIRE);
+            cache.slot = cache.shared == NULL ? NULL : cache.shared->acquire(T::functionName());
+            cache.generation = generation;
+        }
+        shared_ = cache.shared;
+        slot_ = cache.slot;
+    }
+
+    ~SharedCall() {
+        if (slot_ != NULL) {
+            int error = errno;
+            shared_->add(slot_, isMocked_, size_, result_, error);
+            errno = error;
+        }
+    }
+
+    /**
+     * @brief Keep the result of call
+     */
+    template<typename R>
+    R result(R value) {
+        result_ = callValue(value).value;
+        return value;
+    }
+
+  private:
+    struct Cache {
+        uint64_t generation;
+        Shared* shared;
+        SharedSlot* slot;
+    };
+
+    static Cache& threadCache() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ Cache cache = {0, NULL, NULL};
+        return cache;
+    }
+
+    Shared* shared_;
+    SharedSlot* slot_;
+    bool isMocked_;
+    int64_t size_;
+    int64_t result_;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_SHARED_H_
@@ -0,0 +1,175 @@
+/**
+ * mockf/stub.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_STUB_H_
+#define BLET_MOCKF_STUB_H_
+
+#ifdef BLET_MOCKF_H_
+#error "blet/mockf.h and blet/mockf/stub.h cannot be used in the same translation unit"
+#endif
+
+#include "blet/mockf/core.h"
+
+/**
+ * @brief Set the stub called by the enabled instance of mock (without gmock)
+ * The stub of a variadic function takes a va_list in place of '...'.
+ * @param name Name of function
+ * @param callable Function pointer, functor or lambda (with capture since C++11)
+ * @throw blet::mockf::InstanceNotFound if instance of mockf is NULL
+ */
+#define MOCKF_STUB(name, callable) MOCKF_INSTANCE(name).stub.set(callable)
+
+namespace blet {
+
+namespace mockf {
+
+struct StubNotFound : public Exception {
+    StubNotFound(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "stub not found.";
+    }
+};
+
+/**
+ * @brief Callable of a stub (copy of a functor or a lambda)
+ * @tparam F Function pointer type
+ */
+template<typename F>
+struct StubTarget;
+
+#if __cplusplus >= 201103L
+
+template<typename R, typename... A>
+struct StubTarget<R (*)(A...)> {
+    StubTarget() :
+        next(NULL) {}
+    virtual ~StubTarget() {}
+    virtual R call(A... a) = 0;
+    StubTarget* next; // targets set in the stub
+};
+
+template<typename F, typename C>
+struct StubCallable;
+
+template<typename R, typename... A, typename C>
+struct StubCallable<R (*)(A...), C> : StubTarget<R (*)(A...)> {
+    explicit StubCallable(const C& c) :
+        callable(c) {}
+    R call(A... a) {
+        return callable(a...);
+    }
+    C callable;
+};
+
+#endif
+
+/**
+ * @brief Function called by the enabled instance of mock
+ * A function pointer is called directly, the other callables through a StubTarget (since C++11).
+ * The set is atomic: the calls of other threads use the previous or the new callable.
+ * @tparam F Function pointer type
+ */
+template<typename F>
+class Stub {
+  public:
+#if __cplusplus >= 201103L
+    Stub() :
+        function_(NULL),
+        target_(NULL),
+        targets_(NULL) {}
+    ~Stub() {
+        while (targets_ != NULL) {
+            StubTarget<F>* next = targets_->next;
+            delete targets_;
+            targets_ = next;
+        }
+    }
+#else
+    Stub() :
+        function_(NULL) {}
+#endif
+    F function() const {
+        return __atomic_load_n(&function_, __ATOMIC_ACQUIRE);
+    }
+#if __cplusplus >= 201103L
+    StubTarget<F>* target() const {
+        return __atomic_load_n(&target_, __ATOMIC_ACQUIRE);
+    }
+    void set(F function) {
+        __atomic_store_n(&function_, function, __ATOMIC_RELEASE);
+        __atomic_store_n(&target_, static_cast<StubTarget<F>*>(NULL), __ATOMIC_RELEASE);
+    }
+    template<typename C>
+    void set(const C& callable) {
+        // the previous targets are deleted with the stub (can be in use by other threads)
+        StubTarget<F>* target = new StubCallable<F, C>(callable);
+        target->next = targets_;
+        targets_ = target;
+        __atomic_store_n(&target_, target, __ATOMIC_RELEASE);
+        __atomic_store_n(&function_, static_cast<F>(NULL), __ATOMIC_RELEASE);
+    }
+#else
+    void set(F function) {
+        __atomic_store_n(&function_, function, __ATOMIC_RELEASE);
+    }
+#endif
+
+  private:
+    Stub(const Stub&);            // disable copy
+    Stub& operator=(const Stub&); // disable copy
+
+    F function_;
+#if __cplusplus >= 201103L
+    StubTarget<F>* target_;
+    StubTarget<F>* targets_;
+#endif
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#if __cplusplus >= 201103L
+#define MOCKF_INTERNAL_STUB_TARGET_(i, r, f)                                             \
+    ::blet::mockf::StubTarget<r(*) f>* mockf_target = stub.target();                     \
+    if (mockf_target != NULL) {                                                          \
+        return mockf_target->call(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_, f)); \
+    }
+#else
+#define MOCKF_INTERNAL_STUB_TARGET_(i, r, f)
+#endif
+
+#define MOCKF_INTERNAL_METHOD_(i, r, n, f)                                                    \
+    ::blet::mockf::Stub<r(*) f> stub;                                                         \
+    r n(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_DECLARATION_, r f)) {                 \
+        r(*mockf_function) f = stub.function();                                               \
+        if (mockf_function != NULL) {                                                         \
+            return mockf_function(MOCKF_INTERNAL_REPEAT_(i)(i, MOCKF_INTERNAL_ARG_, f));      \
+        }                                                                                     \
+        MOCKF_INTERNAL_STUB_TARGET_(i, r, f)                                                  \
+        throw ::blet::mockf::StubNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), #n); \
+    }
+
+#endif // #ifndef BLET_MOCKF_STUB_H_
@@ -0,0 +1,363 @@
+/**
+ * mockf/syscall.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLET_MOCKF_SYSCALL_H_
+#define BLET_MOCKF_SYSCALL_H_
+
+#include <dlfcn.h>  // dlsym
+#include <errno.h>  // ENOSYS
+#include <stdarg.h> // va_list
+#include <unistd.h> // syscall
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Define syscall with the dispatch table by number of syscall
+ * The numbers without route call the real syscall.
+ * Must be used in only one source file of a binary, at global scope
+ */
+#define MOCKF_SYSCALL_FUNCTION()                                 \
+    extern "C" long syscall(long number, ...) throw() {          \
+        long mockf_args[6];                                      \
+        va_list args;                                            \
+        va_start(args, number);                                  \
+        for (int i = 0; i < 6; ++i) {                            \
+            mockf_args[i] = va_arg(args, long);                  \
+        }                                                        \
+        va_end(args);                                            \
+        return ::blet::mockf::Syscall::call(number, mockf_args); \
+    }                                                            \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Route a number of syscall to the fake of a declared mock (e.g. SYS_write to write)
+ * @param number Number of syscall
+ * @param name Name of function declared by MOCKF_FUNCTION
+ */
+#define MOCKF_SYSCALL_ROUTE(number, name)                                                                      \
+    namespace blet {                                                                                           \
+    namespace mockf {                                                                                          \
+    static const SyscallRoute<MOCKF_CLASS(name)> MOCKF_INTERNAL_CAT_(mockf_syscall_route_##name##_, __LINE__)( \
+        number, static_cast<MOCKF_CLASS(name)::function_t>(&::name));                                          \
+    }                                                                                                          \
+    }                                                                                                          \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Declare a mock of a syscall without libc function (e.g. io_uring_enter)
+ * The disabled mock calls the real syscall, the number is routed to the mock.
+ * @param number Number of syscall
+ * @param return_type Return type of function
+ * @param name Name of the mock (a name of libc function is also mocked)
+ * @param arguments List of arguments enclose by parenthesis (6 arguments max)
+ */
+#define MOCKF_SYSCALL_FUNCTION0(number, return_type, name, arguments) \
+    MOCKF_FUNCTION0(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION1(number, return_type, name, arguments) \
+    MOCKF_FUNCTION1(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION2(number, return_type, name, arguments) \
+    MOCKF_FUNCTION2(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION3(number, return_type, name, arguments) \
+    MOCKF_FUNCTION3(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION4(number, return_type, name, arguments) \
+    MOCKF_FUNCTION4(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION5(number, return_type, name, arguments) \
+    MOCKF_FUNCTION5(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+#define MOCKF_SYSCALL_FUNCTION6(number, return_type, name, arguments) \
+    MOCKF_FUNCTION6(return_type, name, arguments);                    \
+    MOCKF_INTERNAL_SYSCALL_(number, name)
+
+#define MOCKF_INTERNAL_SYSCALL_(number, name)                                              \
+    namespace blet {                                                                       \
+    namespace mockf {                                                                      \
+    static const SyscallFunction<MOCKF_CLASS(name), number> mockf_syscall_function_##name( \
+        static_cast<MOCKF_CLASS(name)::function_t>(&::name));                              \
+    }                                                                                      \
+    }                                                                                      \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Size of the dispatch table (the greater numbers are not routable)
+ */
+#ifndef MOCKF_SYSCALL_MAX
+#define MOCKF_SYSCALL_MAX 512
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Dispatch table of syscall by number
+ */
+class Syscall {
+  public:
+    typedef long (*route_t)(const long* args);
+    typedef long (*syscall_t)(long number, ...);
+
+    /**
+     * @brief Call the route of the number or the real syscall
+     */
+    static long call(long number, const long* args) {
+        if (number >= 0 && number < MOCKF_SYSCALL_MAX) {
+            route_t route = __atomic_load_n(&routes()[number], __ATOMIC_ACQUIRE);
+            if (route != NULL) {
+                return route(args);
+            }
+        }
+        return real(number, args);
+    }
+
+    /**
+     * @brief Call the real syscall with 6 arguments
+     */
+    static long real(long number, const long* args) {
+        static syscall_t realSyscall = reinterpret_cast<syscall_t>(dlsym(RTLD_NEXT, "syscall"));
+        if (realSyscall == NULL) {
+            errno = ENOSYS;
+            return -1;
+        }
+        return realSyscall(number, args[0], args[1], args[2], args[3], args[4], args[5]);
+    }
+
+    /**
+     * @brief Set the route of a number (NULL: real syscall)
+     * @return false if the number is not routable
+     */
+    static bool setRoute(long number, route_t route) {
+        if (number < 0 || number >= MOCKF_SYSCALL_MAX) {
+            return false;
+        }
+        __atomic_store_n(&routes()[number], route, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    static route_t route(long number) {
+        if (number < 0 || number >= MOCKF_SYSCALL_MAX) {
+            return NULL;
+        }
+        return __atomic_load_n(&routes()[number], __ATOMIC_ACQUIRE);
+    }
+
+  private:
+    static route_t* routes() {
+        static route_t table[MOCKF_SYSCALL_MAX] = {NULL};
+        return table;
+    }
+};
+
+/**
+ * @brief Conversion between the long of syscall and the types of function (integer or pointer)
+ */
+template<typename T>
+struct SyscallCast {
+    static T from(long value) {
+        return static_cast<T>(value);
+    }
+    static long to(T value) {
+        return static_cast<long>(value);
+    }
+};
+
+template<typename T>
+struct SyscallCast<T*> {
+    static T* from(long value) {
+        return reinterpret_cast<T*>(value);
+    }
+    static long to(T* value) {
+        return reinterpret_cast<long>(value);
+    }
+};
+
+/**
+ * @brief Call a function with the arguments of syscall
+ */
+template<typename F>
+struct SyscallInvoke;
+
+template<typename R>
+struct SyscallInvoke<R (*)()> {
+    static long call(R (*f)(), const long* /* args */) {
+        return SyscallCast<R>::to(f());
+    }
+};
+
+template<typename R, typename A1>
+struct SyscallInvoke<R (*)(A1)> {
+    static long call(R (*f)(A1), const long* args) {
+        return SyscallCast<R>::to(f(SyscallCast<A1>::from(args[0])));
+    }
+};
+
+template<typename R, typename A1, typename A2>
+struct SyscallInvoke<R (*)(A1, A2)> {
+    static long call(R (*f)(A1, A2), const long* args) {
+        return SyscallCast<R>::to(f(SyscallCast<A1>::from(args[0]), SyscallCast<A2>::from(args[1])));
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3>
+struct SyscallInvoke<R (*)(A1, A2, A3)> {
+    static long call(R (*f)(A1, A2, A3), const long* args) {
+        return SyscallCast<R>::to(
+            f(SyscallCast<A1>::from(args[0]), SyscallCast<A2>::from(args[1]), SyscallCast<A3>::from(args[2])));
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4>
+struct SyscallInvoke<R (*)(A1, A2, A3, A4)> {
+    static long call(R (*f)(A1, A2, A3, A4), const long* args) {
+        return SyscallCast<R>::to(f(SyscallCast<A1>::from(args[0]), SyscallCast<A2>::from(args[1]),
+                                    SyscallCast<A3>::from(args[2]), SyscallCast<A4>::from(args[3])));
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct SyscallInvoke<R (*)(A1, A2, A3, A4, A5)> {
+    static long call(R (*f)(A1, A2, A3, A4, A5), const long* args) {
+        return SyscallCast<R>::to(f(SyscallCast<A1>::from(args[0]), SyscallCast<A2>::from(args[1]),
+                                    SyscallCast<A3>::from(args[2]), SyscallCast<A4>::from(args[3]),
+                                    SyscallCast<A5>::from(args[4])));
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct SyscallInvoke<R (*)(A1, A2, A3, A4, A5, A6)> {
+    static long call(R (*f)(A1, A2, A3, A4, A5, A6), const long* args) {
+        return SyscallCast<R>::to(f(SyscallCast<A1>::from(args[0]), SyscallCast<A2>::from(args[1]),
+                                    SyscallCast<A3>::from(args[2]), SyscallCast<A4>::from(args[3]),
+                                    SyscallCast<A5>::from(args[4]), SyscallCast<A6>::from(args[5])));
+    }
+};
+
+/**
+ * @brief Real function of a syscall mock: call the real syscall with the number
+ */
+template<long N, typename F>
+struct SyscallReal;
+
+template<long N, typename R>
+struct SyscallReal<N, R (*)()> {
+    static R call() {
+        long args[6] = {0, 0, 0, 0, 0, 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1>
+struct SyscallReal<N, R (*)(A1)> {
+    static R call(A1 a1) {
+        long args[6] = {SyscallCast<A1>::to(a1), 0, 0, 0, 0, 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1, typename A2>
+struct SyscallReal<N, R (*)(A1, A2)> {
+    static R call(A1 a1, A2 a2) {
+        long args[6] = {SyscallCast<A1>::to(a1), SyscallCast<A2>::to(a2), 0, 0, 0, 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1, typename A2, typename A3>
+struct SyscallReal<N, R (*)(A1, A2, A3)> {
+    static R call(A1 a1, A2 a2, A3 a3) {
+        long args[6] = {SyscallCast<A1>::to(a1), SyscallCast<A2>::to(a2), SyscallCast<A3>::to(a3), 0, 0, 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1, typename A2, typename A3, typename A4>
+struct SyscallReal<N, R (*)(A1, A2, A3, A4)> {
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4) {
+        long args[6] = {SyscallCast<A1>::to(a1), SyscallCast<A2>::to(a2), SyscallCast<A3>::to(a3),
+                        SyscallCast<A4>::to(a4), 0, 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct SyscallReal<N, R (*)(A1, A2, A3, A4, A5)> {
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
+        long args[6] = {SyscallCast<A1>::to(a1), SyscallCast<A2>::to(a2), SyscallCast<A3>::to(a3),
+                        SyscallCast<A4>::to(a4), SyscallCast<A5>::to(a5), 0};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+template<long N, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct SyscallReal<N, R (*)(A1, A2, A3, A4, A5, A6)> {
+    static R call(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6) {
+        long args[6] = {SyscallCast<A1>::to(a1), SyscallCast<A2>::to(a2), SyscallCast<A3>::to(a3),
+                        SyscallCast<A4>::to(a4), SyscallCast<A5>::to(a5), SyscallCast<A6>::to(a6)};
+        return SyscallCast<R>::from(Syscall::real(N, args));
+    }
+};
+
+/**
+ * @brief Route a number to the fake function of a mock at load time
+ * @tparam T Mockf class
+ */
+template<typename T>
+struct SyscallRoute {
+    SyscallRoute(long number, typename T::function_t fake) {
+        __atomic_store_n(&function(), fake, __ATOMIC_RELEASE);
+        Syscall::setRoute(number, &SyscallRoute::call);
+    }
+    static typename T::function_t& function() {
+        static typename T::function_t fake = NULL;
+        return fake;
+    }
+    static long call(const long* args) {
+        return SyscallInvoke<typename T::function_t>::call(__atomic_load_n(&function(), __ATOMIC_ACQUIRE), args);
+    }
+};
+
+/**
+ * @brief Route a number to the fake function of a syscall mock and set its handler to the real syscall
+ * @tparam T Mockf class
+ * @tparam N Number of syscall
+ */
+template<typename T, long N>
+struct SyscallFunction : public SyscallRoute<T> {
+    SyscallFunction(typename T::function_t fake) :
+        SyscallRoute<T>(N, fake) {
+        T::setHandler(&SyscallReal<N, typename T::function_t>::call);
+    }
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_SYSCALL_H_
@@ -0,0 +1,390 @@
+/**
+ * mockf/timeline.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef BLET_MOCKF_TIMELINE_H_
+#define BLET_MOCKF_TIMELINE_H_
+
+#include <inttypes.h> // PRId64, PRIu64
+#include <stdint.h>   // int64_t, uint64_t
+#include <stdio.h>    // FILE, fopen, fprintf
+#include <sys/mman.h> // mmap, munmap
+#include <unistd.h>   // getpid
+
+#include <algorithm>
+#include <vector>
+
+#include "blet/mockf/core.h"
+
+/**
+ * @brief Number of events kept by thread (the oldest events are overwritten)
+ */
+#ifndef MOCKF_TIMELINE_EVENTS
+#define MOCKF_TIMELINE_EVENTS 8192
+#endif
+
+/**
+ * @brief Number of first arguments kept in an event
+ */
+#ifndef MOCKF_TIMELINE_ARGS
+#define MOCKF_TIMELINE_ARGS 2
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+struct TimelineError : public Exception {
+    TimelineError(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "timeline error.";
+    }
+};
+
+/**
+ * @brief Call of a mock
+ */
+struct TimelineEvent {
+    uint64_t sequence;                 // index of event in its ring + 1 (0 while the event is written)
+    const char* name;                  // name of mock
+    uint32_t tid;                      // index of thread (from 1 by timeline)
+    bool isMocked;                     // call of mock or of the real function (or handler)
+    uint64_t start;                    // monotonic timestamp (ns)
+    uint64_t duration;                 // ns
+    int64_t args[MOCKF_TIMELINE_ARGS]; // integer argument, address of pointer argument, 0 otherwise
+    int64_t result;                    // integer result, address of pointer result, 0 otherwise
+};
+
+/**
+ * @brief Ring of the events of a thread (written only by its thread)
+ */
+struct TimelineRing {
+    TimelineRing* next;
+    uint32_t tid;
+    uint64_t head; // number of written events
+    TimelineEvent events[MOCKF_TIMELINE_EVENTS];
+};
+
+/**
+ * @brief Timeline of the calls of mocks in a lock-free ring by thread
+ * Exported in the Chrome trace json format (opened by chrome://tracing and ui.perfetto.dev).
+ * Define MOCKF_ENABLE_TIMELINE before the include of blet/mockf.h for record the calls of the fake functions.
+ * The timeline must be destroyed after the calls of the other threads (the events can be exported during the calls).
+ */
+class Timeline {
+  public:
+    /**
+     * @param sampling Record one call in sampling calls of each thread
+     * @throw blet::mockf::TimelineError if a timeline already exists
+     */
+    explicit Timeline(unsigned int sampling = 1) :
+        sampling_(sampling == 0 ? 1 : sampling),
+        start_(Clock::now()),
+        rings_(NULL),
+        nbThread_(0) {
+        Timeline* expected = NULL;
+        if (!__atomic_compare_exchange_n(&instance(), &expected, this, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            throw TimelineError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), "timeline");
+        }
+        __atomic_add_fetch(&generation(), 1, __ATOMIC_RELEASE);
+    }
+
+    ~Timeline() {
+        __atomic_store_n(&instance(), static_cast<Timeline*>(NULL), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&generation(), 1, __ATOMIC_RELEASE);
+        TimelineRing* ring = __atomic_load_n(&rings_, __ATOMIC_ACQUIRE);
+        while (ring != NULL) {
+            TimelineRing* next = ring->next;
+            ::munmap(ring, sizeof(TimelineRing));
+            ring = next;
+        }
+    }
+
+    static Timeline*& instance() {
+        static Timeline* singleton = NULL;
+        return singleton;
+    }
+
+    /**
+     * @brief Incremented at each construction and destruction (invalidate the rings cached by the threads)
+     */
+    static uint64_t& generation() {
+        static uint64_t count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Ring of the current thread if its call is sampled, NULL otherwise (called by the fake functions)
+     */
+    static TimelineRing* threadRing() {
+        Cache& cache = threadCache();
+        if (cache.isBusy) {
+            return NULL;
+        }
+        uint64_t generation = __atomic_load_n(&Timeline::generation(), __ATOMIC_ACQUIRE);
+        if (cache.generation != generation) {
+            // the calls of the mocks by the mmap of ring are not recorded
+            cache.isBusy = true;
+            Timeline* timeline = __atomic_load_n(&instance(), __ATOMIC_ACQUIRE);
+            cache.ring = timeline == NULL ? NULL : timeline->acquire();
+            cache.sampling = timeline == NULL ? 1 : timeline->sampling_;
+            cache.count = 0;
+            cache.generation = generation;
+            cache.isBusy = false;
+        }
+        if (cache.ring == NULL || (cache.sampling > 1 && ++cache.count % cache.sampling != 0)) {
+            return NULL;
+        }
+        return cache.ring;
+    }
+
+    /**
+     * @brief Number of events kept in the rings
+     */
+    uint64_t nbEvent() const {
+        uint64_t count = 0;
+        for (const TimelineRing* ring = __atomic_load_n(&rings_, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+            uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            count += head < MOCKF_TIMELINE_EVENTS ? head : MOCKF_TIMELINE_EVENTS;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Number of events overwritten in the rings
+     */
+    uint64_t nbDropped() const {
+        uint64_t count = 0;
+        for (const TimelineRing* ring = __atomic_load_n(&rings_, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+            uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            count += head < MOCKF_TIMELINE_EVENTS ? 0 : head - MOCKF_TIMELINE_EVENTS;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Events kept in the rings sorted by start (relative to the construction of timeline)
+     * Can be called while the threads record: an event overwritten during its copy is skipped.
+     */
+    std::vector<TimelineEvent> events() const {
+        std::vector<TimelineEvent> result;
+        for (const TimelineRing* ring = __atomic_load_n(&rings_, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+            uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            uint64_t first = head < MOCKF_TIMELINE_EVENTS ? 0 : head - MOCKF_TIMELINE_EVENTS;
+            for (uint64_t i = first; i < head; ++i) {
+                const TimelineEvent& slot = ring->events[i % MOCKF_TIMELINE_EVENTS];
+                if (__atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE) != i + 1) {
+                    continue; // overwritten
+                }
+                TimelineEvent event = slot;
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                if (__atomic_load_n(&slot.sequence, __ATOMIC_RELAXED) != i + 1) {
+                    continue; // overwritten during the copy
+                }
+                event.start = event.start < start_ ? 0 : event.start - start_;
+                result.push_back(event);
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), &isBefore);
+        return result;
+    }
+
+    /**
+     * @brief Write the events in the Chrome trace json format (complete events, timestamps in microseconds)
+     */
+    void writeChrome(FILE* file) const {
+        Busy busy;
+        std::vector<TimelineEvent> list = events();
+        long pid = static_cast<long>(::getpid());
+        fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            const TimelineEvent& event = list[i];
+            fprintf(file,
+                    "%s\n  {\"name\": \"%s\", \"cat\": \"mockf\", \"ph\": \"X\", \"pid\": %ld, \"tid\": %u, "
+                    "\"ts\": %" PRIu64 ".%03" PRIu64 ", \"dur\": %" PRIu64 ".%03" PRIu64 ", \"args\": {",
+                    i == 0 ? "" : ",", event.name, pid, event.tid, event.start / 1000, event.start % 1000,
+                    event.duration / 1000, event.duration % 1000);
+            for (unsigned int j = 0; j < MOCKF_TIMELINE_ARGS; ++j) {
+                fprintf(file, "\"arg%u\": %" PRId64 ", ", j, event.args[j]);
+            }
+            fprintf(file, "\"result\": %" PRId64 ", \"mocked\": %s}}", event.result, event.isMocked ? "true" : "false");
+        }
+        fprintf(file, "\n]}\n");
+    }
+
+    /**
+     * @brief Write the events in a Chrome trace json file
+     * @throw blet::mockf::TimelineError if the file can not be opened
+     */
+    void writeChrome(const char* path) const {
+        FILE* file = NULL;
+        {
+            Busy busy;
+            file = fopen(path, "w");
+        }
+        if (file == NULL) {
+            throw TimelineError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), path);
+        }
+        writeChrome(file);
+        Busy busy;
+        fclose(file);
+    }
+
+  private:
+    Timeline(const Timeline&);            // disable copy
+    Timeline& operator=(const Timeline&); // disable copy
+
+    struct Cache {
+        uint64_t generation;
+        TimelineRing* ring;
+        unsigned int sampling;
+        unsigned int count;
+        bool isBusy;
+    };
+
+    static Cache& threadCache() {
+        static MOCKF_INTERNAL_THREAD_LOCAL_ Cache cache = {0, NULL, 1, 0, false};
+        return cache;
+    }
+
+    /**
+     * @brief The calls of mocks by the current thread are not recorded on scope
+     */
+    struct Busy {
+        Busy() :
+            isBusy_(threadCache().isBusy) {
+            threadCache().isBusy = true;
+        }
+        ~Busy() {
+            threadCache().isBusy = isBusy_;
+        }
+        bool isBusy_;
+    };
+
+    static bool isBefore(const TimelineEvent& event1, const TimelineEvent& event2) {
+        return event1.start < event2.start;
+    }
+
+    /**
+     * @brief Map a ring for the current thread and push it in the list of rings
+     */
+    TimelineRing* acquire() {
+        void* map = ::mmap(NULL, sizeof(TimelineRing), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            return NULL;
+        }
+        TimelineRing* ring = static_cast<TimelineRing*>(map);
+        ring->tid = __atomic_add_fetch(&nbThread_, 1, __ATOMIC_RELAXED);
+        ring->head = 0;
+        ring->next = __atomic_load_n(&rings_, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&rings_, &ring->next, ring, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+        return ring;
+    }
+
+    unsigned int sampling_;
+    uint64_t start_;
+    TimelineRing* rings_;
+    uint32_t nbThread_;
+};
+
+/**
+ * @brief Record a call of a mock on scope in the ring of its thread
+ * @tparam T Mock class
+ */
+template<typename T>
+class TimelineCall : public CallRecorder<TimelineCall<T> > {
+  public:
+    explicit TimelineCall(bool isMocked) :
+        ring_(Timeline::threadRing()),
+        isMocked_(isMocked),
+        nbArg_(0),
+        result_(0),
+        start_(0) {
+        if (ring_ != NULL) {
+            for (unsigned int i = 0; i < MOCKF_TIMELINE_ARGS; ++i) {
+                args_[i] = 0;
+            }
+            start_ = Clock::now();
+        }
+    }
+
+    ~TimelineCall() {
+        if (ring_ != NULL) {
+            uint64_t end = Clock::now();
+            uint64_t head = __atomic_load_n(&ring_->head, __ATOMIC_RELAXED);
+            TimelineEvent& event = ring_->events[head % MOCKF_TIMELINE_EVENTS];
+            // seqlock of the slot: a reader skips the event while it is written
+            __atomic_store_n(&event.sequence, static_cast<uint64_t>(0), __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            event.name = T::functionName();
+            event.tid = ring_->tid;
+            event.isMocked = isMocked_;
+            event.start = start_;
+            event.duration = end - start_;
+            for (unsigned int i = 0; i < MOCKF_TIMELINE_ARGS; ++i) {
+                event.args[i] = args_[i];
+            }
+            event.result = result_;
+            __atomic_store_n(&event.sequence, head + 1, __ATOMIC_RELEASE);
+            __atomic_store_n(&ring_->head, head + 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    /**
+     * @brief Keep the next argument of call
+     */
+    template<typename A>
+    void arg(const A& value) {
+        if (ring_ != NULL && nbArg_ < MOCKF_TIMELINE_ARGS) {
+            args_[nbArg_++] = callValue(value).value;
+        }
+    }
+
+    /**
+     * @brief Keep the result of call
+     */
+    template<typename R>
+    R result(R value) {
+        if (ring_ != NULL) {
+            result_ = callValue(value).value;
+        }
+        return value;
+    }
+
+  private:
+    TimelineRing* ring_;
+    bool isMocked_;
+    unsigned int nbArg_;
+    int64_t args_[MOCKF_TIMELINE_ARGS];
+    int64_t result_;
+    uint64_t start_;
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_TIMELINE_H_
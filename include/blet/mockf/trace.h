@@ -0,0 +1,907 @@
+/**
+ * mockf/trace.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_TRACE_H_
+#define BLET_MOCKF_TRACE_H_
+
+#include <errno.h>       // errno
+#include <pthread.h>     // pthread_mutex_t
+#include <stdint.h>      // int64_t, uint32_t
+#include <string.h>      // memcpy, memcmp
+#include <sys/mman.h>    // mmap, mremap, munmap
+#include <sys/stat.h>    // struct stat
+#include <sys/syscall.h> // SYS_openat, SYS_close, SYS_ftruncate, SYS_lseek
+#include <sys/time.h>    // struct timeval
+#include <time.h>        // struct timespec, struct tm
+#include <unistd.h>      // syscall
+
+#include <map>
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Record the calls of the real function in the current trace
+ * @param name Name of function
+ */
+#define MOCKF_RECORD(name) MOCKF_SET_HANDLER(name, &::blet::mockf::TraceHandler<MOCKF_CLASS(name)>::record)
+/**
+ * @brief Replay the calls of the function from the current trace
+ * @param name Name of function
+ * @throw blet::mockf::TraceNotFound if the trace has no more call of function
+ */
+#define MOCKF_REPLAY(name) MOCKF_SET_HANDLER(name, &::blet::mockf::TraceHandler<MOCKF_CLASS(name)>::replay)
+/**
+ * @brief Record and replay the bytes of a pointer argument of function (e.g. int[2] of pipe)
+ * @param name Name of function
+ * @param index Index of argument
+ * @param size Size of output
+ */
+#define MOCKF_TRACE_OUTPUT(name, index, size)                                 \
+    namespace blet {                                                          \
+    namespace mockf {                                                         \
+    template<>                                                                \
+    struct TraceFunctionOutput<MOCKF_CLASS(name)> {                           \
+        static uint32_t capacity(unsigned int i, uint32_t typeCapacity) {     \
+            return i == (index) ? static_cast<uint32_t>(size) : typeCapacity; \
+        }                                                                     \
+    };                                                                        \
+    }                                                                         \
+    }                                                                         \
+    struct MockFForceSemiColon
+
+/**
+ * @brief Size of the first mapping of a recorded trace (double at each growth)
+ */
+#ifndef MOCKF_TRACE_CAPACITY
+#define MOCKF_TRACE_CAPACITY (1024 * 1024)
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+struct TraceNotFound : public Exception {
+    TraceNotFound(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "trace record not found.";
+    }
+};
+
+struct TraceMismatch : public Exception {
+    TraceMismatch(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "trace record does not match the call.";
+    }
+};
+
+struct TraceFileError : public Exception {
+    TraceFileError(const char* file, const char* line, const char* name) throw() :
+        Exception(file, line, name) {
+        message_ += "trace file error.";
+    }
+};
+
+/**
+ * @brief Header of trace file
+ */
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Header of a call in trace file
+ * Followed by the arguments (int64_t) and the outputs (TraceOutputHeader and data aligned on 8 bytes)
+ */
+struct TraceRecordHeader {
+    uint32_t size; // size of record with header
+    uint32_t id;   // hash of function name
+    int64_t result;
+    int32_t error; // errno after call
+    uint16_t nbArgument;
+    uint16_t nbOutput;
+};
+
+struct TraceOutputHeader {
+    uint32_t index; // index of argument
+    uint32_t size;
+};
+
+/**
+ * @brief Output buffer of an argument
+ */
+struct TraceOutput {
+    const void* data;
+    uint32_t size;
+};
+
+/**
+ * @brief Capacity of a buffer argument: the value of the next argument (read, recv, pread, getcwd, readlink)
+ */
+static const uint32_t TRACE_BUFFER_CAPACITY = 0xFFFFFFFFu;
+
+/**
+ * @brief Plain output types recorded by their pointer argument (the others are not recorded)
+ * @tparam A Type pointed
+ */
+template<typename A>
+struct TraceOutputType {
+    static uint32_t capacity() {
+        return 0;
+    }
+};
+
+#define MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(type) \
+    template<>                                  \
+    struct TraceOutputType<type> {              \
+        static uint32_t capacity() {            \
+            return sizeof(type);                \
+        }                                       \
+    }
+
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(int);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(unsigned int);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(long);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(unsigned long);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(struct stat);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(struct timespec);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(struct timeval);
+MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_(struct tm);
+
+#undef MOCKF_INTERNAL_TRACE_OUTPUT_TYPE_
+
+/**
+ * @brief Encode an argument in trace
+ * Integral argument: value, const pointer: input (not recorded), pointer: output of a plain type (see
+ * TraceOutputType), void* or char*: output of result bytes (read-like function)
+ * @tparam A Type of argument
+ */
+template<typename A>
+struct TraceArgument {
+    static int64_t value(const A& a) {
+        return static_cast<int64_t>(a);
+    }
+    static void* pointer(const A& /* a */) {
+        return NULL;
+    }
+    static uint32_t capacity() {
+        return 0;
+    }
+};
+
+template<typename A>
+struct TraceArgument<const A*> {
+    static int64_t value(const A* /* a */) {
+        return 0;
+    }
+    static void* pointer(const A* /* a */) {
+        return NULL;
+    }
+    static uint32_t capacity() {
+        return 0;
+    }
+};
+
+template<typename A>
+struct TraceArgument<A*> {
+    static int64_t value(A* /* a */) {
+        return 0;
+    }
+    static void* pointer(A* a) {
+        return a;
+    }
+    static uint32_t capacity() {
+        return TraceOutputType<A>::capacity();
+    }
+};
+
+template<typename A>
+struct TraceBufferArgument {
+    static int64_t value(A /* a */) {
+        return 0;
+    }
+    static void* pointer(A a) {
+        return a;
+    }
+    static uint32_t capacity() {
+        return TRACE_BUFFER_CAPACITY;
+    }
+};
+
+template<>
+struct TraceArgument<void*> : TraceBufferArgument<void*> {};
+
+template<>
+struct TraceArgument<char*> : TraceBufferArgument<char*> {};
+
+/**
+ * @brief Outputs of the pointer arguments of a function (see MOCKF_TRACE_OUTPUT)
+ * @tparam T Mockf class
+ */
+template<typename T>
+struct TraceFunctionOutput {
+    static uint32_t capacity(unsigned int /* index */, uint32_t typeCapacity) {
+        return typeCapacity;
+    }
+};
+
+/**
+ * @brief Append-only binary trace of calls in a memory-mapped file
+ * Record mode writes the calls of the real functions, replay mode serves the calls from the mapping.
+ * The file is managed with syscall for never use a mocked function.
+ */
+class Trace {
+  public:
+    enum Mode {
+        RECORD,
+        REPLAY
+    };
+
+    Trace(const char* filename, Mode mode) :
+        mode_(mode),
+        map_(NULL),
+        size_(0),
+        capacity_(0),
+        fd_(-1) {
+        // one trace at a time: never open (and truncate) the file of the current trace
+        int expected = 0;
+        if (!__atomic_compare_exchange_n(&isUsed(), &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), filename);
+        }
+        pthread_mutex_init(&mutex_, NULL);
+        try {
+            if (mode_ == RECORD) {
+                openRecord(filename);
+            }
+            else {
+                openReplay(filename);
+            }
+        }
+        catch (...) {
+            pthread_mutex_destroy(&mutex_);
+            __atomic_store_n(&isUsed(), 0, __ATOMIC_RELEASE);
+            throw;
+        }
+        __atomic_store_n(&instance(), this, __ATOMIC_RELEASE);
+    }
+
+    ~Trace() {
+        __atomic_store_n(&instance(), static_cast<Trace*>(NULL), __ATOMIC_RELEASE);
+        close();
+        pthread_mutex_destroy(&mutex_);
+        __atomic_store_n(&isUsed(), 0, __ATOMIC_RELEASE);
+    }
+
+    static Trace*& instance() {
+        static Trace* singleton = NULL;
+        return singleton;
+    }
+
+    Mode mode() const {
+        return mode_;
+    }
+
+    /**
+     * @brief Size of the trace with the file header
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief FNV-1a hash of function name
+     */
+    static uint32_t id(const char* name) {
+        uint32_t hash = 2166136261u;
+        for (; *name != '\0'; ++name) {
+            hash ^= static_cast<unsigned char>(*name);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Append a call in the current trace (do nothing if no trace in record mode)
+     */
+    static void record(const char* name, int64_t result, int error, const int64_t* arguments,
+                       const TraceOutput* outputs, uint16_t nbArgument) {
+        Trace* trace = __atomic_load_n(&instance(), __ATOMIC_ACQUIRE);
+        if (trace != NULL && trace->mode_ == RECORD) {
+            trace->append(id(name), result, error, arguments, outputs, nbArgument);
+        }
+    }
+
+    /**
+     * @brief Take the next call of function in the current trace
+     * Copy the outputs in the pointers of arguments (bounded by their capacity) and set errno
+     * @return int64_t Result of call
+     * @throw TraceNotFound if the trace has no more call of function
+     * @throw TraceMismatch if the length of a buffer is not the recorded length
+     */
+    static int64_t replay(const char* name, const int64_t* arguments, void* const* pointers,
+                          const uint32_t* capacities, uint16_t nbArgument) {
+        Trace* trace = __atomic_load_n(&instance(), __ATOMIC_ACQUIRE);
+        const TraceRecordHeader* header = NULL;
+        if (trace != NULL && trace->mode_ == REPLAY) {
+            header = trace->next(id(name), nbArgument);
+        }
+        if (header == NULL) {
+            throw TraceNotFound(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+        }
+        const int64_t* recorded = reinterpret_cast<const int64_t*>(header + 1);
+        const char* data = reinterpret_cast<const char*>(recorded + header->nbArgument);
+        const char* end = reinterpret_cast<const char*>(header) + header->size;
+        for (uint16_t i = 0; i < header->nbOutput; ++i) {
+            const TraceOutputHeader* output = reinterpret_cast<const TraceOutputHeader*>(data);
+            if (data + sizeof(TraceOutputHeader) > end || output->index >= nbArgument ||
+                output->size > static_cast<size_t>(end - data) - sizeof(TraceOutputHeader)) {
+                throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+            }
+            uint32_t index = output->index;
+            uint64_t capacity = capacities[index];
+            if (capacity == TRACE_BUFFER_CAPACITY) {
+                if (index + 1u >= nbArgument) {
+                    capacity = 0;
+                }
+                else if (recorded[index + 1] != arguments[index + 1]) {
+                    throw TraceMismatch(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), name);
+                }
+                else {
+                    capacity = arguments[index + 1] < 0 ? 0 : static_cast<uint64_t>(arguments[index + 1]);
+                }
+            }
+            if (pointers[index] != NULL) {
+                memcpy(pointers[index], output + 1, output->size < capacity ? output->size : capacity);
+            }
+            data += sizeof(TraceOutputHeader) + align(output->size);
+        }
+        errno = header->error;
+        return header->result;
+    }
+
+  private:
+    Trace(const Trace&);            // disable copy
+    Trace& operator=(const Trace&); // disable copy
+
+    static int& isUsed() {
+        static int used = 0;
+        return used;
+    }
+
+    static size_t align(size_t size) {
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+
+    static const char* magic() {
+        return "MOCKFTR";
+    }
+
+    void openRecord(const char* filename) {
+        fd_ = static_cast<int>(::syscall(SYS_openat, AT_FDCWD, filename, O_RDWR | O_CREAT | O_TRUNC, 0644));
+        if (fd_ < 0) {
+            throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), filename);
+        }
+        capacity_ = MOCKF_TRACE_CAPACITY;
+        if (::syscall(SYS_ftruncate, fd_, capacity_) != 0 ||
+            (map_ = static_cast<char*>(mmap(NULL, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0))) ==
+                MAP_FAILED) {
+            map_ = NULL;
+            close();
+            throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), filename);
+        }
+        TraceFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, magic(), sizeof(header.magic));
+        header.version = 1;
+        memcpy(map_, &header, sizeof(header));
+        size_ = sizeof(header);
+    }
+
+    void openReplay(const char* filename) {
+        fd_ = static_cast<int>(::syscall(SYS_openat, AT_FDCWD, filename, O_RDONLY, 0));
+        if (fd_ < 0) {
+            throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), filename);
+        }
+        long end = ::syscall(SYS_lseek, fd_, 0, SEEK_END);
+        if (end < static_cast<long>(sizeof(TraceFileHeader)) ||
+            (map_ = static_cast<char*>(mmap(NULL, end, PROT_READ, MAP_PRIVATE, fd_, 0))) == MAP_FAILED ||
+            memcmp(map_, magic(), sizeof(TraceFileHeader().magic)) != 0) {
+            if (map_ == MAP_FAILED) {
+                map_ = NULL;
+            }
+            capacity_ = end;
+            close();
+            throw TraceFileError(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), filename);
+        }
+        size_ = end;
+        capacity_ = end;
+        ::syscall(SYS_close, fd_);
+        fd_ = -1;
+    }
+
+    void close() {
+        if (map_ != NULL) {
+            munmap(map_, capacity_);
+            map_ = NULL;
+        }
+        if (fd_ >= 0) {
+            if (mode_ == RECORD) {
+                ::syscall(SYS_ftruncate, fd_, size_);
+            }
+            ::syscall(SYS_close, fd_);
+            fd_ = -1;
+        }
+    }
+
+    // reserve the size in the mapping, must be call with the lock
+    bool reserve(size_t size) {
+        if (size_ + size <= capacity_) {
+            return true;
+        }
+        size_t capacity = capacity_;
+        while (size_ + size > capacity) {
+            capacity *= 2;
+        }
+        if (::syscall(SYS_ftruncate, fd_, capacity) != 0) {
+            return false;
+        }
+        void* map = mremap(map_, capacity_, capacity, MREMAP_MAYMOVE);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        map_ = static_cast<char*>(map);
+        capacity_ = capacity;
+        return true;
+    }
+
+    void append(uint32_t id, int64_t result, int error, const int64_t* arguments, const TraceOutput* outputs,
+                uint16_t nbArgument) {
+        TraceRecordHeader header;
+        header.size = sizeof(TraceRecordHeader) + nbArgument * sizeof(int64_t);
+        header.id = id;
+        header.result = result;
+        header.error = error;
+        header.nbArgument = nbArgument;
+        header.nbOutput = 0;
+        for (uint16_t i = 0; i < nbArgument; ++i) {
+            if (outputs[i].size > 0) {
+                header.size += sizeof(TraceOutputHeader) + align(outputs[i].size);
+                ++header.nbOutput;
+            }
+        }
+        pthread_mutex_lock(&mutex_);
+        if (reserve(header.size)) {
+            char* data = map_ + size_;
+            memcpy(data, &header, sizeof(header));
+            data += sizeof(header);
+            if (nbArgument > 0) {
+                memcpy(data, arguments, nbArgument * sizeof(int64_t));
+                data += nbArgument * sizeof(int64_t);
+            }
+            for (uint16_t i = 0; i < nbArgument; ++i) {
+                if (outputs[i].size > 0) {
+                    TraceOutputHeader output = {i, outputs[i].size};
+                    memcpy(data, &output, sizeof(output));
+                    memcpy(data + sizeof(output), outputs[i].data, outputs[i].size);
+                    data += sizeof(output) + align(outputs[i].size);
+                }
+            }
+            size_ += header.size;
+        }
+        pthread_mutex_unlock(&mutex_);
+    }
+
+    const TraceRecordHeader* next(uint32_t id, uint16_t nbArgument) {
+        const TraceRecordHeader* found = NULL;
+        pthread_mutex_lock(&mutex_);
+        std::map<uint32_t, size_t>::iterator cursor = cursors_.find(id);
+        size_t offset = cursor == cursors_.end() ? sizeof(TraceFileHeader) : cursor->second;
+        while (offset + sizeof(TraceRecordHeader) <= size_) {
+            const TraceRecordHeader* header = reinterpret_cast<const TraceRecordHeader*>(map_ + offset);
+            if (header->size < sizeof(TraceRecordHeader) || offset + header->size > size_) {
+                break; // truncated trace
+            }
+            offset += header->size;
+            if (header->id == id && header->nbArgument == nbArgument) {
+                found = header;
+                break;
+            }
+        }
+        cursors_[id] = offset;
+        pthread_mutex_unlock(&mutex_);
+        return found;
+    }
+
+    Mode mode_;
+    char* map_;
+    size_t size_;
+    size_t capacity_;
+    int fd_;
+    pthread_mutex_t mutex_;
+    std::map<uint32_t, size_t> cursors_;
+};
+
+/**
+ * @brief Arguments of a call encoded for the trace (added one by one by TraceHandler)
+ * @tparam T Mockf class
+ */
+template<typename T>
+class TraceCall {
+  public:
+    explicit TraceCall(int64_t result = 0) :
+        result_(result),
+        size_(0) {}
+    template<typename A>
+    TraceCall& add(A a) {
+        uint32_t capacity = TraceFunctionOutput<T>::capacity(size_, TraceArgument<A>::capacity());
+        void* pointer = capacity == 0 ? NULL : TraceArgument<A>::pointer(a);
+        arguments_[size_] = TraceArgument<A>::value(a);
+        pointers_[size_] = pointer;
+        capacities_[size_] = capacity;
+        outputs_[size_].data = pointer;
+        if (pointer == NULL) {
+            outputs_[size_].size = 0;
+        }
+        else if (capacity == TRACE_BUFFER_CAPACITY) {
+            outputs_[size_].size = result_ <= 0 ? 0 : static_cast<uint32_t>(result_);
+        }
+        else {
+            outputs_[size_].size = capacity;
+        }
+        ++size_;
+        return *this;
+    }
+    void record(const char* name, int error) const {
+        Trace::record(name, result_, error, arguments_, outputs_, size_);
+    }
+    int64_t replay(const char* name) const {
+        return Trace::replay(name, arguments_, pointers_, capacities_, size_);
+    }
+
+  private:
+    enum {
+        MAX_ARGUMENT = 15
+    };
+
+    int64_t result_;
+    uint16_t size_;
+    int64_t arguments_[MAX_ARGUMENT];
+    TraceOutput outputs_[MAX_ARGUMENT];
+    void* pointers_[MAX_ARGUMENT];
+    uint32_t capacities_[MAX_ARGUMENT];
+};
+
+/**
+ * @brief Record and replay functions of a mock
+ * @tparam T Mockf class
+ * @tparam F Function pointer type of mock
+ */
+template<typename T, typename F = typename T::function_t>
+struct TraceHandler;
+
+#if __cplusplus >= 201103L
+
+template<typename T, typename R, typename... A>
+struct TraceHandler<T, R (*)(A...)> {
+    static R record(A... a) {
+        R ret = T::real()(a...);
+        int error = errno;
+        TraceCall<T> call(static_cast<int64_t>(ret));
+        int expand[] = {0, (call.add(a), 0)...};
+        (void)expand;
+        call.record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A... a) {
+        TraceCall<T> call;
+        int expand[] = {0, (call.add(a), 0)...};
+        (void)expand;
+        return static_cast<R>(call.replay(T::functionName()));
+    }
+};
+
+#else
+
+template<typename T, typename R>
+struct TraceHandler<T, R (*)()> {
+    static R record() {
+        R ret = T::real()();
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret)).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay() {
+        return static_cast<R>(TraceCall<T>().replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1>
+struct TraceHandler<T, R (*)(A1)> {
+    static R record(A1 a1) {
+        R ret = T::real()(a1);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret)).add(a1).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1) {
+        return static_cast<R>(TraceCall<T>().add(a1).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2>
+struct TraceHandler<T, R (*)(A1, A2)> {
+    static R record(A1 a1, A2 a2) {
+        R ret = T::real()(a1, a2);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret)).add(a1).add(a2).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2) {
+        return static_cast<R>(TraceCall<T>().add(a1).add(a2).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3>
+struct TraceHandler<T, R (*)(A1, A2, A3)> {
+    static R record(A1 a1, A2 a2, A3 a3) {
+        R ret = T::real()(a1, a2, a3);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret)).add(a1).add(a2).add(a3).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3) {
+        return static_cast<R>(TraceCall<T>().add(a1).add(a2).add(a3).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4) {
+        R ret = T::real()(a1, a2, a3, a4);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret)).add(a1).add(a2).add(a3).add(a4).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4) {
+        return static_cast<R>(TraceCall<T>().add(a1).add(a2).add(a3).add(a4).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
+        R ret = T::real()(a1, a2, a3, a4, a5);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
+        return static_cast<R>(TraceCall<T>().add(a1).add(a2).add(a3).add(a4).add(a5).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6) {
+        return static_cast<R>(TraceCall<T>().add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8)
+                                  .replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9)
+                                  .replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+            .record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10).add(a11)
+            .record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .add(a11).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10).add(a11).add(a12)
+            .record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .add(a11).add(a12).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10).add(a11).add(a12).add(a13)
+            .record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .add(a11).add(a12).add(a13).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                    A14 a14) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10).add(a11).add(a12).add(a13)
+            .add(a14).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                    A14 a14) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .add(a11).add(a12).add(a13).add(a14).replay(T::functionName()));
+    }
+};
+
+template<typename T, typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6,
+         typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14,
+         typename A15>
+struct TraceHandler<T, R (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15)> {
+    static R record(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                    A14 a14, A15 a15) {
+        R ret = T::real()(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+        int error = errno;
+        TraceCall<T>(static_cast<int64_t>(ret))
+            .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10).add(a11).add(a12).add(a13)
+            .add(a14).add(a15).record(T::functionName(), error);
+        errno = error;
+        return ret;
+    }
+    static R replay(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10, A11 a11, A12 a12, A13 a13,
+                    A14 a14, A15 a15) {
+        return static_cast<R>(TraceCall<T>()
+                                  .add(a1).add(a2).add(a3).add(a4).add(a5).add(a6).add(a7).add(a8).add(a9).add(a10)
+                                  .add(a11).add(a12).add(a13).add(a14).add(a15).replay(T::functionName()));
+    }
+};
+
+#endif
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_TRACE_H_
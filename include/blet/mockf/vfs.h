@@ -0,0 +1,721 @@
+/**
+ * mockf/vfs.h
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * Copyright (c) 2021-2025 BLET Mickaël.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BLET_MOCKF_VFS_H_
+#define BLET_MOCKF_VFS_H_
+
+#include <errno.h>     // errno
+#include <fcntl.h>     // O_CREAT, O_EXCL, O_TRUNC, O_APPEND
+#include <pthread.h>   // pthread_mutex_t
+#include <stdio.h>     // rename
+#include <string.h>    // memcpy, memset
+#include <sys/stat.h>  // stat, fstat
+#include <sys/types.h> // off_t, mode_t
+#include <unistd.h>    // read, write, pread, pwrite, lseek, close, unlink
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "blet/mockf.h"
+
+/**
+ * @brief Declare the mocks of the file functions with the virtual filesystem as handler
+ * Must be used in only one source file of a binary
+ */
+#define MOCKF_VFS_FUNCTIONS()                                                                                    \
+    MOCKF_VARIADIC_FUNCTION3(int, open, (const char* /* file */, int /* oflag */, ...));                         \
+    MOCKF_VARIADIC_FUNCTION4(int, openat, (int /* fd */, const char* /* file */, int /* oflag */, ...));         \
+    MOCKF_FUNCTION1(int, close, (int /* fd */));                                                                 \
+    MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));                        \
+    MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* n */));                      \
+    MOCKF_FUNCTION4(ssize_t, pread, (int /* fd */, void* /* buf */, size_t /* nbytes */, off_t /* offset */));   \
+    MOCKF_FUNCTION4(ssize_t, pwrite, (int /* fd */, const void* /* buf */, size_t /* n */, off_t /* offset */)); \
+    MOCKF_ATTRIBUTE_FUNCTION3(off_t, lseek, (int /* fd */, off_t /* offset */, int /* whence */), throw());      \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, stat, (const char* /* file */, struct stat* /* buf */), throw());             \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, fstat, (int /* fd */, struct stat* /* buf */), throw());                      \
+    MOCKF_ATTRIBUTE_FUNCTION1(int, unlink, (const char* /* name */), throw());                                   \
+    MOCKF_ATTRIBUTE_FUNCTION2(int, rename, (const char* /* old */, const char* /* new */), throw());             \
+    namespace blet {                                                                                             \
+    namespace mockf {                                                                                            \
+    static const VfsHandlers<MockF_open, MockF_openat, MockF_close, MockF_read, MockF_write, MockF_pread,        \
+                             MockF_pwrite, MockF_lseek, MockF_stat, MockF_fstat, MockF_unlink, MockF_rename>     \
+        mockf_vfs_handlers;                                                                                      \
+    }                                                                                                            \
+    }                                                                                                            \
+    struct MockFForceSemiColon
+
+/**
+ * @brief First file descriptor of the virtual filesystem (separate of the real file descriptors)
+ */
+#ifndef MOCKF_VFS_FD_BASE
+#define MOCKF_VFS_FD_BASE (1 << 30)
+#endif
+
+/**
+ * @brief Size of a page of file data
+ */
+#ifndef MOCKF_VFS_PAGE_SIZE
+#define MOCKF_VFS_PAGE_SIZE 4096
+#endif
+
+/**
+ * @brief Number of pages allocated at once by the arena
+ */
+#ifndef MOCKF_VFS_BLOCK_PAGES
+#define MOCKF_VFS_BLOCK_PAGES 256
+#endif
+
+namespace blet {
+
+namespace mockf {
+
+/**
+ * @brief Arena of pages of file data
+ * The pages are allocated by block and reused after an unlink or a truncate
+ */
+class VfsArena {
+  public:
+    VfsArena() {}
+    ~VfsArena() {
+        for (std::size_t i = 0; i < blocks_.size(); ++i) {
+            delete[] blocks_[i];
+        }
+    }
+    char* allocate() {
+        if (pages_.empty()) {
+            char* block = new char[MOCKF_VFS_PAGE_SIZE * MOCKF_VFS_BLOCK_PAGES];
+            blocks_.push_back(block);
+            for (std::size_t i = MOCKF_VFS_BLOCK_PAGES; i > 0; --i) {
+                pages_.push_back(block + (i - 1) * MOCKF_VFS_PAGE_SIZE);
+            }
+        }
+        char* page = pages_.back();
+        pages_.pop_back();
+        memset(page, 0, MOCKF_VFS_PAGE_SIZE);
+        return page;
+    }
+    void release(char* page) {
+        pages_.push_back(page);
+    }
+
+  private:
+    VfsArena(const VfsArena&);            // disable copy
+    VfsArena& operator=(const VfsArena&); // disable copy
+    std::vector<char*> blocks_;
+    std::vector<char*> pages_;
+};
+
+/**
+ * @brief File of the virtual filesystem (a missing page is a hole of zeros)
+ */
+struct VfsInode {
+    ino_t ino;
+    mode_t mode;
+    off_t size;
+    nlink_t nlink;
+    int nbOpen;
+    std::vector<char*> pages;
+};
+
+/**
+ * @brief Open file description of the virtual filesystem
+ */
+struct VfsFile {
+    VfsInode* inode;
+    off_t offset;
+    int flags;
+};
+
+/**
+ * @brief In-memory filesystem for the paths under a mount point
+ * The functions have the same behavior of the syscall (return -1 and set errno on error)
+ */
+class Vfs {
+  public:
+    /**
+     * @param mountPoint Absolute path of the virtual filesystem ("/" for all absolute paths)
+     * @throw blet::mockf::VfsAlreadyExists if another virtual filesystem exists
+     */
+    Vfs(const char* mountPoint = "/") :
+        mountPoint_(mountPoint),
+        nextIno_(1) {
+        while (mountPoint_.size() > 1 && mountPoint_[mountPoint_.size() - 1] == '/') {
+            mountPoint_.erase(mountPoint_.size() - 1);
+        }
+        pthread_mutex_init(&mutex_, NULL);
+        Vfs* expected = NULL;
+        if (!__atomic_compare_exchange_n(&instance(), &expected, this, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            pthread_mutex_destroy(&mutex_);
+            throw VfsAlreadyExists(__FILE__, MOCKF_INTERNAL_TO_STRING_(__LINE__), mountPoint);
+        }
+    }
+
+    ~Vfs() {
+        __atomic_store_n(&instance(), static_cast<Vfs*>(NULL), __ATOMIC_RELEASE);
+        for (std::size_t i = 0; i < files_.size(); ++i) {
+            if (files_[i] != NULL) {
+                release(files_[i]->inode, true);
+                delete files_[i];
+            }
+        }
+        for (std::map<std::string, VfsInode*>::iterator it = inodes_.begin(); it != inodes_.end(); ++it) {
+            it->second->nlink = 0;
+            release(it->second, false);
+        }
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    static Vfs*& instance() {
+        static Vfs* singleton = NULL;
+        return singleton;
+    }
+
+    struct VfsAlreadyExists : public Exception {
+        VfsAlreadyExists(const char* file, const char* line, const char* name) throw() :
+            Exception(file, line, name) {
+            message_ += "virtual filesystem already exists.";
+        }
+    };
+
+    /**
+     * @brief Check if the path is under the mount point
+     */
+    bool isPath(const char* path) const {
+        if (path == NULL || path[0] != '/') {
+            return false;
+        }
+        if (mountPoint_.size() == 1) {
+            return true;
+        }
+        return mountPoint_.compare(0, mountPoint_.size(), path, mountPoint_.size()) == 0 &&
+               (path[mountPoint_.size()] == '\0' || path[mountPoint_.size()] == '/');
+    }
+
+    /**
+     * @brief Check if the file descriptor is a file descriptor of the virtual filesystem
+     */
+    static bool isFd(int fd) {
+        return fd >= MOCKF_VFS_FD_BASE;
+    }
+
+    int open(const char* path, int flags, mode_t mode) {
+        Lock lock(mutex_);
+        if (isDirectory(path)) {
+            return error(EISDIR);
+        }
+        std::map<std::string, VfsInode*>::iterator it = inodes_.find(path);
+        VfsInode* inode = NULL;
+        if (it != inodes_.end()) {
+            if ((flags & O_CREAT) != 0 && (flags & O_EXCL) != 0) {
+                return error(EEXIST);
+            }
+            inode = it->second;
+            if ((flags & O_TRUNC) != 0 && (flags & O_ACCMODE) != O_RDONLY) {
+                truncate(inode, 0);
+            }
+        }
+        else if ((flags & O_CREAT) == 0) {
+            return error(ENOENT);
+        }
+        else {
+            inode = new VfsInode();
+            inode->ino = nextIno_++;
+            inode->mode = S_IFREG | (mode & 07777);
+            inode->size = 0;
+            inode->nlink = 1;
+            inode->nbOpen = 0;
+            inodes_[path] = inode;
+        }
+        VfsFile* file = new VfsFile();
+        file->inode = inode;
+        file->offset = 0;
+        file->flags = flags;
+        ++inode->nbOpen;
+        std::size_t index = 0;
+        while (index < files_.size() && files_[index] != NULL) {
+            ++index;
+        }
+        if (index == files_.size()) {
+            files_.push_back(file);
+        }
+        else {
+            files_[index] = file;
+        }
+        return static_cast<int>(MOCKF_VFS_FD_BASE + index);
+    }
+
+    int close(int fd) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL) {
+            return error(EBADF);
+        }
+        files_[fd - MOCKF_VFS_FD_BASE] = NULL;
+        release(file->inode, true);
+        delete file;
+        return 0;
+    }
+
+    ssize_t read(int fd, void* buf, size_t nbytes) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL || (file->flags & O_ACCMODE) == O_WRONLY) {
+            return error(EBADF);
+        }
+        ssize_t ret = readAt(file->inode, static_cast<char*>(buf), nbytes, file->offset);
+        file->offset += ret;
+        return ret;
+    }
+
+    ssize_t write(int fd, const void* buf, size_t n) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL || (file->flags & O_ACCMODE) == O_RDONLY) {
+            return error(EBADF);
+        }
+        if ((file->flags & O_APPEND) != 0) {
+            file->offset = file->inode->size;
+        }
+        ssize_t ret = writeAt(file->inode, static_cast<const char*>(buf), n, file->offset);
+        file->offset += ret;
+        return ret;
+    }
+
+    ssize_t pread(int fd, void* buf, size_t nbytes, off_t offset) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL || (file->flags & O_ACCMODE) == O_WRONLY) {
+            return error(EBADF);
+        }
+        if (offset < 0) {
+            return error(EINVAL);
+        }
+        return readAt(file->inode, static_cast<char*>(buf), nbytes, offset);
+    }
+
+    ssize_t pwrite(int fd, const void* buf, size_t n, off_t offset) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL || (file->flags & O_ACCMODE) == O_RDONLY) {
+            return error(EBADF);
+        }
+        if (offset < 0) {
+            return error(EINVAL);
+        }
+        if ((file->flags & O_APPEND) != 0) {
+            offset = file->inode->size; // same of linux
+        }
+        return writeAt(file->inode, static_cast<const char*>(buf), n, offset);
+    }
+
+    off_t lseek(int fd, off_t offset, int whence) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL) {
+            return error(EBADF);
+        }
+        off_t position = 0;
+        switch (whence) {
+            case SEEK_SET:
+                position = offset;
+                break;
+            case SEEK_CUR:
+                position = file->offset + offset;
+                break;
+            case SEEK_END:
+                position = file->inode->size + offset;
+                break;
+            default:
+                return error(EINVAL);
+        }
+        if (position < 0) {
+            return error(EINVAL);
+        }
+        file->offset = position;
+        return position;
+    }
+
+    int stat(const char* path, struct stat* buf) {
+        Lock lock(mutex_);
+        std::map<std::string, VfsInode*>::const_iterator it = inodes_.find(path);
+        if (it != inodes_.end()) {
+            fill(it->second, buf);
+            return 0;
+        }
+        if (isDirectory(path)) {
+            memset(buf, 0, sizeof(*buf));
+            buf->st_dev = device();
+            buf->st_mode = S_IFDIR | 0755;
+            buf->st_nlink = 2;
+            buf->st_blksize = MOCKF_VFS_PAGE_SIZE;
+            return 0;
+        }
+        return error(ENOENT);
+    }
+
+    int fstat(int fd, struct stat* buf) {
+        Lock lock(mutex_);
+        VfsFile* file = find(fd);
+        if (file == NULL) {
+            return error(EBADF);
+        }
+        fill(file->inode, buf);
+        return 0;
+    }
+
+    int unlink(const char* path) {
+        Lock lock(mutex_);
+        std::map<std::string, VfsInode*>::iterator it = inodes_.find(path);
+        if (it == inodes_.end()) {
+            return error(isDirectory(path) ? EISDIR : ENOENT);
+        }
+        VfsInode* inode = it->second;
+        inodes_.erase(it);
+        inode->nlink = 0;
+        release(inode, false);
+        return 0;
+    }
+
+    int rename(const char* oldPath, const char* newPath) {
+        Lock lock(mutex_);
+        std::map<std::string, VfsInode*>::iterator it = inodes_.find(oldPath);
+        if (it == inodes_.end()) {
+            return error(ENOENT);
+        }
+        if (isDirectory(newPath)) {
+            return error(EISDIR);
+        }
+        if (it->first == newPath) {
+            return 0;
+        }
+        VfsInode* inode = it->second;
+        inodes_.erase(it);
+        std::map<std::string, VfsInode*>::iterator itNew = inodes_.find(newPath);
+        if (itNew != inodes_.end()) {
+            itNew->second->nlink = 0;
+            release(itNew->second, false);
+            itNew->second = inode;
+        }
+        else {
+            inodes_[newPath] = inode;
+        }
+        return 0;
+    }
+
+  private:
+    Vfs(const Vfs&);            // disable copy
+    Vfs& operator=(const Vfs&); // disable copy
+
+    struct Lock {
+        Lock(pthread_mutex_t& mutex) :
+            mutex_(mutex) {
+            pthread_mutex_lock(&mutex_);
+        }
+        ~Lock() {
+            pthread_mutex_unlock(&mutex_);
+        }
+        pthread_mutex_t& mutex_;
+    };
+
+    static int error(int err) {
+        errno = err;
+        return -1;
+    }
+
+    static dev_t device() {
+        return 0x6d6f636b; // "mock"
+    }
+
+    VfsFile* find(int fd) const {
+        if (!isFd(fd) || static_cast<std::size_t>(fd - MOCKF_VFS_FD_BASE) >= files_.size()) {
+            return NULL;
+        }
+        return files_[fd - MOCKF_VFS_FD_BASE];
+    }
+
+    // the mount point or a parent of a file is a directory
+    bool isDirectory(const char* path) const {
+        std::string directory(path);
+        while (directory.size() > 1 && directory[directory.size() - 1] == '/') {
+            directory.erase(directory.size() - 1);
+        }
+        if (directory == mountPoint_) {
+            return true;
+        }
+        directory += '/';
+        std::map<std::string, VfsInode*>::const_iterator it = inodes_.lower_bound(directory);
+        return it != inodes_.end() && it->first.compare(0, directory.size(), directory) == 0;
+    }
+
+    void fill(const VfsInode* inode, struct stat* buf) const {
+        blkcnt_t nbPage = 0;
+        for (std::size_t i = 0; i < inode->pages.size(); ++i) {
+            if (inode->pages[i] != NULL) {
+                ++nbPage;
+            }
+        }
+        memset(buf, 0, sizeof(*buf));
+        buf->st_dev = device();
+        buf->st_ino = inode->ino;
+        buf->st_mode = inode->mode;
+        buf->st_nlink = inode->nlink;
+        buf->st_size = inode->size;
+        buf->st_blksize = MOCKF_VFS_PAGE_SIZE;
+        buf->st_blocks = nbPage * (MOCKF_VFS_PAGE_SIZE / 512);
+    }
+
+    ssize_t readAt(const VfsInode* inode, char* buf, size_t nbytes, off_t offset) const {
+        if (offset >= inode->size) {
+            return 0;
+        }
+        if (nbytes > static_cast<size_t>(inode->size - offset)) {
+            nbytes = static_cast<size_t>(inode->size - offset);
+        }
+        size_t done = 0;
+        while (done < nbytes) {
+            std::size_t page = static_cast<std::size_t>((offset + done) / MOCKF_VFS_PAGE_SIZE);
+            size_t pageOffset = static_cast<size_t>((offset + done) % MOCKF_VFS_PAGE_SIZE);
+            size_t size = MOCKF_VFS_PAGE_SIZE - pageOffset;
+            if (size > nbytes - done) {
+                size = nbytes - done;
+            }
+            if (page < inode->pages.size() && inode->pages[page] != NULL) {
+                memcpy(buf + done, inode->pages[page] + pageOffset, size);
+            }
+            else {
+                memset(buf + done, 0, size);
+            }
+            done += size;
+        }
+        return static_cast<ssize_t>(nbytes);
+    }
+
+    ssize_t writeAt(VfsInode* inode, const char* buf, size_t n, off_t offset) {
+        size_t done = 0;
+        while (done < n) {
+            std::size_t page = static_cast<std::size_t>((offset + done) / MOCKF_VFS_PAGE_SIZE);
+            size_t pageOffset = static_cast<size_t>((offset + done) % MOCKF_VFS_PAGE_SIZE);
+            size_t size = MOCKF_VFS_PAGE_SIZE - pageOffset;
+            if (size > n - done) {
+                size = n - done;
+            }
+            if (page >= inode->pages.size()) {
+                inode->pages.resize(page + 1, NULL);
+            }
+            if (inode->pages[page] == NULL) {
+                inode->pages[page] = arena_.allocate();
+            }
+            memcpy(inode->pages[page] + pageOffset, buf + done, size);
+            done += size;
+        }
+        if (n > 0 && offset + static_cast<off_t>(n) > inode->size) {
+            inode->size = offset + static_cast<off_t>(n);
+        }
+        return static_cast<ssize_t>(n);
+    }
+
+    void truncate(VfsInode* inode, off_t size) {
+        std::size_t nbPage = static_cast<std::size_t>((size + MOCKF_VFS_PAGE_SIZE - 1) / MOCKF_VFS_PAGE_SIZE);
+        for (std::size_t i = nbPage; i < inode->pages.size(); ++i) {
+            if (inode->pages[i] != NULL) {
+                arena_.release(inode->pages[i]);
+            }
+        }
+        if (nbPage < inode->pages.size()) {
+            inode->pages.resize(nbPage);
+        }
+        inode->size = size;
+    }
+
+    // delete the inode if it is not linked and not opened
+    void release(VfsInode* inode, bool isClose) {
+        if (isClose) {
+            --inode->nbOpen;
+        }
+        if (inode->nlink == 0 && inode->nbOpen == 0) {
+            truncate(inode, 0);
+            delete inode;
+        }
+    }
+
+    std::string mountPoint_;
+    ino_t nextIno_;
+    pthread_mutex_t mutex_;
+    VfsArena arena_;
+    std::map<std::string, VfsInode*> inodes_;
+    std::vector<VfsFile*> files_;
+};
+
+/**
+ * @brief Handlers of mocks: call the virtual filesystem or the real function
+ */
+template<typename T>
+int vfsOpen(const char* file, int oflag, ...) {
+    va_list args;
+    va_start(args, oflag);
+    int mode = openMode(oflag, args);
+    va_end(args);
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && vfs->isPath(file)) {
+        return vfs->open(file, oflag, mode);
+    }
+    return T::real()(file, oflag, mode);
+}
+
+template<typename T>
+int vfsOpenat(int fd, const char* file, int oflag, ...) {
+    va_list args;
+    va_start(args, oflag);
+    int mode = openMode(oflag, args);
+    va_end(args);
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && vfs->isPath(file)) {
+        return vfs->open(file, oflag, mode); // absolute path: fd is ignored
+    }
+    return T::real()(fd, file, oflag, mode);
+}
+
+template<typename T>
+int vfsClose(int fd) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->close(fd);
+    }
+    return T::real()(fd);
+}
+
+template<typename T>
+ssize_t vfsRead(int fd, void* buf, size_t nbytes) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->read(fd, buf, nbytes);
+    }
+    return T::real()(fd, buf, nbytes);
+}
+
+template<typename T>
+ssize_t vfsWrite(int fd, const void* buf, size_t n) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->write(fd, buf, n);
+    }
+    return T::real()(fd, buf, n);
+}
+
+template<typename T>
+ssize_t vfsPread(int fd, void* buf, size_t nbytes, off_t offset) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->pread(fd, buf, nbytes, offset);
+    }
+    return T::real()(fd, buf, nbytes, offset);
+}
+
+template<typename T>
+ssize_t vfsPwrite(int fd, const void* buf, size_t n, off_t offset) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->pwrite(fd, buf, n, offset);
+    }
+    return T::real()(fd, buf, n, offset);
+}
+
+template<typename T>
+off_t vfsLseek(int fd, off_t offset, int whence) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->lseek(fd, offset, whence);
+    }
+    return T::real()(fd, offset, whence);
+}
+
+template<typename T>
+int vfsStat(const char* file, struct stat* buf) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && vfs->isPath(file)) {
+        return vfs->stat(file, buf);
+    }
+    return T::real()(file, buf);
+}
+
+template<typename T>
+int vfsFstat(int fd, struct stat* buf) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && Vfs::isFd(fd)) {
+        return vfs->fstat(fd, buf);
+    }
+    return T::real()(fd, buf);
+}
+
+template<typename T>
+int vfsUnlink(const char* name) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && vfs->isPath(name)) {
+        return vfs->unlink(name);
+    }
+    return T::real()(name);
+}
+
+template<typename T>
+int vfsRename(const char* oldPath, const char* newPath) {
+    Vfs* vfs = __atomic_load_n(&Vfs::instance(), __ATOMIC_ACQUIRE);
+    if (vfs != NULL && (vfs->isPath(oldPath) || vfs->isPath(newPath))) {
+        if (!vfs->isPath(oldPath) || !vfs->isPath(newPath)) {
+            errno = EXDEV;
+            return -1;
+        }
+        return vfs->rename(oldPath, newPath);
+    }
+    return T::real()(oldPath, newPath);
+}
+
+/**
+ * @brief Set the handlers of the virtual filesystem at load time
+ */
+template<typename Open, typename Openat, typename Close, typename Read, typename Write, typename Pread,
+         typename Pwrite, typename Lseek, typename Stat, typename Fstat, typename Unlink, typename Rename>
+struct VfsHandlers {
+    VfsHandlers() {
+        Open::setHandler(&vfsOpen<Open>);
+        Openat::setHandler(&vfsOpenat<Openat>);
+        Close::setHandler(&vfsClose<Close>);
+        Read::setHandler(&vfsRead<Read>);
+        Write::setHandler(&vfsWrite<Write>);
+        Pread::setHandler(&vfsPread<Pread>);
+        Pwrite::setHandler(&vfsPwrite<Pwrite>);
+        Lseek::setHandler(&vfsLseek<Lseek>);
+        Stat::setHandler(&vfsStat<Stat>);
+        Fstat::setHandler(&vfsFstat<Fstat>);
+        Unlink::setHandler(&vfsUnlink<Unlink>);
+        Rename::setHandler(&vfsRename<Rename>);
+    }
+};
+
+} // namespace mockf
+
+} // namespace blet
+
+#endif // #ifndef BLET_MOCKF_VFS_H_
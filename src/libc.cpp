@@ -0,0 +1,10 @@
+#include "blet/mockf/libc.h"
+
+#define MOCKF_INTERNAL_LIBC_DEFINITION_(i, r, n, f) MOCKF_INTERNAL_DEFINITION_(i, r, n, f);
+#define MOCKF_INTERNAL_LIBC_ATTRIBUTE_DEFINITION_(i, r, n, f, a) MOCKF_INTERNAL_ATTRIBUTE_DEFINITION_(i, r, n, f, a);
+#define MOCKF_INTERNAL_LIBC_VARIADIC_DEFINITION_(i, r, n, f) MOCKF_INTERNAL_VARIADIC_DEFINITION_(i, r, n, f);
+#define MOCKF_INTERNAL_LIBC_ATTRIBUTE_VARIADIC_DEFINITION_(i, r, n, f, a) \
+    MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_DEFINITION_(i, r, n, f, a);
+
+MOCKF_LIBC_FUNCTIONS(MOCKF_INTERNAL_LIBC_DEFINITION_, MOCKF_INTERNAL_LIBC_ATTRIBUTE_DEFINITION_,
+                     MOCKF_INTERNAL_LIBC_VARIADIC_DEFINITION_, MOCKF_INTERNAL_LIBC_ATTRIBUTE_VARIADIC_DEFINITION_)
@@ -0,0 +1,14 @@
+#include "blet/mockf/stub.h"
+#include "blet/mockf/libc_functions.h"
+#include "blet/mockf/preload.h"
+
+// mocks of catalog without gmock, their policies are in the control block of shared memory
+#define MOCKF_INTERNAL_PRELOAD_(i, r, n, f) MOCKF_INTERNAL_(i, r, n, f);
+#define MOCKF_INTERNAL_PRELOAD_ATTRIBUTE_(i, r, n, f, a) MOCKF_INTERNAL_ATTRIBUTE_(i, r, n, f, a);
+#define MOCKF_INTERNAL_PRELOAD_VARIADIC_(i, r, n, f) MOCKF_INTERNAL_VARIADIC_(i, r, n, f);
+#define MOCKF_INTERNAL_PRELOAD_ATTRIBUTE_VARIADIC_(i, r, n, f, a) MOCKF_INTERNAL_ATTRIBUTE_VARIADIC_(i, r, n, f, a);
+
+MOCKF_LIBC_FUNCTIONS(MOCKF_INTERNAL_PRELOAD_, MOCKF_INTERNAL_PRELOAD_ATTRIBUTE_, MOCKF_INTERNAL_PRELOAD_VARIADIC_,
+                     MOCKF_INTERNAL_PRELOAD_ATTRIBUTE_VARIADIC_)
+
+MOCKF_PRELOAD();
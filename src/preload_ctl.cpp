@@ -0,0 +1,100 @@
+#include <errno.h>  // EIO
+#include <stdio.h>  // fprintf, printf
+#include <stdlib.h> // strtod, strtoull
+#include <string.h> // strcmp
+
+#include <exception>
+
+#include "blet/mockf/preload.h"
+
+static int usage(const char* binary) {
+    fprintf(stderr,
+            "usage: %s [-s SHM] COMMAND\n"
+            "  list                          list the mocks and their number of calls\n"
+            "  enable NAME                   enable the policy of mock\n"
+            "  disable NAME                  disable the policy of mock\n"
+            "  clear NAME                    remove the failure, short and delays of mock\n"
+            "  failure NAME PROBABILITY [ERRNO]\n"
+            "  short NAME SIZE [PROBABILITY]\n"
+            "  delay NAME NANOSECONDS [WEIGHT]\n"
+            "  unlink                        remove the shared memory\n",
+            binary);
+    return 2;
+}
+
+static blet::mockf::PreloadSlot* slot(blet::mockf::PreloadControl& control, const char* name) {
+    // the slot can be created before the start of the mocked process
+    blet::mockf::PreloadSlot* ret = control.acquire(name);
+    if (ret == NULL) {
+        fprintf(stderr, "%s: control block is full\n", name);
+    }
+    return ret;
+}
+
+int main(int argc, char* argv[]) {
+    const char* shm = blet::mockf::Preload::environmentName();
+    int index = 1;
+    if (index + 1 < argc && strcmp(argv[index], "-s") == 0) {
+        shm = argv[index + 1];
+        index += 2;
+    }
+    if (index >= argc) {
+        return usage(argv[0]);
+    }
+    const char* command = argv[index];
+    char** args = argv + index + 1;
+    int nbArgs = argc - index - 1;
+
+    if (strcmp(command, "unlink") == 0) {
+        return blet::mockf::Preload::unlink(shm) ? 0 : 1;
+    }
+
+    try {
+        blet::mockf::Preload preload(shm, blet::mockf::Preload::CONTROL);
+        blet::mockf::PreloadControl& control = preload.control();
+        if (strcmp(command, "list") == 0) {
+            for (unsigned int i = 0; i < MOCKF_PRELOAD_SLOTS_MAX; ++i) {
+                blet::mockf::PreloadSlot& s = control.slots[i];
+                if (__atomic_load_n(&s.state, __ATOMIC_ACQUIRE) != blet::mockf::PreloadSlot::READY) {
+                    break;
+                }
+                printf("%s %s %llu\n", s.name, s.policy.isEnable() ? "enable" : "disable",
+                       static_cast<unsigned long long>(s.policy.count()));
+            }
+            return 0;
+        }
+        if (nbArgs < 1) {
+            return usage(argv[0]);
+        }
+        blet::mockf::PreloadSlot* s = slot(control, args[0]);
+        if (s == NULL) {
+            return 1;
+        }
+        if (strcmp(command, "enable") == 0) {
+            s->policy.enable(true);
+        }
+        else if (strcmp(command, "disable") == 0) {
+            s->policy.enable(false);
+        }
+        else if (strcmp(command, "clear") == 0) {
+            s->policy.clear();
+        }
+        else if (strcmp(command, "failure") == 0 && nbArgs >= 2) {
+            s->policy.failure(strtod(args[1], NULL), nbArgs >= 3 ? atoi(args[2]) : EIO);
+        }
+        else if (strcmp(command, "short") == 0 && nbArgs >= 2) {
+            s->policy.shortIo(strtoull(args[1], NULL, 10), nbArgs >= 3 ? strtod(args[2], NULL) : 1.0);
+        }
+        else if (strcmp(command, "delay") == 0 && nbArgs >= 2) {
+            s->policy.delay(strtoull(args[1], NULL, 10), nbArgs >= 3 ? strtoull(args[2], NULL, 10) : 1);
+        }
+        else {
+            return usage(argv[0]);
+        }
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
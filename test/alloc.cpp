@@ -0,0 +1,61 @@
+#include <gtest/gtest-spi.h>
+#include <stdlib.h> // malloc, free
+
+#include <string>
+#include <vector>
+
+#include "blet/mockf/alloc.h"
+
+MOCKF_ALLOC_FUNCTIONS();
+
+// not removed by the optimizer
+static void* volatile sink = NULL;
+
+TEST(mockf, alloc_counters) {
+    blet::mockf::Alloc::resetThread();
+
+    sink = malloc(100);
+    EXPECT_EQ(blet::mockf::Alloc::thread().allocations, 1u);
+    EXPECT_GE(blet::mockf::Alloc::thread().bytes, 100u);
+    EXPECT_GE(blet::mockf::Alloc::thread().liveBytes, 100);
+    sink = realloc(sink, 4096);
+    EXPECT_EQ(blet::mockf::Alloc::thread().allocations, 2u);
+    EXPECT_EQ(blet::mockf::Alloc::thread().deallocations, 1u);
+    free(sink);
+    EXPECT_EQ(blet::mockf::Alloc::thread().deallocations, 2u);
+    EXPECT_EQ(blet::mockf::Alloc::thread().liveBytes, 0);
+    EXPECT_GE(blet::mockf::Alloc::thread().peakBytes, 4096);
+
+    // operator new and delete use malloc and free
+    int* value = new int(42);
+    EXPECT_EQ(blet::mockf::Alloc::thread().allocations, 3u);
+    delete value;
+    EXPECT_EQ(blet::mockf::Alloc::thread().liveBytes, 0);
+
+    void* aligned = NULL;
+    EXPECT_EQ(posix_memalign(&aligned, 256, 1000), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 256, 0u);
+    free(aligned);
+    EXPECT_EQ(blet::mockf::Alloc::thread().allocations, 4u);
+    EXPECT_EQ(blet::mockf::Alloc::thread().liveBytes, 0);
+
+    // resolution of real functions
+    EXPECT_LT(blet::mockf::Alloc::bootstrapSize(), static_cast<size_t>(MOCKF_ALLOC_BOOTSTRAP_SIZE));
+}
+
+TEST(mockf, alloc_no_alloc) {
+    std::vector<char> buffer;
+    buffer.reserve(64); // warm-up
+
+    MOCKF_ASSERT_NO_ALLOC {
+        for (int i = 0; i < 64; ++i) {
+            buffer.push_back('a');
+        }
+    }
+
+    EXPECT_NONFATAL_FAILURE(
+        MOCKF_ASSERT_NO_ALLOC {
+            buffer.push_back('b'); // hidden allocation
+        },
+        "1 allocation(s)");
+}
@@ -0,0 +1,36 @@
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+extern "C" {
+int mockf_arguments15(int, int, int, int, int, int, int, int, int, int, int, int, int, int, int);
+int mockf_variadic15(int, int, int, int, int, int, int, int, int, int, int, int, int, int, ...);
+}
+
+MOCKF_FUNCTION15(int, mockf_arguments15,
+                 (int, int, int, int, int, int, int, int, int, int, int, int, int, int, int));
+MOCKF_VARIADIC_FUNCTION15(int, mockf_variadic15,
+                          (int, int, int, int, int, int, int, int, int, int, int, int, int, int, ...));
+
+TEST(mockf, example_arguments) {
+    MOCKF_INIT(mockf_arguments15);
+    MOCKF_EXPECT_CALL(mockf_arguments15, (1, _, _, _, _, _, _, _, _, _, _, _, _, _, 15)).WillOnce(Return(42));
+    {
+        MOCKF_GUARD(mockf_arguments15);
+        EXPECT_EQ(mockf_arguments15(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), 42);
+    }
+    EXPECT_THROW(mockf_arguments15(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                 blet::mockf::RealFunctionNotFound);
+}
+
+TEST(mockf, example_variadic_arguments) {
+    MOCKF_INIT(mockf_variadic15);
+    MOCKF_EXPECT_CALL(mockf_variadic15, (1, _, _, _, _, _, _, _, _, _, _, _, _, 14, _)).WillOnce(Return(42));
+    {
+        MOCKF_GUARD(mockf_variadic15);
+        EXPECT_EQ(mockf_variadic15(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), 42);
+    }
+    EXPECT_THROW(mockf_variadic15(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                 blet::mockf::RealFunctionNotFound);
+}
@@ -0,0 +1,70 @@
+// test the variadic MOCKF_BUDGET with C++11
+#undef MOCKF_DISABLE_VARIADIC_MACROS
+
+#include <gtest/gtest-spi.h>
+#include <fcntl.h>  // open
+#include <unistd.h> // write
+
+#include "blet/mockf/budget.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+static char buffer[1 << 16] = {0};
+
+TEST(mockf, budget_batching) {
+    int fd = open("/dev/null", O_WRONLY);
+    {
+        // real function
+        MOCKF_BUDGET(write, calls <= 4, bytes >= 1 << 18);
+        for (int i = 0; i < 4; ++i) {
+            write(fd, buffer, sizeof(buffer));
+        }
+    }
+    {
+        MOCKF_BUDGET3(write, calls == 2, mocked == 1, maxSize <= 16);
+        MOCKF_INIT(write);
+        MOCKF_EXPECT_CALL(write, (fd, _, 8)).WillOnce(Return(8));
+        {
+            MOCKF_GUARD(write);
+            write(fd, buffer, 8);
+        }
+        write(fd, buffer, 16);
+    }
+    close(fd);
+}
+
+TEST(mockf, budget_exceeded) {
+    int fd = open("/dev/null", O_WRONLY);
+    EXPECT_NONFATAL_FAILURE(
+        {
+            MOCKF_BUDGET2(write, calls <= 2, minSize >= 512);
+            write(fd, buffer, 1024);
+            write(fd, buffer, 100);
+            write(fd, buffer, 1024);
+        },
+        "budget (calls <= 2, minSize >= 512) exceeded:\n"
+        "  calls <= 2 (calls: 3)\n"
+        "  minSize >= 512 (minSize: 100)\n"
+        "  calls: 3 (mocked: 0), bytes: 2148\n"
+        "  call 1: 1024 bytes (real)\n"
+        "  call 2: 100 bytes (real)\n"
+        "  call 3: 1024 bytes (real)");
+
+    // nested budgets
+    EXPECT_NONFATAL_FAILURE(
+        {
+            MOCKF_BUDGET1(write, calls == 2);
+            {
+                MOCKF_BUDGET1(write, calls == 1);
+                write(fd, buffer, 1);
+            }
+            write(fd, buffer, 1);
+            write(fd, buffer, 1);
+        },
+        "calls == 2 (calls: 3)");
+    EXPECT_TRUE(MOCKF_CLASS(write)::budget() == NULL);
+    close(fd);
+}
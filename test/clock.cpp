@@ -0,0 +1,96 @@
+#include <sys/time.h> // gettimeofday
+#include <time.h>     // clock_gettime, nanosleep
+#include <unistd.h>   // sleep, usleep
+
+#include "blet/mockf/clock.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+// only in one source file of the binary
+MOCKF_CLOCK_FUNCTIONS();
+
+static uint64_t monotonic() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return blet::mockf::VirtualClock::toNs(ts);
+}
+
+TEST(mockf, clock_sleep) {
+    uint64_t realStart = blet::mockf::Clock::now();
+    {
+        blet::mockf::VirtualClock clock;
+        uint64_t start = monotonic();
+
+        EXPECT_EQ(sleep(3600), 0u);
+        EXPECT_EQ(monotonic() - start, 3600000000000ull);
+        EXPECT_EQ(usleep(500), 0);
+        struct timespec req = {1, 5};
+        struct timespec rem = {42, 42};
+        EXPECT_EQ(nanosleep(&req, &rem), 0);
+        EXPECT_EQ(rem.tv_sec, 0);
+        EXPECT_EQ(rem.tv_nsec, 0);
+        EXPECT_EQ(monotonic() - start, 3601000500005ull);
+        EXPECT_EQ(clock.nbSleep(), 3u);
+        EXPECT_EQ(clock.sleptNs(), 3601000500005ull);
+
+        // absolute sleep
+        struct timespec deadline;
+        blet::mockf::VirtualClock::toTimespec(monotonic() + 1000, &deadline);
+        EXPECT_EQ(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL), 0);
+        EXPECT_EQ(monotonic() - start, 3601000501005ull);
+        // in the past
+        EXPECT_EQ(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL), 0);
+        EXPECT_EQ(monotonic() - start, 3601000501005ull);
+        req.tv_nsec = -1;
+        EXPECT_EQ(clock_nanosleep(CLOCK_MONOTONIC, 0, &req, NULL), EINVAL);
+    }
+    // real time
+    EXPECT_LT(blet::mockf::Clock::now() - realStart, 3600000000000ull);
+    EXPECT_GE(monotonic(), realStart);
+}
+
+TEST(mockf, clock_realtime) {
+    blet::mockf::VirtualClock clock;
+    clock.setRealtime(1000000000, 250000000);
+    EXPECT_EQ(time(NULL), 1000000000);
+    struct timeval tv;
+    EXPECT_EQ(gettimeofday(&tv, NULL), 0);
+    EXPECT_EQ(tv.tv_sec, 1000000000);
+    EXPECT_EQ(tv.tv_usec, 250000);
+
+    clock.advance(750000000);
+    time_t timer = 0;
+    EXPECT_EQ(time(&timer), 1000000001);
+    EXPECT_EQ(timer, 1000000001);
+
+    // auto-advance at each read
+    clock.autoAdvance(1000);
+    uint64_t t1 = monotonic();
+    uint64_t t2 = monotonic();
+    EXPECT_EQ(t2 - t1, 1000u);
+
+    // absolute realtime sleep
+    clock.autoAdvance(0);
+    uint64_t start = monotonic();
+    struct timespec deadline = {1000000002, 0};
+    EXPECT_EQ(clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &deadline, NULL), 0);
+    EXPECT_EQ(time(NULL), 1000000002);
+    // before the offset of the realtime clock: the time does not change
+    deadline.tv_sec = 0;
+    EXPECT_EQ(clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &deadline, NULL), 0);
+    EXPECT_EQ(time(NULL), 1000000002);
+    EXPECT_LT(monotonic() - start, 2000000000ull);
+
+    // cpu time is not virtual
+    struct timespec ts;
+    EXPECT_EQ(clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts), 0);
+}
+
+TEST(mockf, clock_mock_priority) {
+    blet::mockf::VirtualClock clock;
+    MOCKF_INIT(time);
+    MOCKF_EXPECT_CALL(time, (_)).WillOnce(Return(42));
+    MOCKF_GUARD(time);
+    EXPECT_EQ(time(NULL), 42);
+}
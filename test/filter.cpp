@@ -0,0 +1,118 @@
+#include <fcntl.h>    // open
+#include <sys/stat.h> // stat
+#include <unistd.h>   // write, pipe
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+MOCKF_FUNCTION2(int, stat, (const char* /* path */, struct stat* /* buf */));
+
+enum FilterKind {
+    FILTER_KIND = 5
+};
+
+static bool isSmallWrite(const blet::mockf::FilterCall& call) {
+    return call.integer(2) < 4;
+}
+
+TEST(mockf, filter_eq) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    blet::mockf::FilterEq filter(0, 7);
+    MOCKF_INIT(write);
+    MOCKF_SET_FILTER(write, &filter);
+    MOCKF_EXPECT_CALL(write, (7, _, 3)).WillOnce(Return(3));
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(7, "abc", 3), 3);
+        // not matched: real function
+        EXPECT_EQ(write(fds[1], "abcd", 4), 4);
+    }
+    MOCKF_RESET_FILTER(write);
+    EXPECT_TRUE(MOCKF_CLASS(write)::filter() == NULL);
+    char buffer[8];
+    EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 4);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(mockf, filter_prefix) {
+    blet::mockf::FilterPrefix filter(0, "/data/");
+    MOCKF_INIT(stat);
+    MOCKF_SET_FILTER(stat, &filter);
+    MOCKF_EXPECT_CALL(stat, (_, _)).WillOnce(Return(0));
+    {
+        MOCKF_GUARD(stat);
+        struct stat st;
+        EXPECT_EQ(stat("/data/not_exists", &st), 0);
+        EXPECT_EQ(stat("/not_exists", &st), -1);
+        EXPECT_EQ(stat("/data", &st), -1);
+    }
+    MOCKF_RESET_FILTER(stat);
+}
+
+TEST(mockf, filter_prefix_of_integer) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    // the fd is not a string: not matched
+    blet::mockf::FilterPrefix filter(0, "/data");
+    MOCKF_INIT(write);
+    MOCKF_SET_FILTER(write, &filter);
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(fds[1], "abc", 3), 3);
+    }
+    MOCKF_RESET_FILTER(write);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(mockf, filter_call) {
+    const char* str = "str";
+    blet::mockf::FilterCall call;
+    call.add(static_cast<short>(-2)).add('x').add(true).add(FILTER_KIND).add(static_cast<unsigned short>(8080));
+    call.add(str).add(1.5);
+    EXPECT_EQ(call.size(), 7u);
+    EXPECT_EQ(call.integer(0), -2);
+    EXPECT_EQ(call.integer(1), 'x');
+    EXPECT_EQ(call.integer(2), 1);
+    EXPECT_EQ(call.integer(3), 5);
+    EXPECT_EQ(call.integer(4), 8080);
+    EXPECT_STREQ(call.string(5), "str");
+    // not a pointer or out of range
+    EXPECT_TRUE(call.pointer(0) == NULL);
+    EXPECT_TRUE(call.string(4) == NULL);
+    EXPECT_TRUE(call.pointer(6) == NULL);
+    EXPECT_EQ(call.integer(6), 0);
+}
+
+TEST(mockf, filter_predicate) {
+    int fd = open("/dev/null", O_WRONLY);
+    MOCKF_INIT(write);
+    MOCKF_EXPECT_CALL(write, (fd, _, 1)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(write);
+        blet::mockf::FilterPredicate<bool (*)(const blet::mockf::FilterCall&)> filter(&isSmallWrite);
+        MOCKF_SET_FILTER(write, &filter);
+        EXPECT_EQ(write(fd, "a", 1), -1);
+        EXPECT_EQ(write(fd, "abcdef", 6), 6);
+        MOCKF_RESET_FILTER(write);
+    }
+#if __cplusplus >= 201103L
+    MOCKF_EXPECT_CALL(write, (fd, _, 6)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(write);
+        auto filter = blet::mockf::makeFilter([fd](const blet::mockf::FilterCall& call) {
+            return call.integer(0) == fd && call.integer(2) > 4;
+        });
+        MOCKF_SET_FILTER(write, &filter);
+        EXPECT_EQ(write(fd, "a", 1), 1);
+        EXPECT_EQ(write(fd, "abcdef", 6), -1);
+        MOCKF_RESET_FILTER(write);
+    }
+#endif
+    close(fd);
+}
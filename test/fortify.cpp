@@ -0,0 +1,158 @@
+#include <errno.h>    // EIO
+#include <pthread.h>  // pthread_key_create, pthread_setspecific
+#include <stdio.h>    // __printf_chk
+#include <string.h>   // memcpy
+#include <sys/stat.h> // stat
+#include <unistd.h>   // __read_chk
+
+#include "blet/mockf/fortify.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+// this source file is built with -O2 -D_FORTIFY_SOURCE=2
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+MOCKF_ATTRIBUTE_FUNCTION3(void*, memcpy,
+                          (void* __restrict /* dest */, const void* __restrict /* src */, size_t /* n */), throw());
+MOCKF_VARIADIC_FUNCTION2(int, printf, (const char* /* format */, ...));
+MOCKF_VARIADIC_FUNCTION3(int, dprintf, (int /* fd */, const char* /* format */, ...));
+MOCKF_ATTRIBUTE_FUNCTION2(int, stat, (const char* __restrict /* file */, struct stat* __restrict /* buf */), throw());
+
+// the fortified code of the other sources calls __read_chk, __memcpy_chk, __printf_chk, __dprintf_chk and __xstat
+MOCKF_FORTIFY(read);
+MOCKF_FORTIFY(memcpy);
+MOCKF_FORTIFY(printf);
+MOCKF_FORTIFY(dprintf);
+MOCKF_FORTIFY(stat);
+
+#if defined(__GLIBC__) && defined(__x86_64__)
+// compat symbol of glibc without default version (not found by dlsym)
+extern "C" void* __pthread_getspecific(pthread_key_t key) throw();
+MOCKF_ATTRIBUTE_FUNCTION1(void*, __pthread_getspecific, (pthread_key_t /* key */), throw());
+MOCKF_SYMBOL_VERSION(__pthread_getspecific, "GLIBC_2.2.5");
+#endif
+
+ACTION_P(stat, st_mode) {
+    arg1->st_mode = st_mode;
+    return 0;
+}
+
+TEST(mockf, fortify_read) {
+    MOCKF_INIT(read);
+
+    MOCKF_EXPECT_CALL(read, (42, _, 4)).WillOnce(Return(4));
+
+    char buffer[8];
+    volatile size_t size = sizeof(buffer);
+    volatile size_t overflow = 16;
+    {
+        MOCKF_GUARD(read);
+        EXPECT_EQ(__read_chk(42, buffer, 4, size), 4);
+    }
+    // same check as the libc
+    ssize_t ret = 0;
+    EXPECT_DEATH(ret = __read_chk(42, buffer, overflow, size), "buffer overflow detected");
+    (void)ret;
+}
+
+TEST(mockf, fortify_memcpy) {
+    MOCKF_INIT(memcpy);
+
+    char dest[8];
+    const char src[] = "mockf";
+    MOCKF_EXPECT_CALL(memcpy, (dest, src, sizeof(src))).WillOnce(Return(dest));
+
+    {
+        MOCKF_GUARD(memcpy);
+        EXPECT_EQ(__memcpy_chk(dest, src, sizeof(src), sizeof(dest)), dest);
+    }
+    // disabled: real memcpy
+    EXPECT_EQ(__memcpy_chk(dest, src, sizeof(src), sizeof(dest)), dest);
+    EXPECT_STREQ(dest, "mockf");
+}
+
+TEST(mockf, fortify_printf) {
+    MOCKF_INIT(printf);
+
+    MOCKF_EXPECT_CALL(printf, (StrEq("%d\n"), _)).WillOnce(Return(-42));
+
+    {
+        MOCKF_GUARD(printf);
+        EXPECT_EQ(__printf_chk(1, "%d\n", 42), -42);
+    }
+    // disabled: real vprintf
+    EXPECT_EQ(__printf_chk(1, "%s", ""), 0);
+}
+
+static int printfHandler(const char* /* format */, ...) {
+    return 42;
+}
+
+TEST(mockf, fortify_printf_hooks) {
+    // the policy is evaluated before the real vprintf
+    blet::mockf::Policy policy;
+    policy.failure(1.0, EIO);
+    MOCKF_SET_POLICY(printf, &policy);
+    errno = 0;
+    EXPECT_EQ(__printf_chk(1, "%s", "mockf"), -1);
+    EXPECT_EQ(errno, EIO);
+    EXPECT_EQ(policy.count(), 1u);
+    MOCKF_RESET_POLICY(printf);
+
+    // the handler is not bypassed by the v-variant
+    MOCKF_SET_HANDLER(printf, &printfHandler);
+    EXPECT_THROW(__printf_chk(1, "%s", "mockf"), blet::mockf::RealVariadicFunctionUsed);
+    MOCKF_RESET_HANDLER(printf);
+    EXPECT_EQ(__printf_chk(1, "%s", ""), 0);
+}
+
+TEST(mockf, fortify_dprintf_filter) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    blet::mockf::FilterEq filter(0, 42);
+    MOCKF_INIT(dprintf);
+    MOCKF_SET_FILTER(dprintf, &filter);
+    MOCKF_EXPECT_CALL(dprintf, (42, StrEq("%s"), _)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(dprintf);
+        EXPECT_EQ(__dprintf_chk(42, 1, "%s", "mockf"), -1);
+        // not matched: real vdprintf
+        EXPECT_EQ(__dprintf_chk(fds[1], 1, "%s", "mockf"), 5);
+    }
+    MOCKF_RESET_FILTER(dprintf);
+    char buffer[8];
+    EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 5);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(mockf, fortify_xstat) {
+    MOCKF_INIT(stat);
+
+    MOCKF_EXPECT_CALL(stat, (StrEq("nothing"), _)).WillOnce(stat(__S_IFREG));
+
+    struct stat statOfMock;
+    {
+        MOCKF_GUARD(stat);
+        EXPECT_EQ(__xstat(1, "nothing", &statOfMock), 0);
+    }
+    EXPECT_EQ(statOfMock.st_mode, static_cast<mode_t>(__S_IFREG));
+    // disabled: real stat
+    EXPECT_EQ(__xstat(1, "/", &statOfMock), 0);
+    EXPECT_TRUE(S_ISDIR(statOfMock.st_mode));
+}
+
+#if defined(__GLIBC__) && defined(__x86_64__)
+TEST(mockf, symbol_version) {
+    EXPECT_TRUE(MOCKF_CLASS(__pthread_getspecific)::isResolved());
+
+    pthread_key_t key;
+    int value = 42;
+    ASSERT_EQ(pthread_key_create(&key, NULL), 0);
+    ASSERT_EQ(pthread_setspecific(key, &value), 0);
+    // real function from the versioned symbol
+    EXPECT_EQ(__pthread_getspecific(key), &value);
+    pthread_key_delete(key);
+}
+#endif
@@ -1,3 +1,4 @@
+#include <errno.h>     // errno
 #include <sys/ioctl.h> // ioctl
 
 #include "blet/mockf.h"
@@ -28,3 +29,13 @@ TEST(mockf, ioctl) {
         EXPECT_EQ(ioctl(42, 0, 1, 2), -42); // use mock
     }                                       // disable call to mock
 }
+
+TEST(mockf, ioctl_real) {
+    MOCKF_INIT(ioctl);
+
+    // the third argument is forwarded to the real function
+    int nbytes = 0;
+    errno = 0;
+    EXPECT_EQ(ioctl(-1, FIONREAD, &nbytes), -1); // use real
+    EXPECT_EQ(errno, EBADF);
+}
@@ -0,0 +1,126 @@
+#include <sys/uio.h> // readv, writev
+
+#include <sstream>
+
+#include "blet/mockf/iovec.h"
+
+using ::testing::_;
+using ::testing::Gt;
+using ::testing::Not;
+using ::testing::Return;
+
+// only in one source file of the binary
+MOCKF_IOVEC_FUNCTIONS();
+
+static struct iovec segment(const char* str) {
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(str);
+    iov.iov_len = strlen(str);
+    return iov;
+}
+
+TEST(mockf, example_iovec) {
+    MOCKF_INIT(writev);
+
+    std::string out;
+    MOCKF_EXPECT_CALL(writev, (42, _, 3))
+        .With(MOCKF_IOVEC_ARGS(blet::mockf::IovecEq("GET / HTTP/1.1\r\n\r\n")))
+        .WillOnce(blet::mockf::GatherIovec(&out));
+
+    struct iovec iov[3] = {segment("GET "), segment("/ "), segment("HTTP/1.1\r\n\r\n")};
+    MOCKF_GUARD(writev);
+    EXPECT_EQ(writev(42, iov, 3), 18);
+    EXPECT_EQ(out, "GET / HTTP/1.1\r\n\r\n");
+}
+
+TEST(mockf, iovec_matchers) {
+    typedef ::testing::tuple<const struct iovec*, int> Args; // arguments of MOCKF_IOVEC_ARGS
+    struct iovec iov[3] = {segment("mock"), segment(""), segment("f iovec")};
+    Args args(iov, 3);
+
+    EXPECT_THAT(args, blet::mockf::IovecEq("mockf iovec"));
+    EXPECT_THAT(args, Not(blet::mockf::IovecEq("mockf")));
+    EXPECT_THAT(args, Not(blet::mockf::IovecEq("mockf iovec!")));
+    EXPECT_THAT(args, Not(blet::mockf::IovecEq("mockF iovec")));
+    EXPECT_THAT(args, blet::mockf::IovecEq("mockf iovec!", 11));
+    EXPECT_THAT(args, blet::mockf::IovecStartsWith("mockf"));
+    EXPECT_THAT(args, Not(blet::mockf::IovecStartsWith("mockf iovec!")));
+    EXPECT_THAT(args, blet::mockf::IovecSize(11));
+    EXPECT_THAT(args, blet::mockf::IovecSize(Gt(10u)));
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = 3;
+    const struct msghdr* constMessage = &message;
+    EXPECT_THAT(constMessage, blet::mockf::IovecEq("mockf iovec"));
+
+    // the message shows the difference
+    ::testing::Matcher<Args> matcher = blet::mockf::IovecEq("mockF");
+    ::testing::StringMatchResultListener listener;
+    EXPECT_FALSE(matcher.MatchAndExplain(args, &listener));
+    EXPECT_EQ(listener.str(), "whose payload is \"mockf iovec\" (11 byte(s) in 3 iovec(s)), different at offset 4");
+    std::ostringstream oss;
+    ::testing::Matcher<Args>(blet::mockf::IovecStartsWith("a\n\"")).DescribeTo(&oss);
+    EXPECT_EQ(oss.str(), "has a payload starting with \"a\\x0a\\\"\"");
+}
+
+TEST(mockf, iovec_partial_write) {
+    MOCKF_INIT(writev);
+
+    // short writes of 5 bytes
+    std::string out;
+    MOCKF_EXPECT_CALL(writev, (_, _, _)).WillRepeatedly(blet::mockf::GatherIovec(&out, 5));
+
+    struct iovec iov[2] = {segment("mockf "), segment("iovec")};
+    MOCKF_GUARD(writev);
+    ssize_t done = 0;
+    while (done < 11) {
+        // resume after the written bytes
+        struct iovec rest[2] = {iov[0], iov[1]};
+        int first = done < 6 ? 0 : 1;
+        size_t skip = static_cast<size_t>(first == 0 ? done : done - 6);
+        rest[first].iov_base = static_cast<char*>(rest[first].iov_base) + skip;
+        rest[first].iov_len -= skip;
+        ssize_t ret = writev(1, rest + first, 2 - first);
+        ASSERT_GT(ret, 0);
+        EXPECT_LE(ret, 5);
+        done += ret;
+    }
+    EXPECT_EQ(out, "mockf iovec");
+}
+
+TEST(mockf, iovec_scatter) {
+    MOCKF_INIT(readv);
+    MOCKF_INIT(recvmsg);
+    MOCKF_GUARD(readv);
+    MOCKF_GUARD(recvmsg);
+
+    // the fixture is read by chunks of 4 bytes
+    MOCKF_EXPECT_CALL(readv, (3, _, _)).WillRepeatedly(blet::mockf::ScatterIovec("0123456789", 4));
+    char a[3] = {0};
+    char b[8] = {0};
+    struct iovec iov[2];
+    iov[0].iov_base = a;
+    iov[0].iov_len = sizeof(a) - 1;
+    iov[1].iov_base = b;
+    iov[1].iov_len = sizeof(b) - 1;
+    EXPECT_EQ(readv(3, iov, 2), 4);
+    EXPECT_STREQ(a, "01");
+    EXPECT_STREQ(b, "23");
+    EXPECT_EQ(readv(3, iov, 2), 4);
+    EXPECT_STREQ(a, "45");
+    EXPECT_EQ(readv(3, iov, 2), 2);
+    EXPECT_STREQ(a, "89");
+    EXPECT_EQ(readv(3, iov, 2), 0); // end of fixture
+
+    MOCKF_EXPECT_CALL(recvmsg, (3, _, 0)).WillOnce(blet::mockf::ScatterIovec("mockf"));
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = 2;
+    memset(b, 0, sizeof(b));
+    EXPECT_EQ(recvmsg(3, &message, 0), 5);
+    EXPECT_STREQ(a, "mo");
+    EXPECT_STREQ(b, "ckf");
+}
@@ -0,0 +1,45 @@
+#include <errno.h> // EACCES
+
+#include "blet/mockf/libc.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::StrEq;
+
+TEST(mockf, example_libc) {
+    MOCKF_INIT(write);
+    MOCKF_INIT(stat);
+
+    MOCKF_EXPECT_CALL(write, (42, _, 5)).WillOnce(Return(5));
+    MOCKF_EXPECT_CALL(stat, (StrEq("/mockf"), _)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(write);
+        MOCKF_GUARD(stat);
+        EXPECT_EQ(write(42, "mockf", 5), 5);
+        struct stat st;
+        EXPECT_EQ(stat("/mockf", &st), -1);
+    }
+
+    // use real
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(write(fds[1], "mockf", 5), 5);
+    char buffer[5];
+    EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 5);
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_EQ(MOCKF_CLASS(write)::isResolved(), true);
+}
+
+TEST(mockf, example_libc_variadic) {
+    MOCKF_INIT(open);
+
+    MOCKF_EXPECT_CALL(open, (StrEq("/mockf"), O_RDONLY, _)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(open);
+        EXPECT_EQ(open("/mockf", O_RDONLY), -1);
+    }
+    int fd = open("/dev/null", O_RDONLY); // use real
+    EXPECT_GE(fd, 0);
+    close(fd);
+}
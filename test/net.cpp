@@ -0,0 +1,407 @@
+#include <arpa/inet.h> // inet_pton
+#include <pthread.h>   // pthread_create
+
+#include "blet/mockf/net.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+// only in one source file of the binary
+MOCKF_NET_FUNCTIONS();
+
+static struct sockaddr_in address(const char* ip, uint16_t port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, ip, &addr.sin_addr);
+    return addr;
+}
+
+static int listenOn(const char* ip, uint16_t port, int backlog = 16) {
+    struct sockaddr_in addr = address(ip, port);
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    EXPECT_EQ(bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+    EXPECT_EQ(listen(fd, backlog), 0);
+    return fd;
+}
+
+static int connectTo(const char* ip, uint16_t port, int type = SOCK_STREAM) {
+    struct sockaddr_in addr = address(ip, port);
+    int fd = socket(AF_INET, type, 0);
+    EXPECT_EQ(connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+    return fd;
+}
+
+TEST(mockf, example_net) {
+    blet::mockf::Net net;
+
+    int server = listenOn("0.0.0.0", 8080);
+    ASSERT_TRUE(blet::mockf::Net::isFd(server));
+    int epfd = epoll_create1(0);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = server;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, server, &event), 0);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 0);
+
+    int client = connectTo("127.0.0.1", 8080);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    EXPECT_EQ(event.data.fd, server);
+    struct sockaddr_in peer;
+    socklen_t len = sizeof(peer);
+    int accepted = accept(server, reinterpret_cast<struct sockaddr*>(&peer), &len);
+    ASSERT_TRUE(blet::mockf::Net::isFd(accepted));
+    EXPECT_EQ(len, sizeof(peer));
+    EXPECT_EQ(peer.sin_addr.s_addr, htonl(INADDR_LOOPBACK));
+    EXPECT_EQ(ntohs(peer.sin_port), MOCKF_NET_EPHEMERAL_PORT);
+    EXPECT_EQ(accept(server, NULL, NULL), -1);
+    EXPECT_EQ(errno, EAGAIN);
+
+    // echo
+    char buffer[32] = {0};
+    EXPECT_EQ(send(client, "mockf net", 9, 0), 9);
+    EXPECT_EQ(recv(accepted, buffer, 5, MSG_PEEK), 5);
+    EXPECT_EQ(read(accepted, buffer, sizeof(buffer)), 9);
+    EXPECT_EQ(write(accepted, buffer, 9), 9);
+    memset(buffer, 0, sizeof(buffer));
+    struct iovec iov[2];
+    iov[0].iov_base = buffer;
+    iov[0].iov_len = 6;
+    iov[1].iov_base = buffer + 10;
+    iov[1].iov_len = 10;
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = 2;
+    EXPECT_EQ(recvmsg(client, &message, 0), 9);
+    EXPECT_STREQ(buffer, "mockf ");
+    EXPECT_STREQ(buffer + 10, "net");
+
+    // end of stream
+    EXPECT_EQ(close(client), 0);
+    EXPECT_EQ(recv(accepted, buffer, sizeof(buffer), 0), 0);
+    EXPECT_EQ(send(accepted, "x", 1, MSG_NOSIGNAL), -1);
+    EXPECT_EQ(errno, EPIPE);
+    EXPECT_EQ(close(accepted), 0);
+    EXPECT_EQ(close(accepted), -1);
+    EXPECT_EQ(errno, EBADF);
+
+    // the listener is removed at close
+    EXPECT_EQ(close(server), 0);
+    struct sockaddr_in addr = address("127.0.0.1", 8080);
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_EQ(connect(client, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), -1);
+    EXPECT_EQ(errno, ECONNREFUSED);
+    EXPECT_EQ(close(client), 0);
+    EXPECT_EQ(close(epfd), 0);
+    EXPECT_EQ(net.nbConnection(), 1u);
+}
+
+TEST(mockf, net_backpressure) {
+    blet::mockf::Net net;
+    int server = listenOn("127.0.0.1", 8080);
+    int client = connectTo("127.0.0.1", 8080);
+    int accepted = accept4(server, NULL, NULL, SOCK_NONBLOCK);
+    EXPECT_EQ(fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK), 0);
+    EXPECT_EQ(fcntl(client, F_GETFL) & O_NONBLOCK, O_NONBLOCK);
+
+    // fill the buffer of the connection
+    std::vector<char> data(MOCKF_NET_BUFFER_SIZE / 4, 'x');
+    size_t total = 0;
+    for (;;) {
+        ssize_t ret = send(client, &data[0], data.size() - 1, 0);
+        if (ret < 0) {
+            EXPECT_EQ(errno, EAGAIN);
+            break;
+        }
+        total += static_cast<size_t>(ret);
+    }
+    EXPECT_EQ(total, static_cast<size_t>(MOCKF_NET_BUFFER_SIZE));
+    struct pollfd fds[2];
+    fds[0].fd = client;
+    fds[0].events = POLLOUT;
+    fds[1].fd = accepted;
+    fds[1].events = POLLIN;
+    EXPECT_EQ(poll(fds, 2, 0), 1);
+    EXPECT_EQ(fds[0].revents, 0);
+    EXPECT_EQ(fds[1].revents, POLLIN);
+
+    // the read frees the space
+    EXPECT_EQ(recv(accepted, &data[0], 100, 0), 100);
+    EXPECT_EQ(poll(fds, 2, 0), 2);
+    EXPECT_EQ(fds[0].revents, POLLOUT);
+    EXPECT_EQ(send(client, &data[0], data.size(), 0), 100);
+
+    close(accepted);
+    close(client);
+    close(server);
+}
+
+TEST(mockf, net_link) {
+    blet::mockf::Net net;
+    struct sockaddr_in addr = address("127.0.0.1", 9000);
+    // 1 MB/s, 20ms of latency
+    net.setLink(reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr), blet::mockf::NetLink(1000000, 20000000));
+    int server = listenOn("127.0.0.1", 9000);
+    int client = connectTo("127.0.0.1", 9000);
+    int accepted = accept(server, NULL, NULL);
+
+    char buffer[10000] = {0};
+    uint64_t start = blet::mockf::Clock::now();
+    EXPECT_EQ(send(client, buffer, sizeof(buffer), 0), static_cast<ssize_t>(sizeof(buffer)));
+    EXPECT_EQ(recv(accepted, buffer, sizeof(buffer), MSG_DONTWAIT), -1); // in flight
+    EXPECT_EQ(errno, EAGAIN);
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLET;
+    event.data.u64 = 42;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, accepted, &event), 0);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 1000), 1);
+    EXPECT_EQ(event.data.u64, 42u);
+    EXPECT_GE(blet::mockf::Clock::now() - start, 30000000u); // 10ms of transmission + 20ms of latency
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 0);            // edge triggered
+    EXPECT_EQ(recv(accepted, buffer, sizeof(buffer), 0), static_cast<ssize_t>(sizeof(buffer)));
+
+    // all segments are lost
+    EXPECT_TRUE(net.setLink(client, blet::mockf::NetLink(0, 0, 1.0, 10000000)));
+    start = blet::mockf::Clock::now();
+    EXPECT_EQ(send(client, "lost", 4, 0), 4);
+    EXPECT_EQ(recv(accepted, buffer, sizeof(buffer), 0), 4); // blocking
+    EXPECT_GE(blet::mockf::Clock::now() - start, 10000000u);
+    EXPECT_EQ(net.nbLost(), 1u);
+    EXPECT_EQ(net.bytes(), sizeof(buffer) + 4);
+
+    close(epfd);
+    close(accepted);
+    close(client);
+    close(server);
+    EXPECT_EQ(net.nbLost(), 1u);
+}
+
+static void* echoOnce(void* arg) {
+    int fd = *static_cast<int*>(arg);
+    char buffer[16];
+    ssize_t ret = recv(fd, buffer, sizeof(buffer), 0); // wait the client
+    if (ret > 0) {
+        send(fd, buffer, static_cast<size_t>(ret), 0);
+    }
+    return NULL;
+}
+
+TEST(mockf, net_blocking) {
+    blet::mockf::Net net;
+    int server = listenOn("127.0.0.1", 8080);
+    int client = connectTo("127.0.0.1", 8080);
+    int accepted = accept(server, NULL, NULL);
+    pthread_t thread;
+    pthread_create(&thread, NULL, &echoOnce, &accepted);
+    blet::mockf::Clock::sleep(10000000);
+    EXPECT_EQ(send(client, "ping", 4, 0), 4);
+    char buffer[16] = {0};
+    EXPECT_EQ(recv(client, buffer, sizeof(buffer), 0), 4);
+    EXPECT_STREQ(buffer, "ping");
+    pthread_join(thread, NULL);
+    close(accepted);
+    close(client);
+    close(server);
+}
+
+static void* echoLoop(void* arg) {
+    int fd = *static_cast<int*>(arg);
+    char buffer[16];
+    ssize_t ret;
+    while ((ret = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        send(fd, buffer, static_cast<size_t>(ret), 0);
+    }
+    return NULL;
+}
+
+TEST(mockf, net_threads) {
+    blet::mockf::Net net;
+    const int nbThread = 8;
+    int server = listenOn("127.0.0.1", 8080, nbThread);
+    int clients[nbThread];
+    int accepted[nbThread];
+    pthread_t threads[nbThread];
+    for (int i = 0; i < nbThread; ++i) {
+        clients[i] = connectTo("127.0.0.1", 8080);
+        accepted[i] = accept(server, NULL, NULL);
+        pthread_create(&threads[i], NULL, &echoLoop, &accepted[i]);
+    }
+    // each connection has its lock: the echo threads run in parallel
+    for (int n = 0; n < 1000; ++n) {
+        for (int i = 0; i < nbThread; ++i) {
+            EXPECT_EQ(send(clients[i], &n, sizeof(n), 0), static_cast<ssize_t>(sizeof(n)));
+        }
+        for (int i = 0; i < nbThread; ++i) {
+            int value = -1;
+            EXPECT_EQ(recv(clients[i], &value, sizeof(value), 0), static_cast<ssize_t>(sizeof(value)));
+            EXPECT_EQ(value, n);
+        }
+    }
+    for (int i = 0; i < nbThread; ++i) {
+        EXPECT_EQ(shutdown(clients[i], SHUT_WR), 0); // end of the echo loop
+        pthread_join(threads[i], NULL);
+        close(accepted[i]);
+        close(clients[i]);
+    }
+    close(server);
+}
+
+TEST(mockf, net_epoll_level) {
+    blet::mockf::Net net;
+    int server = listenOn("127.0.0.1", 8080);
+    int clients[2];
+    int accepted[2];
+    int epfd = epoll_create1(0);
+    struct epoll_event event;
+    for (int i = 0; i < 2; ++i) {
+        clients[i] = connectTo("127.0.0.1", 8080);
+        accepted[i] = accept(server, NULL, NULL);
+        event.events = EPOLLIN;
+        event.data.fd = accepted[i];
+        EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, accepted[i], &event), 0);
+        EXPECT_EQ(send(clients[i], "x", 1, 0), 1);
+    }
+    // a ready level triggered socket is reported after the others
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    int first = event.data.fd;
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    EXPECT_NE(event.data.fd, first);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    EXPECT_EQ(event.data.fd, first);
+
+    // the read of all bytes removes the event
+    char c;
+    EXPECT_EQ(recv(first, &c, 1, 0), 1);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    EXPECT_NE(event.data.fd, first);
+    EXPECT_EQ(recv(event.data.fd, &c, 1, 0), 1);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 0);
+
+    // shutdown of the read side
+    EXPECT_EQ(shutdown(first, SHUT_RD), 0);
+    EXPECT_EQ(epoll_wait(epfd, &event, 1, 0), 1);
+    EXPECT_EQ(event.data.fd, first);
+    EXPECT_EQ(recv(first, &c, 1, 0), 0);
+    close(epfd);
+    for (int i = 0; i < 2; ++i) {
+        close(accepted[i]);
+        close(clients[i]);
+    }
+    close(server);
+}
+
+TEST(mockf, net_many_clients) {
+    blet::mockf::Net net;
+    const int nbClient = 1000;
+    int server = listenOn("0.0.0.0", 8080, nbClient);
+    int epfd = epoll_create1(0);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = server;
+    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, server, &event), 0);
+    std::vector<int> clients;
+    for (int i = 0; i < nbClient; ++i) {
+        clients.push_back(connectTo("127.0.0.1", 8080, SOCK_STREAM | SOCK_NONBLOCK));
+        EXPECT_EQ(send(clients.back(), &i, sizeof(i), 0), static_cast<ssize_t>(sizeof(i)));
+    }
+
+    // event loop of an echo server
+    struct epoll_event events[64];
+    int nbEcho = 0;
+    while (nbEcho < nbClient) {
+        int nbEvent = epoll_wait(epfd, events, 64, 1000);
+        ASSERT_GT(nbEvent, 0);
+        for (int i = 0; i < nbEvent; ++i) {
+            if (events[i].data.fd == server) {
+                int fd;
+                while ((fd = accept4(server, NULL, NULL, SOCK_NONBLOCK)) >= 0) {
+                    event.events = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = fd;
+                    EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event), 0);
+                }
+                continue;
+            }
+            int value = 0;
+            ASSERT_EQ(recv(events[i].data.fd, &value, sizeof(value), 0), static_cast<ssize_t>(sizeof(value)));
+            EXPECT_EQ(send(events[i].data.fd, &value, sizeof(value), 0), static_cast<ssize_t>(sizeof(value)));
+            EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_DEL, events[i].data.fd, NULL), 0);
+            EXPECT_EQ(close(events[i].data.fd), 0);
+            ++nbEcho;
+        }
+    }
+    for (int i = 0; i < nbClient; ++i) {
+        int value = -1;
+        EXPECT_EQ(recv(clients[i], &value, sizeof(value), 0), static_cast<ssize_t>(sizeof(value)));
+        EXPECT_EQ(value, i);
+        EXPECT_EQ(recv(clients[i], &value, sizeof(value), 0), 0);
+        close(clients[i]);
+    }
+    EXPECT_EQ(net.nbConnection(), static_cast<uint64_t>(nbClient));
+    close(epfd);
+    close(server);
+}
+
+TEST(mockf, net_real) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    {
+        blet::mockf::Net net;
+        int server = listenOn("127.0.0.1", 8080);
+        int client = connectTo("127.0.0.1", 8080);
+
+        // the real file descriptors are polled with the simulated ones
+        EXPECT_EQ(write(fds[1], "x", 1), 1);
+        int epfd = epoll_create1(0);
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fds[0];
+        EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, fds[0], &event), 0);
+        event.data.fd = server;
+        EXPECT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, server, &event), 0);
+        struct epoll_event events[2];
+        EXPECT_EQ(epoll_wait(epfd, events, 2, 0), 2);
+        struct pollfd pfds[2];
+        pfds[0].fd = fds[0];
+        pfds[0].events = POLLIN;
+        pfds[1].fd = client;
+        pfds[1].events = POLLIN;
+        EXPECT_EQ(poll(pfds, 2, 10), 1);
+        EXPECT_EQ(pfds[0].revents, POLLIN);
+        EXPECT_EQ(pfds[1].revents, 0);
+        close(epfd);
+        close(client);
+        close(server);
+
+        // the datagram sockets are real
+        int udp = socket(AF_INET, SOCK_DGRAM, 0);
+        EXPECT_FALSE(blet::mockf::Net::isFd(udp));
+        close(udp);
+    }
+    // without network all sockets are real
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    EXPECT_FALSE(blet::mockf::Net::isFd(fd));
+    close(fd);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(mockf, net_with_mock) {
+    blet::mockf::Net net;
+    MOCKF_INIT(send);
+
+    MOCKF_EXPECT_CALL(send, (_, _, _, _)).WillOnce(Return(-42));
+
+    int server = listenOn("127.0.0.1", 8080);
+    int client = connectTo("127.0.0.1", 8080);
+    EXPECT_EQ(send(client, "x", 1, 0), 1);
+    {
+        MOCKF_GUARD(send);                       // mock has the priority
+        EXPECT_EQ(send(client, "x", 1, 0), -42); // use mock
+    }
+    EXPECT_THROW(blet::mockf::Net other, blet::mockf::Net::NetAlreadyExists);
+    close(client);
+    close(server);
+}
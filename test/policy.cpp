@@ -0,0 +1,83 @@
+#include <errno.h>  // EAGAIN
+#include <fcntl.h>  // open
+#include <unistd.h> // write
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+TEST(mockf, example_policy) {
+    MOCKF_INIT(write);
+
+    static char buffer[4096] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+
+    blet::mockf::Policy policy(42);
+    policy.failure(0.25, EAGAIN).shortIo(16);
+    MOCKF_SET_POLICY(write, &policy);
+
+    // evaluated before the real function
+    int nbFailure = 0;
+    for (int i = 0; i < 1000; ++i) {
+        errno = 0;
+        ssize_t ret = write(fd, buffer, sizeof(buffer));
+        if (ret == -1) {
+            EXPECT_EQ(errno, EAGAIN);
+            ++nbFailure;
+        }
+        else {
+            EXPECT_EQ(ret, 16); // short write
+        }
+    }
+    EXPECT_GT(nbFailure, 200);
+    EXPECT_LT(nbFailure, 300);
+    EXPECT_EQ(policy.count(), 1000u);
+
+    // same seed, same decisions
+    blet::mockf::Policy replay(42);
+    replay.failure(0.25, EAGAIN);
+    MOCKF_SET_POLICY(write, &replay);
+    int nbReplayFailure = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (write(fd, buffer, sizeof(buffer)) == -1) {
+            ++nbReplayFailure;
+        }
+    }
+    EXPECT_EQ(nbReplayFailure, nbFailure);
+
+    // evaluated before the mock
+    blet::mockf::Policy shortWrite;
+    shortWrite.shortIo(8);
+    MOCKF_SET_POLICY(write, &shortWrite);
+    MOCKF_EXPECT_CALL(write, (fd, buffer, 8)).WillOnce(Return(8));
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), 8);
+    }
+
+    MOCKF_RESET_POLICY(write);
+    EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+    close(fd);
+}
+
+TEST(mockf, example_policy_delay) {
+    MOCKF_INIT(write);
+
+    static char buffer[64] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+
+    blet::mockf::Policy policy;
+    policy.delay(0, 1).delay(2000000, 1); // 2ms one time out of two
+    MOCKF_SET_POLICY(write, &policy);
+    uint64_t start = blet::mockf::Clock::now();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+    }
+    uint64_t elapsed = blet::mockf::Clock::now() - start;
+    MOCKF_RESET_POLICY(write);
+    EXPECT_GE(elapsed, 2000000u);
+    close(fd);
+}
@@ -0,0 +1,116 @@
+#include <errno.h>    // EIO
+#include <fcntl.h>    // open
+#include <stdio.h>    // snprintf
+#include <stdlib.h>   // system
+#include <unistd.h>   // write, getpid, fork
+#include <sys/wait.h> // WEXITSTATUS, waitpid
+
+#include <string>
+
+#include "blet/mockf.h"
+#include "blet/mockf/preload.h"
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+static std::string shmName() {
+    char name[64];
+    snprintf(name, sizeof(name), "/blet_mockf_preload_test_%d", static_cast<int>(getpid()));
+    return name;
+}
+
+TEST(mockf, preload_control) {
+    std::string name = shmName();
+    static char buffer[64] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+
+    {
+        // mocks of process
+        blet::mockf::Preload attach(name.c_str(), blet::mockf::Preload::ATTACH);
+        // other process
+        blet::mockf::Preload control(name.c_str(), blet::mockf::Preload::CONTROL);
+        blet::mockf::PreloadSlot* slot = control.control().find("write");
+        ASSERT_TRUE(slot != NULL);
+        EXPECT_FALSE(slot->policy.isEnable());
+
+        // disabled policy: count only
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+        EXPECT_EQ(slot->policy.count(), 1u);
+
+        slot->policy.failure(1.0, EIO).enable(true);
+        errno = 0;
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), -1);
+        EXPECT_EQ(errno, EIO);
+
+        slot->policy.clear().shortIo(4);
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), 4);
+        EXPECT_EQ(slot->policy.count(), 3u);
+
+        // same slot from name
+        EXPECT_EQ(control.control().acquire("write"), slot);
+        EXPECT_TRUE(control.control().find("mockf_unknown") == NULL);
+    }
+    // detached at destruction
+    EXPECT_TRUE(MOCKF_CLASS(write)::policy() == NULL);
+    EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+
+    {
+        // the counters stay in shared memory
+        blet::mockf::Preload control(name.c_str(), blet::mockf::Preload::CONTROL);
+        EXPECT_EQ(control.control().find("write")->policy.count(), 3u);
+    }
+    EXPECT_TRUE(blet::mockf::Preload::unlink(name.c_str()));
+    EXPECT_FALSE(blet::mockf::Preload::unlink(name.c_str()));
+    close(fd);
+}
+
+TEST(mockf, preload_stale_slot) {
+    std::string name = shmName();
+    {
+        blet::mockf::Preload control(name.c_str(), blet::mockf::Preload::CONTROL);
+        // process dead in the initialization of a slot
+        pid_t pid = fork();
+        if (pid == 0) {
+            _exit(0);
+        }
+        ASSERT_GT(pid, 0);
+        waitpid(pid, NULL, 0);
+        blet::mockf::PreloadSlot& slot = control.control().slots[0];
+        slot.state = blet::mockf::PreloadSlot::INITIALIZING | (static_cast<uint32_t>(pid) << 2);
+
+        EXPECT_TRUE(control.control().find("write") == NULL);
+        EXPECT_EQ(control.control().acquire("write"), &slot);
+        EXPECT_EQ(control.control().find("write"), &slot);
+    }
+    {
+        // not a control block
+        blet::mockf::Preload control(name.c_str(), blet::mockf::Preload::CONTROL);
+        control.control().magic[0] = 'X';
+    }
+    EXPECT_THROW(blet::mockf::Preload(name.c_str(), blet::mockf::Preload::CONTROL), blet::mockf::PreloadError);
+    EXPECT_TRUE(blet::mockf::Preload::unlink(name.c_str()));
+}
+
+#ifdef MOCKF_PRELOAD_LIBRARY
+
+TEST(mockf, preload_library) {
+    std::string name = shmName();
+    std::string env = "MOCKF_PRELOAD_SHM=" + name + " LD_PRELOAD=" MOCKF_PRELOAD_LIBRARY " ";
+    std::string ctl = MOCKF_PRELOAD_CTL " -s " + name + " ";
+
+    // write of dd fails with EIO
+    ASSERT_EQ(system((ctl + "failure write 1.0 5").c_str()), 0);
+    ASSERT_EQ(system((ctl + "enable write").c_str()), 0);
+    EXPECT_NE(WEXITSTATUS(system((env + "dd if=/dev/zero of=/dev/null count=1 2> /dev/null").c_str())), 0);
+
+    // write of dd succeeds without policy
+    ASSERT_EQ(system((ctl + "disable write").c_str()), 0);
+    EXPECT_EQ(WEXITSTATUS(system((env + "dd if=/dev/zero of=/dev/null count=1 2> /dev/null").c_str())), 0);
+
+    {
+        blet::mockf::Preload control(name.c_str(), blet::mockf::Preload::CONTROL);
+        EXPECT_GE(control.control().find("write")->policy.count(), 2u);
+    }
+    EXPECT_EQ(system((ctl + "unlink").c_str()), 0);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include <gtest/gtest-spi.h>
+#include <unistd.h> // read, write
+
+#include <vector>
+
+#include "blet/mockf/script.h"
+
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+TEST(mockf, example_script) {
+    MOCKF_INIT(read);
+
+    std::vector<blet::mockf::ScriptStep> steps;
+    for (int i = 0; i < 10000; ++i) {
+        steps.push_back(blet::mockf::ScriptStep().arg(0, 42).arg(2, 4).output(1, &i, sizeof(i)).returns(sizeof(i)));
+    }
+    steps.push_back(blet::mockf::ScriptStep().arg(0, 42).returns(-1, EAGAIN));
+    MOCKF_EXPECT_SCRIPT(read, steps);
+
+    MOCKF_GUARD(read);
+    for (int i = 0; i < 10000; ++i) {
+        int value = -1;
+        EXPECT_EQ(read(42, &value, sizeof(value)), static_cast<ssize_t>(sizeof(value)));
+        EXPECT_EQ(value, i);
+    }
+    char buffer[4];
+    errno = 0;
+    EXPECT_EQ(read(42, buffer, sizeof(buffer)), -1);
+    EXPECT_EQ(errno, EAGAIN);
+}
+
+TEST(mockf, example_script_mismatch) {
+    MOCKF_INIT(write);
+
+    std::vector<blet::mockf::ScriptStep> steps;
+    steps.push_back(blet::mockf::ScriptStep().arg(0, 1).data(1, "hello", 5).returns(5));
+    MOCKF_EXPECT_SCRIPT(write, steps);
+
+    MOCKF_GUARD(write);
+    EXPECT_NONFATAL_FAILURE(EXPECT_EQ(write(2, "hallo", 5), 5),
+                            "step 1/1 mismatch\n"
+                            "  argument 0: expected 1, actual 2\n"
+                            "  argument 1: differ at byte 1\n"
+                            "    expected \"hello\"\n"
+                            "    actual   \"hallo\"\n");
+}
+
+TEST(mockf, script_bounded_output) {
+    MOCKF_INIT(read);
+
+    std::vector<blet::mockf::ScriptStep> steps;
+    steps.push_back(blet::mockf::ScriptStep().arg(0, 42).output(1, "abcdefgh", 8).returns(8));
+    steps.push_back(blet::mockf::ScriptStep().arg(0, 42).output(1, "abcdefgh", 8).returns(8));
+    MOCKF_EXPECT_SCRIPT(read, steps);
+
+    MOCKF_GUARD(read);
+    // bounded by the length of read
+    char buffer[8] = "-------";
+    EXPECT_EQ(read(42, buffer, 4), 8);
+    EXPECT_STREQ(buffer, "abcd---");
+    // not copied after a mismatch
+    char other[8] = "-------";
+    EXPECT_NONFATAL_FAILURE(EXPECT_EQ(read(7, other, sizeof(other)), 8), "argument 0: expected 42, actual 7");
+    EXPECT_STREQ(other, "-------");
+}
+
+TEST(mockf, script_bounded_compare) {
+    MOCKF_INIT(write);
+
+    std::vector<blet::mockf::ScriptStep> steps;
+    steps.push_back(blet::mockf::ScriptStep().data(1, "hello", 5).returns(2));
+    MOCKF_EXPECT_SCRIPT(write, steps);
+
+    MOCKF_GUARD(write);
+    // only the length of write is compared
+    char buffer[2] = {'h', 'e'};
+    EXPECT_NONFATAL_FAILURE(EXPECT_EQ(write(1, buffer, sizeof(buffer)), 2),
+                            "  argument 1: differ at byte 2\n"
+                            "    expected \"hello\"\n"
+                            "    actual   \"he\"\n");
+}
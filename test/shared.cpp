@@ -0,0 +1,98 @@
+#define MOCKF_ENABLE_SHARED
+
+#include <fcntl.h>    // open, fcntl
+#include <stdlib.h>   // srandom
+#include <sys/wait.h> // waitpid
+#include <unistd.h>   // fork, write, _exit
+
+#include <set>
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+MOCKF_ATTRIBUTE_FUNCTION1(void, srandom, (unsigned int /* seed */), throw());
+MOCKF_VARIADIC_FUNCTION3(int, fcntl, (int /* fd */, int /* cmd */, ...));
+
+TEST(mockf, shared_fork) {
+    const int nbWorker = 4;
+    const int nbCall = 100;
+    static char buffer[4096] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+
+    EXPECT_THROW(MOCKF_SHARED_STATS(write), blet::mockf::SharedNotFound);
+
+    MOCKF_INIT(write);
+    blet::mockf::Shared shared; // before fork
+    std::set<int> pids;
+    for (int i = 0; i < nbWorker; ++i) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            // worker: batch of (i + 1) * 512 bytes
+            for (int j = 0; j < nbCall; ++j) {
+                write(fd, buffer, (i + 1) * 512);
+            }
+            _exit(0);
+        }
+        pids.insert(pid);
+    }
+    for (int i = 0; i < nbWorker; ++i) {
+        int status = 0;
+        EXPECT_NE(waitpid(-1, &status, 0), -1);
+    }
+
+    MOCKF_EXPECT_CALL(write, (fd, _, 42)).WillOnce(Return(-1));
+    {
+        MOCKF_GUARD(write);
+        write(fd, buffer, 42);
+    }
+
+    blet::mockf::SharedStats stats = MOCKF_SHARED_STATS(write);
+    EXPECT_EQ(stats.passthrough, static_cast<uint64_t>(nbWorker * nbCall));
+    EXPECT_EQ(stats.mocked, 1u);
+    EXPECT_EQ(stats.bytes, static_cast<uint64_t>((512 + 1024 + 1536 + 2048) * nbCall + 42));
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(512)], static_cast<uint64_t>(nbCall));
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(2048)], static_cast<uint64_t>(nbCall));
+
+    std::vector<blet::mockf::SharedRecord> records = MOCKF_SHARED_RECORDS(write);
+    ASSERT_EQ(records.size(), static_cast<size_t>(nbWorker * nbCall + 1));
+    for (size_t i = 0; i + 1 < records.size(); ++i) {
+        EXPECT_TRUE(pids.find(records[i].pid) != pids.end());
+        EXPECT_EQ(records[i].result, records[i].size);
+        EXPECT_FALSE(records[i].isMocked);
+    }
+    EXPECT_EQ(records.back().pid, getpid());
+    EXPECT_EQ(records.back().result, -1);
+    EXPECT_TRUE(records.back().isMocked);
+    close(fd);
+}
+
+TEST(mockf, shared_result) {
+    blet::mockf::Shared shared;
+
+    // void result
+    srandom(42);
+    EXPECT_EQ(MOCKF_SHARED_STATS(srandom).calls(), 1u);
+    EXPECT_EQ(MOCKF_SHARED_RECORDS(srandom)[0].result, 0);
+
+    // variadic
+    int fd = open("/dev/null", O_WRONLY);
+    int flags = fcntl(fd, F_GETFL);
+    ASSERT_EQ(MOCKF_SHARED_RECORDS(fcntl).size(), 1u);
+    EXPECT_EQ(MOCKF_SHARED_RECORDS(fcntl)[0].result, flags);
+    EXPECT_EQ(MOCKF_SHARED_RECORDS(fcntl)[0].size, -1);
+    close(fd);
+
+    // errno of policy
+    blet::mockf::Policy policy;
+    policy.failure(1.0, EBADF);
+    MOCKF_SET_POLICY(fcntl, &policy);
+    EXPECT_EQ(fcntl(-1, F_GETFL), -1);
+    MOCKF_RESET_POLICY(fcntl);
+    ASSERT_EQ(MOCKF_SHARED_RECORDS(fcntl).size(), 2u);
+    EXPECT_EQ(MOCKF_SHARED_RECORDS(fcntl)[1].error, EBADF);
+    EXPECT_TRUE(MOCKF_SHARED_RECORDS(write).empty());
+}
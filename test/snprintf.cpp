@@ -0,0 +1,42 @@
+#include <fcntl.h>  // open
+#include <stdio.h>  // snprintf, dprintf
+#include <unistd.h> // close
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_VARIADIC_ATTRIBUTE_FUNCTION4(int, snprintf, (char* /* s */, size_t /* maxlen */, const char* /* format */, ...),
+                                   throw());
+MOCKF_VARIADIC_FUNCTION3(int, dprintf, (int /* fd */, const char* /* format */, ...));
+
+TEST(mockf, example_snprintf) {
+    MOCKF_INIT(snprintf);
+
+    MOCKF_EXPECT_CALL(snprintf, (_, _, _, _)).WillOnce(Return(-42));
+
+    char buffer[32];
+    {
+        MOCKF_GUARD(snprintf);                                      // enable call to mock
+        EXPECT_EQ(snprintf(buffer, sizeof(buffer), "%d", 42), -42); // use mock
+    }                                                               // disable call to mock
+
+    // real is called with vsnprintf
+    EXPECT_EQ(snprintf(buffer, sizeof(buffer), "%s:%d", "mockf", 42), 8);
+    EXPECT_STREQ(buffer, "mockf:42");
+}
+
+static int dprintfHandler(int /* fd */, const char* /* format */, ...) {
+    return -1;
+}
+
+TEST(mockf, dprintf_handler) {
+    int fd = open("/dev/null", O_WRONLY);
+    // the v-variant is used only while the handler is the real function
+    MOCKF_SET_HANDLER(dprintf, &dprintfHandler);
+    EXPECT_THROW(dprintf(fd, "%d", 42), blet::mockf::RealVariadicFunctionUsed);
+    MOCKF_RESET_HANDLER(dprintf);
+    EXPECT_EQ(dprintf(fd, "%d", 42), 2);
+    close(fd);
+}
@@ -0,0 +1,113 @@
+#define MOCKF_ENABLE_STATS // count the calls of mocks
+
+#include <errno.h>   // EAGAIN
+#include <fcntl.h>   // open
+#include <pthread.h> // pthread_create
+#include <unistd.h>  // write
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+TEST(mockf, example_stats) {
+    MOCKF_INIT(write);
+    MOCKF_RESET_STATS(write);
+
+    static char buffer[64 * 1024] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(write(fd, buffer, 64), 64); // use real
+    }
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer))); // use real
+    }
+    close(fd);
+
+    MOCKF_EXPECT_CALL(write, (_, _, _)).WillOnce(Return(-42));
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(-1, buffer, 0), -42); // use mock
+    }
+
+    blet::mockf::Stats stats = MOCKF_STATS(write);
+    EXPECT_EQ(stats.calls(), 103u);
+    EXPECT_EQ(stats.mocked, 1u);
+    EXPECT_EQ(stats.passthrough, 102u);
+    EXPECT_GT(stats.realNs, 0u);
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(0)], 1u);
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(64)], 100u);
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(64 * 1024)], 2u);
+
+    char json[512] = {0};
+    FILE* file = fmemopen(json, sizeof(json) - 1, "w");
+    blet::mockf::Symbols::dumpStats(file);
+    fclose(file);
+    EXPECT_THAT(json, HasSubstr("\"write\": {\"mocked\": 1, \"passthrough\": 102"));
+    EXPECT_THAT(json, HasSubstr("\"sizes\": {\"0\": 1, \"64\": 100, \"65536\": 2}"));
+
+    MOCKF_RESET_STATS(write);
+    EXPECT_EQ(MOCKF_STATS(write).calls(), 0u);
+}
+
+static void* writeThread(void* fd) {
+    static const char buffer[8] = {0};
+    EXPECT_EQ(write(*static_cast<int*>(fd), buffer, sizeof(buffer)), 8);
+    return NULL;
+}
+
+TEST(mockf, stats_threads) {
+    MOCKF_RESET_STATS(write);
+    int fd = open("/dev/null", O_WRONLY);
+    EXPECT_EQ(write(fd, "", 0), 0);
+    for (int i = 0; i < 16; ++i) {
+        pthread_t thread;
+        ASSERT_EQ(pthread_create(&thread, NULL, &writeThread, &fd), 0);
+        pthread_join(thread, NULL);
+    }
+    close(fd);
+    EXPECT_EQ(MOCKF_STATS(write).passthrough, 17u);
+    // the counters of exited threads are reused
+    unsigned int nbCounters = 0;
+    for (blet::mockf::StatsCounters* counters = MOCKF_CLASS(write)::statsHead(); counters != NULL;
+         counters = counters->next) {
+        ++nbCounters;
+    }
+    EXPECT_EQ(nbCounters, 2u);
+}
+
+TEST(mockf, stats_policy) {
+    MOCKF_INIT(write);
+    MOCKF_RESET_STATS(write);
+
+    static char buffer[64] = {0};
+    int fd = open("/dev/null", O_WRONLY);
+
+    blet::mockf::Policy policy;
+    policy.failure(1.0, EAGAIN).delay(2000000); // 2ms
+    MOCKF_SET_POLICY(write, &policy);
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(write(fd, buffer, sizeof(buffer)), -1);
+    }
+    // the failed calls are not counted as passthrough nor in the histogram of sizes
+    blet::mockf::Stats stats = MOCKF_STATS(write);
+    EXPECT_EQ(stats.calls(), 2u);
+    EXPECT_EQ(stats.injected, 2u);
+    EXPECT_EQ(stats.passthrough, 0u);
+    EXPECT_EQ(stats.realNs, 0u);
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(sizeof(buffer))], 0u);
+
+    // the delay of policy is not timed as real function
+    policy.clear().delay(2000000); // 2ms
+    EXPECT_EQ(write(fd, buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+    MOCKF_RESET_POLICY(write);
+    close(fd);
+    stats = MOCKF_STATS(write);
+    EXPECT_EQ(stats.injected, 2u);
+    EXPECT_EQ(stats.passthrough, 1u);
+    EXPECT_LT(stats.realNs, 2000000u);
+    EXPECT_EQ(stats.sizes[blet::mockf::Stats::sizeIndex(sizeof(buffer))], 1u);
+}
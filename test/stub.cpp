@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <stdio.h>  // snprintf
+#include <unistd.h> // write
+
+#include "blet/mockf/stub.h"
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+MOCKF_VARIADIC_FUNCTION4(int, snprintf, (char* /* str */, size_t /* size */, const char* /* format */, ...));
+
+static ssize_t writeStub(int /* fd */, const void* /* buf */, size_t nbytes) {
+    return static_cast<ssize_t>(nbytes);
+}
+
+static int snprintfStub(char* str, size_t size, const char* format, va_list args) {
+    return vsnprintf(str, size, format, args) + 1000;
+}
+
+TEST(mockf, example_stub) {
+    MOCKF_INIT(write);
+    MOCKF_STUB(write, &writeStub);
+
+    char buffer[42] = {0};
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(-1, buffer, sizeof(buffer)), 42); // use stub
+    }
+    EXPECT_EQ(write(-1, buffer, sizeof(buffer)), -1); // use real
+}
+
+TEST(mockf, example_stub_variadic) {
+    MOCKF_INIT(snprintf);
+    MOCKF_STUB(snprintf, &snprintfStub);
+
+    char buffer[32];
+    {
+        MOCKF_GUARD(snprintf);
+        EXPECT_EQ(snprintf(buffer, sizeof(buffer), "%d", 42), 1002); // use stub
+        EXPECT_STREQ(buffer, "42");
+    }
+    EXPECT_EQ(snprintf(buffer, sizeof(buffer), "%d", 42), 2); // use real
+}
+
+TEST(mockf, example_stub_lambda) {
+    MOCKF_INIT(write);
+    ssize_t nbBytes = 0;
+    MOCKF_STUB(write, [&nbBytes](int /* fd */, const void* /* buf */, size_t nbytes) {
+        nbBytes += static_cast<ssize_t>(nbytes);
+        return static_cast<ssize_t>(nbytes);
+    });
+
+    char buffer[42] = {0};
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(-1, buffer, sizeof(buffer)), 42); // use lambda
+        EXPECT_EQ(write(-1, buffer, 2), 2);
+    }
+    EXPECT_EQ(nbBytes, 44);
+
+    MOCKF_STUB(write, &writeStub); // replace the lambda
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(write(-1, buffer, 8), 8);
+    }
+    EXPECT_EQ(nbBytes, 44);
+}
+
+TEST(mockf, example_stub_not_found) {
+    MOCKF_INIT(write);
+    MOCKF_GUARD(write);
+    char buffer[42] = {0};
+    EXPECT_THROW(write(-1, buffer, sizeof(buffer)), blet::mockf::StubNotFound);
+}
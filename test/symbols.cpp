@@ -0,0 +1,27 @@
+#include <unistd.h> // getpid
+
+#include "blet/mockf.h"
+
+using ::testing::Return;
+
+MOCKF_FUNCTION0(pid_t, getpid, ());
+
+// function without real symbol
+extern "C" int mockf_not_found();
+MOCKF_FUNCTION0(int, mockf_not_found, ());
+
+TEST(mockf, symbols_resolved_at_load) {
+    EXPECT_TRUE(MOCKF_CLASS(getpid)::isResolved());
+    EXPECT_FALSE(MOCKF_CLASS(mockf_not_found)::isResolved());
+    EXPECT_EQ(::blet::mockf::Symbols::resolve(), 1u);
+    EXPECT_EQ(MOCKF_CLASS(getpid)::real()(), getpid());
+}
+
+TEST(mockf, symbols_not_found) {
+    EXPECT_THROW(mockf_not_found(), ::blet::mockf::RealFunctionNotFound);
+
+    MOCKF_INIT(mockf_not_found);
+    MOCKF_GUARD(mockf_not_found);
+    MOCKF_EXPECT_CALL(mockf_not_found, ()).WillOnce(Return(42));
+    EXPECT_EQ(mockf_not_found(), 42);
+}
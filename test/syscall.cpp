@@ -0,0 +1,101 @@
+#include <errno.h>       // EBADF
+#include <sys/syscall.h> // SYS_write, SYS_getrandom
+#include <unistd.h>      // syscall, pipe
+
+#include "blet/mockf/syscall.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::SetErrnoAndReturn;
+
+// only in one source file of the binary
+MOCKF_SYSCALL_FUNCTION();
+
+// syscall(SYS_write, ...) uses the mock of write
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* n */));
+MOCKF_SYSCALL_ROUTE(SYS_write, write);
+
+// mocks of syscall without libc function in the binary
+MOCKF_SYSCALL_FUNCTION3(SYS_getrandom, ssize_t, sys_getrandom,
+                        (void* /* buf */, size_t /* buflen */, unsigned int /* flags */));
+#ifdef SYS_io_uring_enter
+MOCKF_SYSCALL_FUNCTION6(SYS_io_uring_enter, int, sys_io_uring_enter,
+                        (unsigned int /* fd */, unsigned int /* to_submit */, unsigned int /* min_complete */,
+                         unsigned int /* flags */, const void* /* arg */, size_t /* argsz */));
+#endif
+
+ACTION_P(FillBuffer, value) {
+    memset(arg0, value, arg1);
+    return static_cast<ssize_t>(arg1);
+}
+
+TEST(mockf, example_syscall) {
+    MOCKF_INIT(sys_getrandom);
+
+    MOCKF_EXPECT_CALL(sys_getrandom, (_, 16, 0)).WillOnce(FillBuffer(0x42));
+
+    unsigned char buffer[16] = {0};
+    {
+        MOCKF_GUARD(sys_getrandom);
+        EXPECT_EQ(syscall(SYS_getrandom, buffer, sizeof(buffer), 0), 16);
+        EXPECT_EQ(buffer[15], 0x42);
+    }
+    // disabled: real syscall
+    long ret = syscall(SYS_getrandom, buffer, sizeof(buffer), 0);
+    EXPECT_TRUE(ret == 16 || (ret == -1 && errno == ENOSYS));
+}
+
+TEST(mockf, syscall_route) {
+    MOCKF_INIT(write);
+
+    MOCKF_EXPECT_CALL(write, (42, _, 5)).WillOnce(Return(5));
+
+    {
+        MOCKF_GUARD(write);
+        EXPECT_EQ(syscall(SYS_write, 42, "mockf", 5), 5);
+    }
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(syscall(SYS_write, fds[1], "real", 4), 4); // real write
+    char buffer[8] = {0};
+    EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 4);
+    EXPECT_STREQ(buffer, "real");
+    close(fds[0]);
+    close(fds[1]);
+
+    // the numbers without route use the real syscall
+    EXPECT_EQ(syscall(SYS_getpid), static_cast<long>(getpid()));
+    EXPECT_EQ(blet::mockf::Syscall::route(SYS_getpid), static_cast<blet::mockf::Syscall::route_t>(NULL));
+    EXPECT_NE(blet::mockf::Syscall::route(SYS_write), static_cast<blet::mockf::Syscall::route_t>(NULL));
+    EXPECT_FALSE(blet::mockf::Syscall::setRoute(MOCKF_SYSCALL_MAX, NULL));
+}
+
+TEST(mockf, syscall_policy) {
+    blet::mockf::Policy policy;
+    policy.failure(1.0, EAGAIN);
+    MOCKF_SET_POLICY(sys_getrandom, &policy);
+
+    unsigned char buffer[16];
+    errno = 0;
+    EXPECT_EQ(syscall(SYS_getrandom, buffer, sizeof(buffer), 0), -1);
+    EXPECT_EQ(errno, EAGAIN);
+    EXPECT_EQ(policy.count(), 1u);
+    MOCKF_SET_POLICY(sys_getrandom, NULL);
+}
+
+#ifdef SYS_io_uring_enter
+TEST(mockf, syscall_io_uring) {
+    MOCKF_INIT(sys_io_uring_enter);
+
+    MOCKF_EXPECT_CALL(sys_io_uring_enter, (3, 1, 1, _, NULL, 0)).WillOnce(SetErrnoAndReturn(EBUSY, -1));
+
+    {
+        MOCKF_GUARD(sys_io_uring_enter);
+        EXPECT_EQ(syscall(SYS_io_uring_enter, 3, 1, 1, 0, NULL, 0), -1);
+        EXPECT_EQ(errno, EBUSY);
+    }
+    // real syscall with a bad file descriptor
+    EXPECT_EQ(syscall(SYS_io_uring_enter, -1, 1, 1, 0, NULL, 0), -1);
+    EXPECT_TRUE(errno == EBADF || errno == ENOSYS || errno == EPERM);
+}
+#endif
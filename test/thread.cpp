@@ -0,0 +1,85 @@
+#include <unistd.h> // write
+
+#include <thread>
+#include <vector>
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+
+ACTION(write) {
+    // use real in mock, only for the current thread
+    return write(STDOUT_FILENO, "", 0) - 42;
+}
+
+TEST(mockf, thread_write) {
+    const int nbThread = 16;
+    const int nbCall = 1000;
+
+    MOCKF_INIT(write);
+    MOCKF_EXPECT_CALL(write, (-1, _, _)).Times(nbThread * nbCall).WillRepeatedly(write());
+
+    std::vector<int> results(nbThread, 0);
+    {
+        MOCKF_GUARD(write); // enable call to mock for all threads
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < nbThread; ++i) {
+            threads.push_back(std::thread([&results, i]() {
+                for (int j = 0; j < nbCall; ++j) {
+                    if (write(-1, "mock", sizeof("mock") - 1) == -42) {
+                        ++results[i];
+                    }
+                }
+            }));
+        }
+        for (std::size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+    }
+
+    for (int i = 0; i < nbThread; ++i) {
+        EXPECT_EQ(results[i], nbCall);
+    }
+}
+
+TEST(mockf, thread_local_write) {
+    const int nbThread = 8;
+    const int nbCall = 1000;
+
+    // fallback of threads without instance
+    MOCKF_INIT(write);
+    MOCKF_EXPECT_CALL(write, (-1, _, _)).Times(nbCall).WillRepeatedly(Return(-1));
+    MOCKF_GUARD(write);
+
+    std::vector<int> results(nbThread, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nbThread; ++i) {
+        threads.push_back(std::thread([&results, i]() {
+            // same test in each thread with its own expectations
+            MOCKF_INIT_THREAD(write);
+            EXPECT_TRUE(MOCKF_CLASS(write)::instance() == &mockf_write);
+            MOCKF_EXPECT_CALL(write, (-1, _, _)).Times(nbCall).WillRepeatedly(Return(i));
+            MOCKF_GUARD(write);
+            for (int j = 0; j < nbCall; ++j) {
+                if (write(-1, "mock", sizeof("mock") - 1) == i) {
+                    ++results[i];
+                }
+            }
+        }));
+    }
+    for (int j = 0; j < nbCall; ++j) {
+        EXPECT_EQ(write(-1, "mock", sizeof("mock") - 1), -1);
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+
+    for (int i = 0; i < nbThread; ++i) {
+        EXPECT_EQ(results[i], nbCall);
+    }
+    EXPECT_TRUE(MOCKF_CLASS(write)::instance() == &mockf_write);
+}
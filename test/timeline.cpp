@@ -0,0 +1,154 @@
+#define MOCKF_ENABLE_TIMELINE
+#define MOCKF_ENABLE_SHARED // the result is kept by the timeline and the shared accounting
+#define MOCKF_TIMELINE_EVENTS 64
+
+#include <fcntl.h>  // fcntl
+#include <stdio.h>  // tmpfile
+#include <stdlib.h> // srandom
+#include <unistd.h> // read
+
+#include <pthread.h>
+
+#include <set>
+#include <string>
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+MOCKF_ATTRIBUTE_FUNCTION1(void, srandom, (unsigned int /* seed */), throw());
+MOCKF_VARIADIC_FUNCTION3(int, fcntl, (int /* fd */, int /* cmd */, ...));
+
+static void* readThread(void* /* arg */) {
+    char buffer[8];
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(read(-1, buffer, sizeof(buffer)), -1);
+    }
+    return NULL;
+}
+
+TEST(mockf, timeline_events) {
+    MOCKF_INIT(read);
+    MOCKF_EXPECT_CALL(read, (42, _, 4)).WillOnce(Return(4));
+
+    char buffer[8];
+    read(-1, buffer, sizeof(buffer)); // not recorded without timeline
+
+    blet::mockf::Timeline timeline;
+    EXPECT_THROW(blet::mockf::Timeline(), blet::mockf::TimelineError);
+    {
+        MOCKF_GUARD(read);
+        EXPECT_EQ(read(42, buffer, 4), 4);
+    }
+    EXPECT_EQ(read(-1, buffer, sizeof(buffer)), -1); // real function
+    srandom(42);
+    EXPECT_EQ(fcntl(-1, F_GETFD), -1);
+
+    std::vector<blet::mockf::TimelineEvent> events = timeline.events();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_STREQ(events[0].name, "read");
+    EXPECT_TRUE(events[0].isMocked);
+    EXPECT_EQ(events[0].args[0], 42);
+    EXPECT_EQ(events[0].args[1], static_cast<int64_t>(reinterpret_cast<intptr_t>(buffer)));
+    EXPECT_EQ(events[0].result, 4);
+    EXPECT_FALSE(events[1].isMocked);
+    EXPECT_EQ(events[1].args[0], -1);
+    EXPECT_EQ(events[1].result, -1);
+    EXPECT_STREQ(events[2].name, "srandom");
+    EXPECT_EQ(events[2].args[0], 42);
+    EXPECT_STREQ(events[3].name, "fcntl");
+    EXPECT_EQ(events[3].args[1], F_GETFD);
+    EXPECT_EQ(events[0].tid, events[3].tid);
+    EXPECT_LE(events[0].start, events[1].start);
+}
+
+TEST(mockf, timeline_sampling) {
+    blet::mockf::Timeline timeline(4); // one call in 4 calls by thread
+
+    char buffer[8];
+    for (int i = 0; i < 8; ++i) {
+        read(-1, buffer, sizeof(buffer));
+    }
+    EXPECT_EQ(timeline.nbEvent(), 2u);
+}
+
+TEST(mockf, timeline_ring) {
+    blet::mockf::Timeline timeline;
+
+    pthread_t threads[2];
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(pthread_create(&threads[i], NULL, &readThread, NULL), 0);
+    }
+    for (int i = 0; i < 2; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    std::vector<blet::mockf::TimelineEvent> events = timeline.events();
+    ASSERT_EQ(events.size(), 20u);
+    std::set<uint32_t> tids;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        tids.insert(events[i].tid);
+    }
+    EXPECT_EQ(tids.size(), 2u);
+
+    // the oldest events are overwritten
+    char buffer[8];
+    for (int i = 0; i < 100; ++i) {
+        read(-1, buffer, sizeof(buffer));
+    }
+    EXPECT_EQ(timeline.nbEvent(), 20u + 64u);
+    EXPECT_EQ(timeline.nbDropped(), 36u);
+}
+
+TEST(mockf, timeline_chrome) {
+    blet::mockf::Timeline timeline;
+
+    char buffer[8];
+    read(-1, buffer, sizeof(buffer));
+
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    timeline.writeChrome(file);
+    rewind(file);
+    std::string json;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        json += static_cast<char>(c);
+    }
+    fclose(file);
+
+    EXPECT_EQ(json.find("{\"displayTimeUnit\": \"ns\", \"traceEvents\": ["), 0u);
+    EXPECT_NE(json.find("\"name\": \"read\", \"cat\": \"mockf\", \"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"arg0\": -1, "), std::string::npos);
+    EXPECT_NE(json.find("\"result\": -1, \"mocked\": false}}"), std::string::npos);
+    EXPECT_THROW(timeline.writeChrome("/nothing/timeline.json"), blet::mockf::TimelineError);
+}
+
+static void* readLoop(void* arg) {
+    char buffer[8];
+    while (!__atomic_load_n(static_cast<bool*>(arg), __ATOMIC_ACQUIRE)) {
+        read(-1, buffer, sizeof(buffer));
+    }
+    return NULL;
+}
+
+TEST(mockf, timeline_export_while_recording) {
+    blet::mockf::Timeline timeline;
+
+    bool isStop = false;
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, NULL, &readLoop, &isStop), 0);
+    // the slots overwritten during the copy are skipped
+    for (int i = 0; i < 100; ++i) {
+        std::vector<blet::mockf::TimelineEvent> events = timeline.events();
+        for (std::size_t j = 0; j < events.size(); ++j) {
+            ASSERT_NE(events[j].sequence, 0u);
+            ASSERT_STREQ(events[j].name, "read");
+            ASSERT_EQ(events[j].args[0], -1);
+            ASSERT_EQ(events[j].result, -1);
+        }
+    }
+    __atomic_store_n(&isStop, true, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+}
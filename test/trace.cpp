@@ -0,0 +1,157 @@
+#include <fcntl.h>    // open
+#include <stdio.h>    // fflush, tmpfile
+#include <stdlib.h>   // mkstemp
+#include <sys/stat.h> // stat
+#include <unistd.h>   // read, close, unlink
+
+#include "blet/mockf/trace.h"
+
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+MOCKF_ATTRIBUTE_FUNCTION2(int, stat, (const char* /* file */, struct stat* /* buf */), throw());
+MOCKF_ATTRIBUTE_FUNCTION1(int, pipe, (int* /* pipedes */), throw());
+MOCKF_FUNCTION1(int, fflush, (FILE* /* stream */));
+MOCKF_TRACE_OUTPUT(pipe, 0, 2 * sizeof(int));
+
+struct mockf : public ::testing::Test {
+    void SetUp() {
+        char dataTemplate[] = "/tmp/mockf_data_XXXXXX";
+        int fd = mkstemp(dataTemplate);
+        ASSERT_NE(fd, -1);
+        ASSERT_EQ(write(fd, "mockf trace", sizeof("mockf trace") - 1), 11);
+        close(fd);
+        dataPath = dataTemplate;
+
+        char traceTemplate[] = "/tmp/mockf_trace_XXXXXX";
+        fd = mkstemp(traceTemplate);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        tracePath = traceTemplate;
+    }
+    void TearDown() {
+        MOCKF_RESET_HANDLER(read);
+        MOCKF_RESET_HANDLER(stat);
+        MOCKF_RESET_HANDLER(pipe);
+        MOCKF_RESET_HANDLER(fflush);
+        unlink(dataPath.c_str());
+        unlink(tracePath.c_str());
+    }
+    std::string dataPath;
+    std::string tracePath;
+};
+
+TEST_F(mockf, example_trace) {
+    char buffer[32] = {0};
+    struct stat statOfFile;
+
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::RECORD);
+        MOCKF_RECORD(read); // record the calls of real read
+        MOCKF_RECORD(stat); // record the calls of real stat
+
+        int fd = open(dataPath.c_str(), O_RDONLY);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 11);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 0);
+        EXPECT_EQ(stat(dataPath.c_str(), &statOfFile), 0);
+        EXPECT_EQ(read(-1, buffer, sizeof(buffer)), -1);
+        EXPECT_EQ(errno, EBADF);
+        close(fd);
+    }
+
+    // the data file is not used by the replay
+    unlink(dataPath.c_str());
+    memset(buffer, 0, sizeof(buffer));
+    memset(&statOfFile, 0, sizeof(statOfFile));
+
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::REPLAY);
+        MOCKF_REPLAY(read); // replay the calls of read
+        MOCKF_REPLAY(stat); // replay the calls of stat
+
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), 11);
+        EXPECT_STREQ(buffer, "mockf trace");
+        EXPECT_EQ(stat(dataPath.c_str(), &statOfFile), 0); // order by function
+        EXPECT_EQ(statOfFile.st_size, 11);
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), 0);
+        errno = 0;
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), -1);
+        EXPECT_EQ(errno, EBADF);
+        EXPECT_THROW(read(42, buffer, sizeof(buffer)), ::blet::mockf::TraceNotFound);
+    }
+}
+
+TEST_F(mockf, trace_mismatch) {
+    char buffer[32] = {0};
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::RECORD);
+        MOCKF_RECORD(read);
+        int fd = open(dataPath.c_str(), O_RDONLY);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 11);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 0);
+        close(fd);
+    }
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::REPLAY);
+        MOCKF_REPLAY(read);
+        // the recorded output is larger than the buffer of call
+        char small[4] = {0};
+        EXPECT_THROW(read(42, small, sizeof(small)), ::blet::mockf::TraceMismatch);
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), 0);
+    }
+}
+
+TEST_F(mockf, trace_outputs) {
+    int fds[2] = {-1, -1};
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::RECORD);
+        MOCKF_RECORD(pipe);
+        MOCKF_RECORD(fflush);
+        EXPECT_EQ(pipe(fds), 0);
+        EXPECT_EQ(fflush(file), 0);
+    }
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::REPLAY);
+        MOCKF_REPLAY(pipe);
+        MOCKF_REPLAY(fflush);
+        // the two file descriptors of pipe (MOCKF_TRACE_OUTPUT)
+        int replayed[2] = {-1, -1};
+        EXPECT_EQ(pipe(replayed), 0);
+        EXPECT_EQ(replayed[0], fds[0]);
+        EXPECT_EQ(replayed[1], fds[1]);
+        // a FILE is not a plain output: not overwritten
+        FILE copy = *file;
+        EXPECT_EQ(fflush(file), 0);
+        EXPECT_EQ(memcmp(&copy, file, sizeof(copy)), 0);
+    }
+    close(fds[0]);
+    close(fds[1]);
+    fclose(file);
+}
+
+TEST_F(mockf, trace_one_at_a_time) {
+    char buffer[32] = {0};
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::RECORD);
+        MOCKF_RECORD(read);
+        int fd = open(dataPath.c_str(), O_RDONLY);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 11);
+        // the file of the current trace is not truncated
+        EXPECT_THROW(::blet::mockf::Trace(tracePath.c_str(), ::blet::mockf::Trace::RECORD),
+                     ::blet::mockf::TraceFileError);
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 0);
+        close(fd);
+    }
+    memset(buffer, 0, sizeof(buffer));
+    {
+        ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::REPLAY);
+        MOCKF_REPLAY(read);
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), 11);
+        EXPECT_STREQ(buffer, "mockf trace");
+        EXPECT_EQ(read(42, buffer, sizeof(buffer)), 0);
+    }
+    // a failed open releases the trace
+    EXPECT_THROW(::blet::mockf::Trace("/not_exists/trace", ::blet::mockf::Trace::REPLAY),
+                 ::blet::mockf::TraceFileError);
+    ::blet::mockf::Trace trace(tracePath.c_str(), ::blet::mockf::Trace::REPLAY);
+}
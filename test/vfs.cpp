@@ -0,0 +1,69 @@
+#include "blet/mockf/vfs.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+// declare the mocks of open, openat, close, read, write, pread, pwrite, lseek, stat, fstat, unlink and rename
+MOCKF_VFS_FUNCTIONS();
+
+TEST(mockf, example_vfs) {
+    blet::mockf::Vfs vfs("/data"); // all paths under '/data' are in memory
+
+    int fd = open("/data/file", O_CREAT | O_RDWR, 0644);
+    ASSERT_TRUE(blet::mockf::Vfs::isFd(fd));
+    EXPECT_EQ(write(fd, "mockf vfs", sizeof("mockf vfs") - 1), 9);
+    EXPECT_EQ(pwrite(fd, "VFS", 3, 6), 3);
+
+    char buffer[32] = {0};
+    EXPECT_EQ(lseek(fd, 0, SEEK_SET), 0);
+    EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 9);
+    EXPECT_STREQ(buffer, "mockf VFS");
+    EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 0);
+
+    // sparse file
+    EXPECT_EQ(pwrite(fd, "end", 3, 1 << 30), 3);
+    struct stat statOfFile;
+    EXPECT_EQ(fstat(fd, &statOfFile), 0);
+    EXPECT_EQ(statOfFile.st_size, (1 << 30) + 3);
+    EXPECT_EQ(pread(fd, buffer, 4, 1 << 20), 4);
+    EXPECT_EQ(buffer[0], '\0');
+    EXPECT_EQ(close(fd), 0);
+
+    EXPECT_EQ(rename("/data/file", "/data/dir/file"), 0);
+    EXPECT_EQ(stat("/data/file", &statOfFile), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(stat("/data/dir", &statOfFile), 0);
+    EXPECT_TRUE(S_ISDIR(statOfFile.st_mode));
+    EXPECT_EQ(stat("/data/dir/file", &statOfFile), 0);
+    EXPECT_TRUE(S_ISREG(statOfFile.st_mode));
+    EXPECT_EQ(rename("/data/dir/file", "/tmp/file"), -1);
+    EXPECT_EQ(errno, EXDEV);
+    EXPECT_EQ(unlink("/data/dir/file"), 0);
+    EXPECT_EQ(open("/data/dir/file", O_RDONLY), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    // the real functions are used outside of '/data'
+    EXPECT_EQ(stat("/", &statOfFile), 0);
+    EXPECT_NE(statOfFile.st_dev, static_cast<dev_t>(0x6d6f636b));
+}
+
+TEST(mockf, vfs_with_mock) {
+    blet::mockf::Vfs vfs("/data");
+    MOCKF_INIT(read);
+
+    MOCKF_EXPECT_CALL(read, (_, _, _)).WillOnce(Return(-42));
+
+    int fd = open("/data/file", O_CREAT | O_WRONLY | O_EXCL, 0644);
+    EXPECT_EQ(open("/data/file", O_CREAT | O_WRONLY | O_EXCL, 0644), -1);
+    EXPECT_EQ(errno, EEXIST);
+    char buffer[8];
+    EXPECT_EQ(read(fd, buffer, sizeof(buffer)), -1); // write only
+    EXPECT_EQ(errno, EBADF);
+    {
+        MOCKF_GUARD(read);                                // mock has the priority
+        EXPECT_EQ(read(fd, buffer, sizeof(buffer)), -42); // use mock
+    }
+    EXPECT_EQ(close(fd), 0);
+    EXPECT_EQ(close(fd), -1);
+    EXPECT_EQ(errno, EBADF);
+}
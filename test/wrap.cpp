@@ -0,0 +1,53 @@
+#include <string.h> // strcmp
+#include <unistd.h> // read, write, pipe
+
+#include "blet/mockf.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+// built with mockf_wrap(read write strcmp) and linked statically
+MOCKF_FUNCTION3(ssize_t, read, (int /* fd */, void* /* buf */, size_t /* nbytes */));
+MOCKF_FUNCTION3(ssize_t, write, (int /* fd */, const void* /* buf */, size_t /* nbytes */));
+MOCKF_ATTRIBUTE_FUNCTION2(int, strcmp, (const char* /* s1 */, const char* /* s2 */), throw());
+
+TEST(mockf, wrap_read) {
+    MOCKF_INIT(read);
+
+    MOCKF_EXPECT_CALL(read, (42, _, 4)).WillOnce(Return(4));
+
+    char buffer[8];
+    {
+        MOCKF_GUARD(read);
+        EXPECT_EQ(read(42, buffer, 4), 4); // __wrap_read
+    }
+
+    // disabled: __real_read
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(write(fds[1], "mockf", 5), 5);
+    EXPECT_EQ(read(fds[0], buffer, sizeof(buffer)), 5);
+    EXPECT_EQ(std::string(buffer, 5), "mockf");
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(mockf, wrap_real) {
+    // resolved at link time without dlsym
+    EXPECT_TRUE(MOCKF_CLASS(read)::isResolved());
+    EXPECT_EQ(MOCKF_CLASS(read)::real(), &blet::mockf::__real_read);
+    EXPECT_EQ(MOCKF_CLASS(strcmp)::real(), &blet::mockf::__real_strcmp);
+}
+
+TEST(mockf, wrap_attribute) {
+    MOCKF_INIT(strcmp);
+
+    MOCKF_EXPECT_CALL(strcmp, (_, _)).WillOnce(Return(-42));
+
+    volatile const char* str = "mockf"; // call of strcmp (no builtin)
+    {
+        MOCKF_GUARD(strcmp);
+        EXPECT_EQ(strcmp(const_cast<const char*>(str), "mockf"), -42);
+    }
+    EXPECT_EQ(strcmp(const_cast<const char*>(str), "mockf"), 0);
+}